@@ -0,0 +1,66 @@
+/**
+ * Compares resolving vertex ids one at a time through `get_vertex` against the batched `get_vertices`.
+ *
+ * Run with: bazel run -c opt //benchmark:bench_batch_lookup
+ */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace {
+    constexpr std::size_t VERTEX_COUNT {1U << 21U};
+    constexpr std::size_t LOOKUPS_PER_RUN {1U << 22U};
+
+    template <typename F> double lookups_per_second(F&& run) {
+        const auto start {std::chrono::steady_clock::now()};
+        run();
+        const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+        return static_cast<double>(LOOKUPS_PER_RUN) / elapsed.count();
+    }
+}
+
+int main() {
+    cgrapht::DirectedGraph<std::size_t, cgrapht::DefaultEdge> graph;
+    std::vector<std::size_t> vertex_ids {};
+    vertex_ids.reserve(VERTEX_COUNT);
+
+    // Spread the keys out so consecutive ids do not land in consecutive buckets.
+    std::mt19937_64 rng {42};
+    for (std::size_t i {0}; i < VERTEX_COUNT; ++i) {
+        vertex_ids.push_back(graph.add_vertex(rng()).get_ok());
+    }
+
+    std::vector<std::size_t> queries(LOOKUPS_PER_RUN);
+    std::uniform_int_distribution<std::size_t> pick {0, VERTEX_COUNT - 1};
+    for (auto& query : queries) {
+        query = vertex_ids[pick(rng)];
+    }
+
+    std::printf("%10s %18s %18s %8s\n", "batch", "single (M/s)", "batched (M/s)", "speedup");
+    for (std::size_t batch {16}; batch <= 4096; batch *= 4) {
+        std::size_t checksum {0};
+
+        const double single {lookups_per_second([&] {
+            for (const std::size_t id : queries) {
+                checksum += graph.get_vertex(id).get_ok();
+            }
+        })};
+
+        std::vector<cgrapht::Result<std::size_t, cgrapht::ErrorType>> out {};
+        const double batched {lookups_per_second([&] {
+            for (std::size_t start {0}; start < queries.size(); start += batch) {
+                graph.get_vertices(std::span<const std::size_t>{queries}.subspan(start, batch), out);
+                for (const auto& result : out) {
+                    checksum += result.get_ok();
+                }
+            }
+        })};
+
+        std::printf("%10zu %18.2f %18.2f %7.2fx   (checksum %zu)\n", batch, single / 1e6, batched / 1e6, batched / single, checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * Reports preprocessing time and memory of a `ContractionHierarchy` on a grid shaped road network of cities and roads,
+ * and compares its query latency with a plain Dijkstra over the `FrozenGraph`.
+ *
+ * Run with: bazel run -c opt //benchmark:bench_contraction_hierarchy
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "cgrapht/algorithms/contraction_hierarchy.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+namespace {
+    constexpr std::size_t GRID_SIDE {200};
+    constexpr std::size_t CH_QUERIES {20'000};
+    constexpr std::size_t DIJKSTRA_QUERIES {50};
+
+    struct City {
+        std::string name;
+        int population;
+
+        bool operator==(const City& other) const {
+            return name == other.name && population == other.population;
+        }
+    };
+
+    struct Road {
+        std::string name;
+        double distance_km;
+
+        bool operator==(const Road& other) const {
+            return name == other.name && distance_km == other.distance_km;
+        }
+    };
+}
+
+template <>
+struct std::hash<City> {
+    std::size_t operator()(const City& city) const {
+        return std::hash<std::string>{}(city.name);
+    }
+};
+
+template <>
+struct std::hash<Road> {
+    std::size_t operator()(const Road& road) const {
+        return std::hash<std::string>{}(road.name);
+    }
+};
+
+namespace {
+    double seconds_since(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double peak_rss_mib() {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;
+    }
+
+    double dijkstra(const cgrapht::AdjacencyMatrix<double>& weights, const std::size_t source, const std::size_t target) {
+        const cgrapht::FrozenGraph& graph {weights.frozen_graph()};
+        const auto offsets {graph.outgoing_offsets()};
+        const auto targets {graph.outgoing_targets()};
+        const auto values {weights.row_values()};
+        std::vector<double> distance(graph.vertex_count(), cgrapht::MinPlus<double>::zero());
+        std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, std::greater<>> queue {};
+        distance[source] = 0;
+        queue.emplace(0.0, source);
+        while (!queue.empty()) {
+            const auto [d, u] = queue.top();
+            queue.pop();
+            if (u == target) {
+                return d;
+            }
+            if (d > distance[u]) {
+                continue;
+            }
+            for (std::size_t slot {offsets[u]}; slot < offsets[u + 1]; ++slot) {
+                if (d + values[slot] < distance[targets[slot]]) {
+                    distance[targets[slot]] = d + values[slot];
+                    queue.emplace(distance[targets[slot]], targets[slot]);
+                }
+            }
+        }
+        return cgrapht::MinPlus<double>::zero();
+    }
+}
+
+int main() {
+    cgrapht::DirectedGraph<City, Road> graph;
+    std::vector<std::size_t> ids {};
+    std::mt19937_64 rng {1};
+    std::uniform_int_distribution<int> population {1'000, 1'000'000};
+    std::uniform_real_distribution<double> length {1.0, 50.0};
+    for (std::size_t i {0}; i < GRID_SIDE * GRID_SIDE; ++i) {
+        ids.push_back(graph.add_vertex(City{"city-" + std::to_string(i), population(rng)}).get_ok());
+    }
+    std::size_t road {0};
+    auto connect = [&](const std::size_t a, const std::size_t b) {
+        const double km {length(rng)};
+        graph.add_edge(ids[a], ids[b], Road{"road-" + std::to_string(road++), km});
+        graph.add_edge(ids[b], ids[a], Road{"road-" + std::to_string(road++), km});
+    };
+    for (std::size_t r {0}; r < GRID_SIDE; ++r) {
+        for (std::size_t c {0}; c < GRID_SIDE; ++c) {
+            if (c + 1 < GRID_SIDE) {
+                connect(r * GRID_SIDE + c, r * GRID_SIDE + c + 1);
+            }
+            if (r + 1 < GRID_SIDE) {
+                connect(r * GRID_SIDE + c, (r + 1) * GRID_SIDE + c);
+            }
+        }
+    }
+
+    const cgrapht::FrozenGraph frozen {graph};
+    const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, graph, [](const Road& r) { return r.distance_km; }).consume_ok()};
+    const double rss_before {peak_rss_mib()};
+
+    auto start {std::chrono::steady_clock::now()};
+    const auto hierarchy {cgrapht::ContractionHierarchy<double>::build(weights).consume_ok()};
+    const double build_seconds {seconds_since(start)};
+    std::printf("vertices=%zu edges=%zu build=%.3fs shortcuts=%zu hierarchy=%.2f MiB peak_rss_growth=%.2f MiB\n", frozen.vertex_count(),
+                frozen.edge_count(), build_seconds, hierarchy.shortcut_count(), static_cast<double>(hierarchy.memory_bytes()) / (1024.0 * 1024.0),
+                peak_rss_mib() - rss_before);
+
+    std::uniform_int_distribution<std::size_t> pick {0, frozen.vertex_count() - 1};
+    std::vector<std::pair<std::size_t, std::size_t>> queries(CH_QUERIES);
+    for (auto& [from, to] : queries) {
+        from = pick(rng);
+        to = pick(rng);
+    }
+
+    start = std::chrono::steady_clock::now();
+    double checksum {0};
+    for (const auto& [from, to] : queries) {
+        checksum += hierarchy.distance(frozen.vertex_id(from), frozen.vertex_id(to)).get_ok();
+    }
+    const double ch_seconds {seconds_since(start)};
+
+    start = std::chrono::steady_clock::now();
+    std::size_t mismatches {0};
+    for (std::size_t q {0}; q < DIJKSTRA_QUERIES; ++q) {
+        const double expected {dijkstra(weights, queries[q].first, queries[q].second)};
+        const double found {hierarchy.distance(frozen.vertex_id(queries[q].first), frozen.vertex_id(queries[q].second)).get_ok()};
+        // Sums are taken in a different order, so allow for rounding.
+        mismatches += std::abs(expected - found) > 1e-9 * expected;
+    }
+    const double dijkstra_seconds {seconds_since(start)};
+
+    std::printf("contraction hierarchy query=%.2f us (checksum %.1f)\n", ch_seconds / static_cast<double>(CH_QUERIES) * 1e6, checksum);
+    std::printf("plain Dijkstra query=%.2f us mismatches=%zu/%zu\n", dijkstra_seconds / static_cast<double>(DIJKSTRA_QUERIES) * 1e6, mismatches,
+                DIJKSTRA_QUERIES);
+    return 0;
+}
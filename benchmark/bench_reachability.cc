@@ -0,0 +1,93 @@
+/**
+ * Reports build time and size of a `ReachabilityIndex` on a random DAG, and compares its query throughput with a plain
+ * DFS over `get_children`.
+ *
+ * Run with: bazel run -c opt //benchmark:bench_reachability
+ */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "cgrapht/algorithms/reachability.hpp"
+#include "cgrapht/default_edge.hpp"
+
+namespace {
+    constexpr std::size_t VERTEX_COUNT {200'000};
+    constexpr std::size_t EDGE_COUNT {800'000};
+    constexpr std::size_t INDEX_QUERIES {500'000};
+    constexpr std::size_t DFS_QUERIES {20};
+
+    double seconds_since(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool dfs_reachable(const cgrapht::DirectedGraph<std::size_t, cgrapht::DefaultEdge>& graph, const std::size_t from, const std::size_t to) {
+        std::unordered_set<std::size_t> seen {from};
+        std::vector<std::size_t> stack {from};
+        while (!stack.empty()) {
+            const std::size_t v {stack.back()};
+            stack.pop_back();
+            if (v == to) {
+                return true;
+            }
+            const auto children {graph.get_children(v).consume_ok()};
+            for (const std::size_t child : children) {
+                if (seen.insert(child).second) {
+                    stack.push_back(child);
+                }
+            }
+        }
+        return false;
+    }
+}
+
+int main() {
+    cgrapht::DirectedGraph<std::size_t, cgrapht::DefaultEdge> graph;
+    std::vector<std::size_t> ids {};
+    for (std::size_t i {0}; i < VERTEX_COUNT; ++i) {
+        ids.push_back(graph.add_vertex(i).get_ok());
+    }
+
+    // Edges only point "forward" in a hidden order, which keeps the graph acyclic. Most edges are local.
+    std::mt19937_64 rng {1};
+    std::geometric_distribution<std::size_t> span {0.01};
+    std::uniform_int_distribution<std::size_t> pick {0, VERTEX_COUNT - 2};
+    for (std::size_t e {0}; e < EDGE_COUNT; ++e) {
+        const std::size_t from {pick(rng)};
+        const std::size_t to {std::min(VERTEX_COUNT - 1, from + 1 + span(rng))};
+        graph.add_edge(ids[from], ids[to], cgrapht::DefaultEdge{e});
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> queries(INDEX_QUERIES);
+    for (auto& [from, to] : queries) {
+        from = ids[pick(rng)];
+        to = ids[pick(rng)];
+    }
+
+    for (const std::size_t labelings : {2, 5}) {
+        auto start {std::chrono::steady_clock::now()};
+        auto index {cgrapht::ReachabilityIndex::build(cgrapht::FrozenGraph{graph}, {.labelings = labelings}).consume_ok()};
+        const double build_seconds {seconds_since(start)};
+
+        start = std::chrono::steady_clock::now();
+        std::size_t positives {0};
+        for (const auto& [from, to] : queries) {
+            positives += index.reachable(from, to).get_ok();
+        }
+        const double index_seconds {seconds_since(start)};
+
+        std::printf("labelings=%zu build=%.3fs labels=%.2f MiB queries=%.2f M/s positive=%zu/%zu\n", labelings, build_seconds,
+                    static_cast<double>(index.label_bytes()) / (1024.0 * 1024.0), static_cast<double>(INDEX_QUERIES) / index_seconds / 1e6,
+                    positives, INDEX_QUERIES);
+    }
+
+    const auto start {std::chrono::steady_clock::now()};
+    std::size_t positives {0};
+    for (std::size_t q {0}; q < DFS_QUERIES; ++q) {
+        positives += dfs_reachable(graph, queries[q].first, queries[q].second);
+    }
+    std::printf("plain DFS queries=%.6f M/s positive=%zu/%zu\n", static_cast<double>(DFS_QUERIES) / seconds_since(start) / 1e6, positives, DFS_QUERIES);
+    return 0;
+}
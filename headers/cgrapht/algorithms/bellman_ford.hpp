@@ -0,0 +1,275 @@
+/**
+ * @file bellman_ford.hpp
+ *
+ * @brief Single source shortest paths with negative weights, reporting negative cycles.
+ *
+ * @Detail
+ * `bellman_ford` computes distances and a shortest path tree from one source over an `AdjacencyMatrix<T>` whose
+ * weights may be negative. Two relaxation strategies are available:
+ *
+ * - `RelaxationStrategy::QUEUE` (SPFA) keeps a FIFO queue of vertices whose distance dropped and only relaxes their
+ *   outgoing edges, terminating as soon as the queue drains. Negative cycles are caught by periodically checking the
+ *   parent pointers for a cycle (amortized "walk to root"), which costs O(n) every n relaxations.
+ * - `RelaxationStrategy::PARALLEL_EDGES` relaxes all CSR slots in rounds, split into chunks over the workers. Each
+ *   chunk skips edges whose source did not improve in the previous round, and distances are lowered with an atomic
+ *   compare-and-swap minimum. It stops after the first round without improvement; improvement in round n proves a
+ *   negative cycle, which is then extracted with the queue strategy.
+ *
+ * A negative cycle reachable from the source is reported as an error result whose `cycle` lists its vertex ids in edge
+ * order.
+ *
+ * Reference: Cherkassky and Goldberg, "Negative-cycle detection algorithms", 1999.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Parent of the source and of unreachable vertices in a `ShortestPathTree`.
+     */
+    inline constexpr std::size_t NO_PARENT {std::numeric_limits<std::size_t>::max()};
+
+    /**
+     * @brief How `bellman_ford` relaxes edges.
+     */
+    enum class RelaxationStrategy {
+        QUEUE,          ///< Sequential SPFA with a FIFO queue of improved vertices.
+        PARALLEL_EDGES  ///< Rounds over all edges in parallel chunks with atomic minimum updates.
+    };
+
+    /**
+     * @brief Options for `bellman_ford`.
+     */
+    struct BellmanFordOptions {
+        RelaxationStrategy strategy {RelaxationStrategy::QUEUE};
+        std::size_t threads {0};    ///< Workers for `PARALLEL_EDGES`, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Distances and parents from one source, indexed by dense index.
+     */
+    template <typename T>
+    struct ShortestPathTree {
+        std::vector<T> distances{};         ///< `MinPlus<T>::zero()` where unreachable.
+        std::vector<std::size_t> parents{}; ///< Dense index of the previous vertex, or `NO_PARENT`.
+    };
+
+    /**
+     * @brief Error of `bellman_ford`.
+     */
+    struct ShortestPathError {
+        ErrorType error;                    ///< `ABSENT_VERTEX` or `CYCLE_DETECTED`.
+        std::vector<std::size_t> cycle{};   ///< For `CYCLE_DETECTED`, the vertex ids of a negative cycle in edge order.
+
+        bool operator==(const ShortestPathError&) const = default;
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * A cycle among the parent pointers, as dense indices in edge order, or nothing.
+         */
+        inline std::vector<std::size_t> parent_cycle(std::span<const std::size_t> parents, std::vector<std::size_t>& walk) {
+            const std::size_t n {parents.size()};
+            walk.assign(n, 0);
+            for (std::size_t start {0}; start < n; ++start) {
+                std::size_t v {start};
+                while (v != NO_PARENT && walk[v] == 0) {
+                    walk[v] = start + 1;
+                    v = parents[v];
+                }
+                if (v != NO_PARENT && walk[v] == start + 1) {
+                    std::vector<std::size_t> cycle {v};
+                    for (std::size_t u {parents[v]}; u != v; u = parents[u]) {
+                        cycle.push_back(u);
+                    }
+                    std::ranges::reverse(cycle);
+                    return cycle;
+                }
+            }
+            return {};
+        }
+
+        template <typename T>
+        Result<ShortestPathTree<T>, ShortestPathError> queue_relaxation(const AdjacencyMatrix<T>& weights, const std::size_t source) {
+            const FrozenGraph& graph {weights.frozen_graph()};
+            const std::size_t n {graph.vertex_count()};
+            const auto offsets {graph.outgoing_offsets()};
+            const auto targets {graph.outgoing_targets()};
+            const auto values {weights.row_values()};
+            ShortestPathTree<T> tree {std::vector<T>(n, MinPlus<T>::zero()), std::vector<std::size_t>(n, NO_PARENT)};
+            std::vector<std::uint8_t> queued(n, 0);
+            std::vector<std::size_t> walk {};
+            std::deque<std::size_t> queue {source};
+            tree.distances[source] = T{0};
+            queued[source] = 1;
+
+            std::size_t relaxations {0};
+            while (!queue.empty()) {
+                const std::size_t u {queue.front()};
+                queue.pop_front();
+                queued[u] = 0;
+                for (std::size_t slot {offsets[u]}; slot < offsets[u + 1]; ++slot) {
+                    const std::size_t v {targets[slot]};
+                    const T candidate {tree.distances[u] + values[slot]};
+                    if (!(candidate < tree.distances[v])) {
+                        continue;
+                    }
+                    tree.distances[v] = candidate;
+                    tree.parents[v] = u;
+                    if (!queued[v]) {
+                        queued[v] = 1;
+                        queue.push_back(v);
+                    }
+                    // A cycle among the parents is always negative, and one appears eventually if a negative cycle
+                    // is reachable.
+                    if (++relaxations % n == 0) {
+                        std::vector<std::size_t> cycle {parent_cycle(tree.parents, walk)};
+                        if (!cycle.empty()) {
+                            for (std::size_t& index : cycle) {
+                                index = graph.vertex_id(index);
+                            }
+                            return Result<ShortestPathTree<T>, ShortestPathError>::error(ShortestPathError{ErrorType::CYCLE_DETECTED, std::move(cycle)});
+                        }
+                    }
+                }
+            }
+            return Result<ShortestPathTree<T>, ShortestPathError>::success(std::move(tree));
+        }
+
+        template <typename T>
+        bool atomic_lower(T& target, const T value) {
+            std::atomic_ref<T> slot {target};
+            T current {slot.load(std::memory_order_relaxed)};
+            while (value < current) {
+                if (slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Shortest paths from one source with possibly negative weights.
+     *
+     * With `PARALLEL_EDGES`, concurrent updates can leave a parent that no longer matches the final distance; such
+     * parents are replaced by a tight incoming edge at the end. Where zero weight cycles make several parents tight,
+     * any one of them is kept.
+     *
+     * @tparam T Weight type.
+     * @param weights Edge weights, e.g. from `AdjacencyMatrix<T>::weighted`.
+     * @param source_id Vertex id to start from.
+     * @param options Strategy and workers.
+     * @param tracer With `PARALLEL_EDGES`, receives a `bellman_ford.round` span and a `bellman_ford.active` counter
+     *        per round. See `tracing.hpp`.
+     * @return Result containing the shortest path tree, or an error with `ABSENT_VERTEX`, or with `CYCLE_DETECTED` and
+     *         the vertices of a negative cycle reachable from the source.
+     */
+    template <typename T, typename Tracer = NoTracer>
+    Result<ShortestPathTree<T>, ShortestPathError> bellman_ford(const AdjacencyMatrix<T>& weights, const std::size_t source_id,
+                                                                const BellmanFordOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        const FrozenGraph& graph {weights.frozen_graph()};
+        auto source = graph.index_of(source_id);
+        if (!source.is_ok()) {
+            return Result<ShortestPathTree<T>, ShortestPathError>::error(ShortestPathError{source.get_error()});
+        }
+        if (options.strategy == RelaxationStrategy::QUEUE) {
+            return detail::queue_relaxation(weights, source.get_ok());
+        }
+
+        constexpr T infinity {MinPlus<T>::zero()};
+        const std::size_t n {graph.vertex_count()};
+        const std::size_t m {graph.edge_count()};
+        const auto offsets {graph.outgoing_offsets()};
+        const auto targets {graph.outgoing_targets()};
+        const auto values {weights.row_values()};
+        ShortestPathTree<T> tree {std::vector<T>(n, infinity), std::vector<std::size_t>(n, NO_PARENT)};
+        std::vector<std::uint8_t> active(n, 0);
+        std::vector<std::uint8_t> next_active(n, 0);
+        tree.distances[source.get_ok()] = T{0};
+        active[source.get_ok()] = 1;
+
+        for (std::size_t round {0};; ++round) {
+            if (round == n) {
+                // Still improving after n rounds.
+                return detail::queue_relaxation(weights, source.get_ok());
+            }
+            const detail::TraceSpan span {tracer, "bellman_ford.round"};
+            std::atomic<std::size_t> improved {0};
+            parallel_for(m, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                // Source of the first slot of the chunk; later ones follow by advancing over the offsets.
+                std::size_t u {static_cast<std::size_t>(std::ranges::upper_bound(offsets, begin) - offsets.begin()) - 1};
+                std::size_t local {0};
+                for (std::size_t slot {begin}; slot < end; ++slot) {
+                    while (offsets[u + 1] <= slot) {
+                        ++u;
+                    }
+                    if (!active[u]) {
+                        slot = std::min(end, offsets[u + 1]) - 1;
+                        continue;
+                    }
+                    const T from {std::atomic_ref<T>{tree.distances[u]}.load(std::memory_order_relaxed)};
+                    const std::size_t v {targets[slot]};
+                    if (detail::atomic_lower(tree.distances[v], from + values[slot])) {
+                        std::atomic_ref<std::size_t>{tree.parents[v]}.store(u, std::memory_order_relaxed);
+                        std::atomic_ref<std::uint8_t>{next_active[v]}.store(1, std::memory_order_relaxed);
+                        ++local;
+                    }
+                }
+                improved.fetch_add(local, std::memory_order_relaxed);
+            }, options.threads, 1024);
+            detail::trace_counter(tracer, "bellman_ford.active", static_cast<double>(improved.load()));
+            if (improved.load() == 0) {
+                break;
+            }
+            std::swap(active, next_active);
+            std::ranges::fill(next_active, std::uint8_t{0});
+        }
+
+        // Repair parents left behind by racing updates.
+        const auto in_offsets {graph.incoming_offsets()};
+        const auto sources {graph.incoming_sources()};
+        const auto in_values {weights.column_values()};
+        parallel_for(n, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t v {begin}; v < end; ++v) {
+                const std::size_t parent {tree.parents[v]};
+                if (parent == NO_PARENT) {
+                    continue;
+                }
+                auto tight = [&](const std::size_t slot) {
+                    return sources[slot] == parent && tree.distances[parent] + in_values[slot] == tree.distances[v];
+                };
+                bool consistent {false};
+                for (std::size_t slot {in_offsets[v]}; slot < in_offsets[v + 1] && !consistent; ++slot) {
+                    consistent = tight(slot);
+                }
+                for (std::size_t slot {in_offsets[v]}; slot < in_offsets[v + 1] && !consistent; ++slot) {
+                    if (tree.distances[sources[slot]] != infinity && tree.distances[sources[slot]] + in_values[slot] == tree.distances[v]) {
+                        tree.parents[v] = sources[slot];
+                        consistent = true;
+                    }
+                }
+            }
+        }, options.threads);
+        return Result<ShortestPathTree<T>, ShortestPathError>::success(std::move(tree));
+    }
+}
@@ -0,0 +1,388 @@
+/**
+ * @file bipartite_matching.hpp
+ *
+ * @brief Maximum cardinality matching (Hopcroft-Karp) and maximum weight assignment (auction) on bipartite graphs.
+ *
+ * @Detail
+ * The bipartite graph is a `FrozenGraph` whose edges all run from the left side (e.g. jobs) to the right side (e.g.
+ * workers): vertices with outgoing edges are left, vertices with incoming edges are right, and no vertex may be both.
+ * All state lives in flat arrays over dense indices.
+ *
+ * - `hopcroft_karp` finds a maximum cardinality matching in O(m sqrt(n)). After a greedy initial matching, every phase
+ *   builds the BFS layers of alternating paths from all free left vertices, then augments along a maximal set of
+ *   vertex disjoint shortest paths with an iterative DFS that remembers its position in every adjacency list.
+ * - `auction_assignment` finds a maximum weight matching with Bertsekas' auction algorithm. The sparse
+ *   instance is first made symmetric: every left vertex gets a private dummy worth 0 and every right vertex a dummy
+ *   bidder, so a perfect assignment always exists and leaving a vertex unmatched costs nothing. Unassigned bidders bid
+ *   for their most valuable object (weight minus price), raising its price by the margin over their second best option
+ *   plus epsilon. Bids of a round are computed in parallel (Jacobi auction) and the highest bid per object wins.
+ *   Epsilon scaling keeps prices between phases and refines epsilon until the result is within
+ *   `vertices * epsilon` of optimal; the default epsilon makes integer weights exact.
+ *
+ * Reference: Hopcroft and Karp, "An n^5/2 Algorithm for Maximum Matchings in Bipartite Graphs", 1973; Bertsekas, "The
+ * Auction Algorithm: A Distributed Relaxation Method for the Assignment Problem", 1988.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Mate of an unmatched vertex.
+     */
+    inline constexpr std::size_t UNMATCHED {std::numeric_limits<std::size_t>::max()};
+
+    /**
+     * @brief A matching, indexed by dense index.
+     */
+    struct Matching {
+        std::vector<std::size_t> mates{};   ///< Dense index of the partner, or `UNMATCHED`.
+        std::size_t size {0};              ///< Number of matched pairs.
+    };
+
+    /**
+     * @brief A weighted matching, indexed by dense index.
+     */
+    template <typename T>
+    struct Assignment {
+        std::vector<std::size_t> mates{};   ///< Dense index of the partner, or `UNMATCHED`.
+        std::size_t size {0};              ///< Number of matched pairs.
+        T weight {};                        ///< Total weight of the matched edges.
+    };
+
+    /**
+     * @brief Options for `auction_assignment`.
+     */
+    struct AuctionOptions {
+        double epsilon {0};         ///< Final bid increment, 0 for `1 / (vertices + 1)`.
+        double scaling {4};         ///< Factor epsilon shrinks by between phases.
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * Whether every vertex has only outgoing or only incoming edges.
+         */
+        inline bool is_left_to_right(const FrozenGraph& graph) {
+            for (std::size_t i {0}; i < graph.vertex_count(); ++i) {
+                if (graph.out_degree(i) != 0 && graph.in_degree(i) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Maximum cardinality matching.
+     *
+     * @param graph Bipartite frozen graph with edges from left to right.
+     * @param tracer Receives a `hopcroft_karp.phase` span and a `hopcroft_karp.matched` counter per phase.
+     * @return Result containing the matching, or `INVALID_ARGUMENT` if a vertex has both incoming and outgoing edges.
+     */
+    template <typename Tracer = NoTracer>
+    Result<Matching, ErrorType> hopcroft_karp(const FrozenGraph& graph, Tracer&& tracer = Tracer{}) {
+        if (!detail::is_left_to_right(graph)) {
+            return Result<Matching, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        constexpr std::size_t UNLAYERED {std::numeric_limits<std::size_t>::max()};
+        const std::size_t n {graph.vertex_count()};
+        const auto offsets {graph.outgoing_offsets()};
+        const auto targets {graph.outgoing_targets()};
+        Matching matching {std::vector<std::size_t>(n, UNMATCHED), 0};
+        std::vector<std::size_t>& mate {matching.mates};
+
+        std::vector<std::size_t> left {};
+        for (std::size_t u {0}; u < n; ++u) {
+            if (graph.out_degree(u) != 0) {
+                left.push_back(u);
+                for (std::size_t slot {offsets[u]}; slot < offsets[u + 1]; ++slot) {
+                    if (mate[targets[slot]] == UNMATCHED) {
+                        mate[targets[slot]] = u;
+                        mate[u] = targets[slot];
+                        ++matching.size;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<std::size_t> layer(n, UNLAYERED);
+        std::vector<std::size_t> queue {};
+        std::vector<std::size_t> cursor(n, 0);
+        std::vector<std::size_t> stack {};
+        std::vector<std::size_t> via(n, UNMATCHED);
+        queue.reserve(left.size());
+        for (;;) {
+            const detail::TraceSpan span {tracer, "hopcroft_karp.phase"};
+            // Layers of left vertices along alternating paths from the free ones.
+            queue.clear();
+            for (const std::size_t u : left) {
+                layer[u] = mate[u] == UNMATCHED ? 0 : UNLAYERED;
+                if (mate[u] == UNMATCHED) {
+                    queue.push_back(u);
+                }
+            }
+            std::size_t free_layer {UNLAYERED};
+            for (std::size_t head {0}; head < queue.size(); ++head) {
+                const std::size_t u {queue[head]};
+                if (layer[u] + 1 >= free_layer) {
+                    continue;
+                }
+                for (std::size_t slot {offsets[u]}; slot < offsets[u + 1]; ++slot) {
+                    const std::size_t w {mate[targets[slot]]};
+                    if (w == UNMATCHED) {
+                        free_layer = std::min(free_layer, layer[u] + 1);
+                    } else if (layer[w] == UNLAYERED) {
+                        layer[w] = layer[u] + 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+            if (free_layer == UNLAYERED) {
+                break;
+            }
+
+            // Vertex disjoint shortest augmenting paths.
+            for (const std::size_t u : left) {
+                cursor[u] = offsets[u];
+            }
+            for (const std::size_t root : left) {
+                if (mate[root] != UNMATCHED || layer[root] != 0) {
+                    continue;
+                }
+                stack.assign(1, root);
+                while (!stack.empty()) {
+                    const std::size_t x {stack.back()};
+                    if (cursor[x] == offsets[x + 1]) {
+                        layer[x] = UNLAYERED;
+                        stack.pop_back();
+                        continue;
+                    }
+                    const std::size_t v {targets[cursor[x]++]};
+                    const std::size_t w {mate[v]};
+                    if (w == UNMATCHED ? layer[x] + 1 == free_layer : layer[w] == layer[x] + 1) {
+                        via[x] = v;
+                        if (w != UNMATCHED) {
+                            stack.push_back(w);
+                            continue;
+                        }
+                        for (const std::size_t y : stack) {
+                            mate[y] = via[y];
+                            mate[via[y]] = y;
+                            layer[y] = UNLAYERED;
+                        }
+                        ++matching.size;
+                        stack.clear();
+                    }
+                }
+            }
+            detail::trace_counter(tracer, "hopcroft_karp.matched", static_cast<double>(matching.size));
+        }
+        return Result<Matching, ErrorType>::success(std::move(matching));
+    }
+
+    /**
+     * @brief Maximum weight matching with the auction algorithm.
+     *
+     * Edges of negative weight never improve a matching and are left out of the result.
+     *
+     * @tparam T Weight type.
+     * @param weights Weights of the edges from left to right.
+     * @param options Final epsilon, scaling and workers.
+     * @param tracer Receives an `auction.phase` span per epsilon scaling phase and an `auction.unassigned` counter per
+     *        bidding round.
+     * @return Result containing the assignment, or `INVALID_ARGUMENT` if a vertex has both incoming and outgoing edges
+     *         or the options are invalid.
+     */
+    template <typename T, typename Tracer = NoTracer>
+    Result<Assignment<T>, ErrorType> auction_assignment(const AdjacencyMatrix<T>& weights, const AuctionOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        const FrozenGraph& graph {weights.frozen_graph()};
+        if (!detail::is_left_to_right(graph) || options.epsilon < 0 || !(options.scaling > 1)) {
+            return Result<Assignment<T>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const std::size_t n {graph.vertex_count()};
+        const auto offsets {graph.outgoing_offsets()};
+        const auto targets {graph.outgoing_targets()};
+        const auto in_offsets {graph.incoming_offsets()};
+        const auto sources {graph.incoming_sources()};
+        const auto values {weights.row_values()};
+
+        // Persons and objects share the dense indices. Left person u bids for right objects at the edge weight, or for
+        // its own dummy object u at 0. Right vertex r adds a person that takes object r, or the dummy of any parent,
+        // at 0. Perfect assignments of this symmetric problem are exactly the matchings with the same weight.
+        std::vector<std::size_t> persons {};
+        double largest {0};
+        for (std::size_t v {0}; v < n; ++v) {
+            if (graph.out_degree(v) != 0 || graph.in_degree(v) != 0) {
+                persons.push_back(v);
+            }
+        }
+        for (const T value : values) {
+            largest = std::max(largest, std::abs(static_cast<double>(value)));
+        }
+        const double final_epsilon {options.epsilon > 0 ? options.epsilon : 1.0 / static_cast<double>(persons.size() + 1)};
+        // Late rounds often hold a single bidder, so the worker count is resolved once rather than per round.
+        const std::size_t workers {worker_count(options.threads)};
+
+        std::vector<double> price(n, 0.0);
+        std::vector<std::size_t> owner(n, UNMATCHED);       // object -> person
+        std::vector<std::size_t> assigned(n, UNMATCHED);    // person -> object
+        std::vector<std::size_t> bidders {};
+        std::vector<std::size_t> next {};
+        std::vector<std::size_t> bid_target(n, UNMATCHED);
+        std::vector<double> bid_amount(n, 0.0);
+        std::vector<double> best_bid(n, 0.0);
+        std::vector<std::size_t> best_bidder(n, UNMATCHED);
+        std::vector<std::size_t> contested {};
+
+        // Best and second best value among the options of a person, and the value of the object it holds.
+        struct Options {
+            std::size_t target;
+            double first;
+            double second;
+            double held;
+        };
+        auto scan = [&](const std::size_t p) {
+            constexpr double NONE {-std::numeric_limits<double>::infinity()};
+            Options best {p, -price[p], NONE, assigned[p] == p ? -price[p] : NONE};
+            auto offer = [&](const std::size_t object, const double value) {
+                if (object == assigned[p]) {
+                    best.held = std::max(best.held, value);
+                }
+                if (value > best.first) {
+                    // A parallel edge to the current best does not make a second option.
+                    if (object != best.target) {
+                        best.second = best.first;
+                    }
+                    best.first = value;
+                    best.target = object;
+                } else if (value > best.second && object != best.target) {
+                    best.second = value;
+                }
+            };
+            if (graph.out_degree(p) != 0) {
+                for (std::size_t slot {offsets[p]}; slot < offsets[p + 1]; ++slot) {
+                    offer(targets[slot], static_cast<double>(values[slot]) - price[targets[slot]]);
+                }
+            } else {
+                for (std::size_t slot {in_offsets[p]}; slot < in_offsets[p + 1]; ++slot) {
+                    offer(sources[slot], -price[sources[slot]]);
+                }
+            }
+            return best;
+        };
+
+        std::vector<std::uint8_t> released(n, 0);
+        for (double epsilon {std::max(largest / options.scaling, final_epsilon)};; epsilon = std::max(epsilon / options.scaling, final_epsilon)) {
+            const detail::TraceSpan span {tracer, "auction.phase"};
+            // Pairs that are still within epsilon of their best option stay; the rest bid again.
+            parallel_for(persons.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                for (std::size_t i {begin}; i < end; ++i) {
+                    const std::size_t p {persons[i]};
+                    if (assigned[p] != UNMATCHED) {
+                        const Options best {scan(p)};
+                        released[p] = best.held < best.first - epsilon;
+                    }
+                }
+            }, workers);
+            bidders.clear();
+            for (const std::size_t p : persons) {
+                if (assigned[p] != UNMATCHED && released[p]) {
+                    owner[assigned[p]] = UNMATCHED;
+                    assigned[p] = UNMATCHED;
+                }
+                if (assigned[p] == UNMATCHED) {
+                    bidders.push_back(p);
+                }
+            }
+            while (!bidders.empty()) {
+                detail::trace_counter(tracer, "auction.unassigned", static_cast<double>(bidders.size()));
+                // Bids, in parallel: the best object, raised by the margin over the second best plus epsilon.
+                parallel_for(bidders.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                    for (std::size_t b {begin}; b < end; ++b) {
+                        const std::size_t p {bidders[b]};
+                        const Options best {scan(p)};
+                        // An only option is worth taking at any price; bid as if the second were epsilon below.
+                        const double margin {best.second == -std::numeric_limits<double>::infinity() ? epsilon : best.first - best.second};
+                        bid_target[p] = best.target;
+                        bid_amount[p] = price[best.target] + margin + epsilon;
+                    }
+                }, workers, 256);
+
+                // Highest bid per object wins; its previous owner bids again next round.
+                contested.clear();
+                next.clear();
+                for (const std::size_t p : bidders) {
+                    const std::size_t object {bid_target[p]};
+                    if (best_bidder[object] == UNMATCHED) {
+                        contested.push_back(object);
+                    }
+                    if (best_bidder[object] == UNMATCHED || bid_amount[p] > best_bid[object]) {
+                        best_bidder[object] = p;
+                        best_bid[object] = bid_amount[p];
+                    }
+                }
+                for (const std::size_t p : bidders) {
+                    if (best_bidder[bid_target[p]] != p) {
+                        next.push_back(p);
+                    }
+                }
+                for (const std::size_t object : contested) {
+                    if (owner[object] != UNMATCHED) {
+                        assigned[owner[object]] = UNMATCHED;
+                        next.push_back(owner[object]);
+                    }
+                    owner[object] = best_bidder[object];
+                    assigned[best_bidder[object]] = object;
+                    price[object] = best_bid[object];
+                    best_bidder[object] = UNMATCHED;
+                }
+                std::swap(bidders, next);
+            }
+            if (epsilon <= final_epsilon) {
+                break;
+            }
+        }
+
+        Assignment<T> assignment {std::vector<std::size_t>(n, UNMATCHED), 0, T{}};
+        for (const std::size_t u : persons) {
+            const std::size_t v {assigned[u]};
+            if (graph.out_degree(u) == 0 || v == u) {
+                continue;
+            }
+            T best {};
+            bool found {false};
+            for (std::size_t slot {offsets[u]}; slot < offsets[u + 1]; ++slot) {
+                if (targets[slot] == v && (!found || values[slot] > best)) {
+                    best = values[slot];
+                    found = true;
+                }
+            }
+            if (best < T{0}) {
+                continue;
+            }
+            assignment.mates[u] = v;
+            assignment.mates[v] = u;
+            assignment.weight += best;
+            ++assignment.size;
+        }
+        return Result<Assignment<T>, ErrorType>::success(std::move(assignment));
+    }
+}
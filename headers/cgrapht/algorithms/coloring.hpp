@@ -0,0 +1,271 @@
+/**
+ * @file coloring.hpp
+ *
+ * @brief Vertex coloring: sequential greedy with vertex orderings and parallel speculative coloring.
+ *
+ * @Detail
+ * Coloring treats a `FrozenGraph` as undirected: the neighbours of a vertex are its children and its parents, and
+ * self loops are ignored. Adjacent vertices always get different colors, so every color class is a set of vertices
+ * that share no edge, e.g. operations that can run concurrently. Colors are `0 .. count - 1` in a dense array.
+ *
+ * - `greedy_coloring` visits the vertices in a `ColoringOrder` and gives each the smallest color none of its
+ *   neighbours has. `LARGEST_FIRST` sorts by degree; `SMALLEST_LAST` repeatedly removes a vertex of minimum remaining
+ *   degree with a bucket queue (Matula-Beck) and colors in reverse removal order, which uses at most degeneracy + 1
+ *   colors.
+ * - `speculative_coloring` colors all uncolored vertices in parallel from possibly stale neighbour colors, then checks
+ *   them in parallel for conflicts. Of two adjacent vertices with the same color, the one later in the order is
+ *   uncolored and retried in the next round. Rounds shrink quickly, since only vertices colored concurrently with a
+ *   neighbour can conflict.
+ *
+ * Both mark the colors taken around a vertex in a per worker array stamped with a visit counter, so nothing is
+ * cleared or allocated per vertex.
+ *
+ * Reference: Matula and Beck, "Smallest-last ordering and clustering and graph coloring algorithms", 1983;
+ * Gebremedhin and Manne, "Scalable parallel graph coloring algorithms", 2000.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Color of a vertex that has not been colored yet.
+     */
+    inline constexpr std::size_t NO_COLOR {std::numeric_limits<std::size_t>::max()};
+
+    /**
+     * @brief Order in which vertices pick their colors.
+     */
+    enum class ColoringOrder {
+        NATURAL,        ///< Dense index order.
+        LARGEST_FIRST,  ///< Descending degree, ties by dense index.
+        SMALLEST_LAST   ///< Reverse of repeatedly removing a vertex of minimum remaining degree.
+    };
+
+    /**
+     * @brief A vertex coloring, indexed by dense index.
+     */
+    struct Coloring {
+        std::vector<std::size_t> colors{};  ///< Color of every vertex, in `0 .. count - 1`.
+        std::size_t count {0};              ///< Number of colors used.
+    };
+
+    /**
+     * @brief Options for `speculative_coloring`.
+     */
+    struct SpeculativeColoringOptions {
+        ColoringOrder order {ColoringOrder::LARGEST_FIRST};    ///< Priority of vertices in conflicts.
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * Call `visit` with every neighbour of a vertex, ignoring edge direction and self loops.
+         */
+        template <typename F>
+        void for_each_neighbour(const FrozenGraph& graph, const std::size_t v, F&& visit) {
+            for (const std::size_t u : graph.children(v)) {
+                if (u != v) {
+                    visit(u);
+                }
+            }
+            for (const std::size_t u : graph.parents(v)) {
+                if (u != v) {
+                    visit(u);
+                }
+            }
+        }
+
+        inline std::size_t undirected_degree(const FrozenGraph& graph, const std::size_t v) {
+            std::size_t degree {0};
+            for_each_neighbour(graph, v, [&](std::size_t) { ++degree; });
+            return degree;
+        }
+
+        /**
+         * Dense indices in the requested order.
+         */
+        inline std::vector<std::size_t> coloring_order(const FrozenGraph& graph, const ColoringOrder order) {
+            const std::size_t n {graph.vertex_count()};
+            std::vector<std::size_t> vertices(n);
+            std::iota(vertices.begin(), vertices.end(), std::size_t{0});
+            if (order == ColoringOrder::NATURAL) {
+                return vertices;
+            }
+            std::vector<std::size_t> degree(n);
+            for (std::size_t v {0}; v < n; ++v) {
+                degree[v] = undirected_degree(graph, v);
+            }
+            if (order == ColoringOrder::LARGEST_FIRST) {
+                std::ranges::stable_sort(vertices, [&](const std::size_t a, const std::size_t b) { return degree[a] > degree[b]; });
+                return vertices;
+            }
+
+            // Bucket queue over remaining degree: `vertices` is sorted by degree, `start[d]` is the first position of
+            // degree d, and decrementing a neighbour swaps it to the front of its bucket (Batagelj and Zaversnik).
+            const std::size_t largest {n == 0 ? 0 : *std::ranges::max_element(degree)};
+            std::vector<std::size_t> start(largest + 2, 0);
+            for (const std::size_t d : degree) {
+                ++start[d + 1];
+            }
+            std::partial_sum(start.begin(), start.end(), start.begin());
+            std::vector<std::size_t> position(n);
+            {
+                std::vector<std::size_t> fill {start};
+                for (std::size_t v {0}; v < n; ++v) {
+                    position[v] = fill[degree[v]]++;
+                    vertices[position[v]] = v;
+                }
+            }
+            for (std::size_t i {0}; i < n; ++i) {
+                const std::size_t v {vertices[i]};
+                for_each_neighbour(graph, v, [&](const std::size_t u) {
+                    if (degree[u] <= degree[v]) {
+                        return;
+                    }
+                    const std::size_t front {start[degree[u]]};
+                    const std::size_t w {vertices[front]};
+                    std::swap(vertices[front], vertices[position[u]]);
+                    std::swap(position[w], position[u]);
+                    ++start[degree[u]];
+                    --degree[u];
+                });
+            }
+            std::ranges::reverse(vertices);
+            return vertices;
+        }
+
+        /**
+         * Colors taken around one vertex, stamped with a visit counter so marks never need clearing.
+         */
+        class ForbiddenColors {
+        private:
+            std::vector<std::uint64_t> stamp{};
+            std::uint64_t visit {0};
+
+        public:
+            void begin(const std::size_t degree) {
+                if (stamp.size() < degree + 1) {
+                    stamp.resize(degree + 1, 0);
+                }
+                ++visit;
+            }
+
+            void forbid(const std::size_t color) {
+                if (color < stamp.size()) {
+                    stamp[color] = visit;
+                }
+            }
+
+            [[nodiscard]] std::size_t smallest_free() const {
+                std::size_t color {0};
+                while (stamp[color] == visit) {
+                    ++color;
+                }
+                return color;
+            }
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Color the vertices one at a time in the given order.
+     *
+     * @param graph Frozen graph, treated as undirected.
+     * @param order Order in which vertices pick their colors.
+     * @return The coloring.
+     */
+    inline Coloring greedy_coloring(const FrozenGraph& graph, const ColoringOrder order = ColoringOrder::SMALLEST_LAST) {
+        Coloring coloring {std::vector<std::size_t>(graph.vertex_count(), NO_COLOR), 0};
+        detail::ForbiddenColors forbidden {};
+        for (const std::size_t v : detail::coloring_order(graph, order)) {
+            forbidden.begin(graph.out_degree(v) + graph.in_degree(v));
+            detail::for_each_neighbour(graph, v, [&](const std::size_t u) {
+                forbidden.forbid(coloring.colors[u]);
+            });
+            coloring.colors[v] = forbidden.smallest_free();
+            coloring.count = std::max(coloring.count, coloring.colors[v] + 1);
+        }
+        return coloring;
+    }
+
+    /**
+     * @brief Color the vertices in parallel rounds of speculative coloring and conflict resolution.
+     *
+     * With one worker there are no conflicts and the result equals `greedy_coloring` with the same order.
+     *
+     * @param graph Frozen graph, treated as undirected.
+     * @param options Conflict order and workers.
+     * @param tracer Receives a `coloring.round` span and a `coloring.conflicts` counter per round. See `tracing.hpp`.
+     * @return The coloring.
+     */
+    template <typename Tracer = NoTracer>
+    Coloring speculative_coloring(const FrozenGraph& graph, const SpeculativeColoringOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        const std::size_t n {graph.vertex_count()};
+        const std::size_t workers {worker_count(options.threads)};
+        std::vector<std::size_t> pending {detail::coloring_order(graph, options.order)};
+        std::vector<std::size_t> rank(n);
+        for (std::size_t i {0}; i < n; ++i) {
+            rank[pending[i]] = i;
+        }
+        std::vector<std::size_t> colors(n, NO_COLOR);
+        std::vector<detail::ForbiddenColors> forbidden(workers);
+        std::vector<std::vector<std::size_t>> retry(workers);
+
+        while (!pending.empty()) {
+            const detail::TraceSpan span {tracer, "coloring.round"};
+            // Tentative colors from whatever the neighbours hold right now.
+            parallel_for(pending.size(), [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                detail::ForbiddenColors& taken {forbidden[worker]};
+                for (std::size_t i {begin}; i < end; ++i) {
+                    const std::size_t v {pending[i]};
+                    taken.begin(graph.out_degree(v) + graph.in_degree(v));
+                    detail::for_each_neighbour(graph, v, [&](const std::size_t u) {
+                        taken.forbid(std::atomic_ref<std::size_t>{colors[u]}.load(std::memory_order_relaxed));
+                    });
+                    std::atomic_ref<std::size_t>{colors[v]}.store(taken.smallest_free(), std::memory_order_relaxed);
+                }
+            }, workers, 256);
+
+            // A vertex that clashes with a neighbour earlier in the order gives up its color.
+            parallel_for(pending.size(), [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                for (std::size_t i {begin}; i < end; ++i) {
+                    const std::size_t v {pending[i]};
+                    bool clash {false};
+                    detail::for_each_neighbour(graph, v, [&](const std::size_t u) {
+                        clash = clash || (colors[u] == colors[v] && rank[u] < rank[v]);
+                    });
+                    if (clash) {
+                        retry[worker].push_back(v);
+                    }
+                }
+            }, workers, 256);
+            pending.clear();
+            for (std::vector<std::size_t>& buffer : retry) {
+                pending.insert(pending.end(), buffer.begin(), buffer.end());
+                buffer.clear();
+            }
+            for (const std::size_t v : pending) {
+                colors[v] = NO_COLOR;
+            }
+            std::ranges::sort(pending, {}, [&](const std::size_t v) { return rank[v]; });
+            detail::trace_counter(tracer, "coloring.conflicts", static_cast<double>(pending.size()));
+        }
+
+        const std::size_t count {n == 0 ? 0 : *std::ranges::max_element(colors) + 1};
+        return Coloring{std::move(colors), count};
+    }
+}
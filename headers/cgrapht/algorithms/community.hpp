@@ -0,0 +1,531 @@
+/**
+ * @file community.hpp
+ *
+ * @brief Community detection: parallel label propagation and Louvain modularity optimization.
+ *
+ * @Detail
+ * Both algorithms take an `AdjacencyMatrix` (see `semiring.hpp`), so edge weights come from any payload projection,
+ * and treat the graph as undirected: the weight between `i` and `j` is the sum of the weights of the edges `i -> j`
+ * and `j -> i`. Weights must be non negative. The result labels every dense vertex index with a community in
+ * `0 .. count - 1`, numbered in order of first appearance.
+ *
+ * - `label_propagation` repeatedly moves every vertex, in a random order, to the label carrying the most weight among
+ *   its neighbours. Workers update the shared labels asynchronously, so a vertex sees the labels its neighbours took
+ *   earlier in the same sweep. It is fast but does not optimize any objective.
+ * - `louvain` greedily moves vertices between communities while modularity improves, in parallel with atomically
+ *   maintained community totals, then coarsens every community into a single vertex and repeats on the smaller graph.
+ *   A singleton only joins another singleton of lower id, which keeps pairs of vertices from swapping forever.
+ *
+ * Both use a per worker open addressing accumulator to sum the weight towards each neighbouring community, so no
+ * allocation happens per vertex. With more than one worker the outcome depends on scheduling; with `threads = 1` it
+ * is deterministic for a given seed.
+ *
+ * Reference: Blondel et al., "Fast unfolding of communities in large networks", 2008; Lu et al., "Parallel
+ * heuristics for scalable community detection", Parallel Computing 2015.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief A partition of the vertices into communities.
+     */
+    struct Communities {
+        std::vector<std::size_t> labels{};  ///< Community of every dense vertex index.
+        std::size_t count {0};              ///< Number of communities.
+        double modularity {0};              ///< Modularity of the partition, at resolution 1 for label propagation.
+    };
+
+    /**
+     * @brief Options for `label_propagation`.
+     */
+    struct LabelPropagationOptions {
+        std::size_t max_iterations {20};    ///< Sweeps over all vertices.
+        std::uint64_t seed {0x5eed};        ///< Seed of the visiting order.
+        std::size_t threads {0};            ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Options for `louvain`.
+     */
+    struct LouvainOptions {
+        double resolution {1.0};            ///< Larger values favour smaller communities.
+        std::size_t max_levels {16};        ///< Coarsening levels.
+        std::size_t max_sweeps {32};        ///< Local moving sweeps per level.
+        double tolerance {1e-7};            ///< Stop a level once a sweep improves modularity by less than this.
+        std::uint64_t seed {0x5eed};        ///< Seed of the visiting order.
+        std::size_t threads {0};            ///< Workers, 0 for one per hardware thread.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * Open addressing map from community to summed weight, cleared in time proportional to the keys it holds.
+         */
+        class WeightAccumulator {
+        private:
+            static constexpr std::size_t EMPTY {std::numeric_limits<std::size_t>::max()};
+
+            std::vector<std::size_t> table_keys{};
+            std::vector<double> table_values{};
+            std::vector<std::size_t> used{};        // occupied slots
+            std::size_t mask {0};
+
+        public:
+            void reset(const std::size_t expected_keys) {
+                for (const std::size_t slot : used) {
+                    table_keys[slot] = EMPTY;
+                }
+                used.clear();
+                const std::size_t wanted {std::bit_ceil(std::max<std::size_t>(16, 2 * expected_keys))};
+                if (wanted > table_keys.size()) {
+                    table_keys.assign(wanted, EMPTY);
+                    table_values.resize(wanted);
+                    mask = wanted - 1;
+                }
+            }
+
+            void add(const std::size_t key, const double weight) {
+                std::size_t slot {((key * 0x9e3779b97f4a7c15ULL) >> 7) & mask};
+                while (table_keys[slot] != key) {
+                    if (table_keys[slot] == EMPTY) {
+                        table_keys[slot] = key;
+                        table_values[slot] = 0;
+                        used.push_back(slot);
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                table_values[slot] += weight;
+            }
+
+            template <typename F>
+            void for_each(F&& visit) const {
+                for (const std::size_t slot : used) {
+                    visit(table_keys[slot], table_values[slot]);
+                }
+            }
+        };
+
+        /**
+         * Symmetrized weighted graph in CSR form. `degrees[i]` is the row sum, `total` the sum of all rows (2m).
+         */
+        struct CommunityGraph {
+            std::vector<std::size_t> offsets{};
+            std::vector<std::size_t> neighbours{};
+            std::vector<double> weights{};
+            std::vector<double> degrees{};
+            double total {0};
+
+            [[nodiscard]] std::size_t size() const {
+                return degrees.size();
+            }
+
+            void finish_degrees() {
+                const std::size_t n {offsets.size() - 1};
+                degrees.assign(n, 0.0);
+                total = 0;
+                for (std::size_t i {0}; i < n; ++i) {
+                    for (std::size_t k {offsets[i]}; k < offsets[i + 1]; ++k) {
+                        degrees[i] += weights[k];
+                    }
+                    total += degrees[i];
+                }
+            }
+        };
+
+        template <typename T>
+        Result<CommunityGraph, ErrorType> symmetrize(const AdjacencyMatrix<T>& matrix) {
+            const FrozenGraph& frozen {matrix.frozen_graph()};
+            const std::size_t n {frozen.vertex_count()};
+            const auto out_offsets {frozen.outgoing_offsets()};
+            const auto in_offsets {frozen.incoming_offsets()};
+            const auto row_values {matrix.row_values()};
+            const auto column_values {matrix.column_values()};
+
+            CommunityGraph graph {};
+            graph.offsets.assign(n + 1, 0);
+            graph.neighbours.reserve(2 * frozen.edge_count());
+            graph.weights.reserve(2 * frozen.edge_count());
+            for (std::size_t i {0}; i < n; ++i) {
+                auto append = [&](std::span<const std::size_t> targets, const std::size_t first_slot, std::span<const T> values) {
+                    for (std::size_t k {0}; k < targets.size(); ++k) {
+                        graph.neighbours.push_back(targets[k]);
+                        graph.weights.push_back(static_cast<double>(values[first_slot + k]));
+                    }
+                };
+                append(frozen.children(i), out_offsets[i], row_values);
+                append(frozen.parents(i), in_offsets[i], column_values);
+                graph.offsets[i + 1] = graph.neighbours.size();
+            }
+            if (std::ranges::any_of(graph.weights, [](const double w) { return !(w >= 0.0); })) {
+                return Result<CommunityGraph, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            graph.finish_degrees();
+            return Result<CommunityGraph, ErrorType>::success(std::move(graph));
+        }
+
+        /**
+         * Renumber labels to 0 .. count - 1 in order of first appearance. Returns the count.
+         */
+        inline std::size_t compact_labels(std::vector<std::size_t>& labels) {
+            std::vector<std::size_t> renumbered(labels.size(), std::numeric_limits<std::size_t>::max());
+            std::size_t count {0};
+            for (std::size_t& label : labels) {
+                if (renumbered[label] == std::numeric_limits<std::size_t>::max()) {
+                    renumbered[label] = count++;
+                }
+                label = renumbered[label];
+            }
+            return count;
+        }
+
+        inline double modularity(const CommunityGraph& graph, std::span<const std::size_t> labels, const std::size_t count, const double resolution) {
+            if (graph.total <= 0) {
+                return 0;
+            }
+            std::vector<double> internal(count, 0.0);
+            std::vector<double> totals(count, 0.0);
+            for (std::size_t i {0}; i < graph.size(); ++i) {
+                totals[labels[i]] += graph.degrees[i];
+                for (std::size_t k {graph.offsets[i]}; k < graph.offsets[i + 1]; ++k) {
+                    if (labels[graph.neighbours[k]] == labels[i]) {
+                        internal[labels[i]] += graph.weights[k];
+                    }
+                }
+            }
+            double q {0};
+            for (std::size_t c {0}; c < count; ++c) {
+                const double share {totals[c] / graph.total};
+                q += internal[c] / graph.total - resolution * share * share;
+            }
+            return q;
+        }
+
+        inline std::vector<std::size_t> shuffled_order(const std::size_t n, std::mt19937_64& random) {
+            std::vector<std::size_t> order(n);
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::ranges::shuffle(order, random);
+            return order;
+        }
+
+        /**
+         * One Louvain level: local moving on `graph`, starting from singletons. Returns the community of every vertex
+         * (not compacted) and whether any vertex moved.
+         */
+        template <typename Tracer>
+        bool louvain_local_moving(const CommunityGraph& graph, std::vector<std::size_t>& result, const LouvainOptions& options,
+                                  std::mt19937_64& random, Tracer& tracer) {
+            const std::size_t n {graph.size()};
+            std::vector<std::atomic<std::size_t>> community(n);
+            std::vector<std::atomic<double>> totals(n);
+            std::vector<std::atomic<std::size_t>> sizes(n);
+            for (std::size_t i {0}; i < n; ++i) {
+                community[i].store(i, std::memory_order_relaxed);
+                totals[i].store(graph.degrees[i], std::memory_order_relaxed);
+                sizes[i].store(1, std::memory_order_relaxed);
+            }
+            std::vector<WeightAccumulator> accumulators(worker_count(options.threads));
+            const double scale {options.resolution / graph.total};
+
+            bool moved_any {false};
+            std::vector<std::size_t> singletons(n);
+            std::iota(singletons.begin(), singletons.end(), std::size_t{0});
+            double previous {modularity(graph, singletons, n, options.resolution)};
+            for (std::size_t sweep {0}; sweep < options.max_sweeps; ++sweep) {
+                const TraceSpan span {tracer, "louvain.sweep"};
+                const std::vector<std::size_t> order {shuffled_order(n, random)};
+                std::atomic<std::size_t> moves {0};
+
+                parallel_for(n, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                    WeightAccumulator& accumulator {accumulators[worker]};
+                    std::size_t local_moves {0};
+                    for (std::size_t position {begin}; position < end; ++position) {
+                        const std::size_t v {order[position]};
+                        const std::size_t current {community[v].load(std::memory_order_relaxed)};
+                        const double degree {graph.degrees[v]};
+
+                        accumulator.reset(graph.offsets[v + 1] - graph.offsets[v]);
+                        for (std::size_t k {graph.offsets[v]}; k < graph.offsets[v + 1]; ++k) {
+                            if (graph.neighbours[k] != v) {
+                                accumulator.add(community[graph.neighbours[k]].load(std::memory_order_relaxed), graph.weights[k]);
+                            }
+                        }
+
+                        // Gain of joining community c once v has left its own: w(v, c) - scale * k_v * tot(c).
+                        const bool singleton {sizes[current].load(std::memory_order_relaxed) == 1};
+                        double current_weight {0};
+                        std::size_t best {current};
+                        double best_gain {-std::numeric_limits<double>::infinity()};
+                        accumulator.for_each([&](const std::size_t c, const double weight) {
+                            if (c == current) {
+                                current_weight = weight;
+                                return;
+                            }
+                            if (singleton && c > current && sizes[c].load(std::memory_order_relaxed) == 1) {
+                                return;
+                            }
+                            const double gain {weight - scale * degree * totals[c].load(std::memory_order_relaxed)};
+                            if (gain > best_gain || (gain == best_gain && c < best)) {
+                                best = c;
+                                best_gain = gain;
+                            }
+                        });
+                        const double stay_gain {current_weight - scale * degree * (totals[current].load(std::memory_order_relaxed) - degree)};
+
+                        if (best != current && best_gain > stay_gain) {
+                            totals[current].fetch_sub(degree, std::memory_order_relaxed);
+                            totals[best].fetch_add(degree, std::memory_order_relaxed);
+                            sizes[current].fetch_sub(1, std::memory_order_relaxed);
+                            sizes[best].fetch_add(1, std::memory_order_relaxed);
+                            community[v].store(best, std::memory_order_relaxed);
+                            ++local_moves;
+                        }
+                    }
+                    moves.fetch_add(local_moves, std::memory_order_relaxed);
+                }, options.threads);
+
+                result.resize(n);
+                for (std::size_t i {0}; i < n; ++i) {
+                    result[i] = community[i].load(std::memory_order_relaxed);
+                }
+                const std::size_t move_count {moves.load()};
+                trace_counter(tracer, "louvain.moves", static_cast<double>(move_count));
+                if (move_count == 0) {
+                    break;
+                }
+                moved_any = true;
+                std::vector<std::size_t> compact {result};
+                const double current_q {modularity(graph, compact, compact_labels(compact), options.resolution)};
+                if (current_q - previous < options.tolerance) {
+                    break;
+                }
+                previous = current_q;
+            }
+            return moved_any;
+        }
+
+        /**
+         * Collapse every community (compacted labels) into one vertex, summing the weights between communities.
+         */
+        inline CommunityGraph coarsen(const CommunityGraph& graph, std::span<const std::size_t> labels, const std::size_t count, const std::size_t threads) {
+            // Members of each community, by counting sort.
+            std::vector<std::size_t> member_offsets(count + 1, 0);
+            for (const std::size_t label : labels) {
+                ++member_offsets[label + 1];
+            }
+            std::partial_sum(member_offsets.begin(), member_offsets.end(), member_offsets.begin());
+            std::vector<std::size_t> members(labels.size());
+            {
+                std::vector<std::size_t> cursor(member_offsets.begin(), member_offsets.end() - 1);
+                for (std::size_t i {0}; i < labels.size(); ++i) {
+                    members[cursor[labels[i]]++] = i;
+                }
+            }
+
+            std::vector<std::vector<std::pair<std::size_t, double>>> rows(count);
+            std::vector<WeightAccumulator> accumulators(worker_count(threads));
+            parallel_for(count, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                WeightAccumulator& accumulator {accumulators[worker]};
+                for (std::size_t c {begin}; c < end; ++c) {
+                    std::size_t edges {0};
+                    for (std::size_t m {member_offsets[c]}; m < member_offsets[c + 1]; ++m) {
+                        edges += graph.offsets[members[m] + 1] - graph.offsets[members[m]];
+                    }
+                    accumulator.reset(edges);
+                    for (std::size_t m {member_offsets[c]}; m < member_offsets[c + 1]; ++m) {
+                        const std::size_t v {members[m]};
+                        for (std::size_t k {graph.offsets[v]}; k < graph.offsets[v + 1]; ++k) {
+                            accumulator.add(labels[graph.neighbours[k]], graph.weights[k]);
+                        }
+                    }
+                    accumulator.for_each([&](const std::size_t target, const double weight) { rows[c].emplace_back(target, weight); });
+                    std::ranges::sort(rows[c]);
+                }
+            }, threads, 64);
+
+            CommunityGraph coarse {};
+            coarse.offsets.assign(count + 1, 0);
+            for (std::size_t c {0}; c < count; ++c) {
+                coarse.offsets[c + 1] = coarse.offsets[c] + rows[c].size();
+            }
+            coarse.neighbours.reserve(coarse.offsets[count]);
+            coarse.weights.reserve(coarse.offsets[count]);
+            for (const auto& row : rows) {
+                for (const auto& [target, weight] : row) {
+                    coarse.neighbours.push_back(target);
+                    coarse.weights.push_back(weight);
+                }
+            }
+            coarse.finish_degrees();
+            return coarse;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Modularity of a partition.
+     * @param weights Edge weights.
+     * @param labels Community of every dense vertex index.
+     * @param resolution Resolution parameter.
+     * @return Result containing the modularity, or `INVALID_ARGUMENT` for a negative weight or a label count mismatch.
+     */
+    template <typename T>
+    Result<double, ErrorType> modularity(const AdjacencyMatrix<T>& weights, std::span<const std::size_t> labels, const double resolution = 1.0) {
+        if (labels.size() != weights.dimension()) {
+            return Result<double, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        auto graph = detail::symmetrize(weights);
+        if (!graph.is_ok()) {
+            return Result<double, ErrorType>::error(graph.get_error());
+        }
+        std::vector<std::size_t> compact(labels.begin(), labels.end());
+        const std::size_t count {detail::compact_labels(compact)};
+        return Result<double, ErrorType>::success(detail::modularity(graph.get_ok(), compact, count, resolution));
+    }
+
+    /**
+     * @brief Communities by asynchronous parallel label propagation.
+     *
+     * @param weights Edge weights, e.g. `AdjacencyMatrix<double>::pattern(frozen, 1.0)` for an unweighted graph.
+     * @param options Iterations, seed and workers.
+     * @param tracer Receives a `label_propagation.iteration` span and a `label_propagation.changes` counter per sweep.
+     * @return Result containing the communities, or `INVALID_ARGUMENT` for a negative weight.
+     */
+    template <typename T, typename Tracer = NoTracer>
+    Result<Communities, ErrorType> label_propagation(const AdjacencyMatrix<T>& weights, const LabelPropagationOptions& options = {},
+                                                     Tracer&& tracer = Tracer{}) {
+        auto symmetric = detail::symmetrize(weights);
+        if (!symmetric.is_ok()) {
+            return Result<Communities, ErrorType>::error(symmetric.get_error());
+        }
+        const detail::CommunityGraph& graph {symmetric.get_ok()};
+        const std::size_t n {graph.size()};
+        std::vector<std::atomic<std::size_t>> labels(n);
+        for (std::size_t i {0}; i < n; ++i) {
+            labels[i].store(i, std::memory_order_relaxed);
+        }
+        std::vector<detail::WeightAccumulator> accumulators(worker_count(options.threads));
+        std::mt19937_64 random {options.seed};
+
+        for (std::size_t iteration {0}; iteration < options.max_iterations; ++iteration) {
+            const detail::TraceSpan span {tracer, "label_propagation.iteration"};
+            const std::vector<std::size_t> order {detail::shuffled_order(n, random)};
+            std::atomic<std::size_t> changes {0};
+            parallel_for(n, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                detail::WeightAccumulator& accumulator {accumulators[worker]};
+                std::size_t local_changes {0};
+                for (std::size_t position {begin}; position < end; ++position) {
+                    const std::size_t v {order[position]};
+                    if (graph.offsets[v] == graph.offsets[v + 1]) {
+                        continue;
+                    }
+                    accumulator.reset(graph.offsets[v + 1] - graph.offsets[v]);
+                    for (std::size_t k {graph.offsets[v]}; k < graph.offsets[v + 1]; ++k) {
+                        accumulator.add(labels[graph.neighbours[k]].load(std::memory_order_relaxed), graph.weights[k]);
+                    }
+                    // Heaviest label; ties keep the current label, otherwise go to the smallest.
+                    const std::size_t current {labels[v].load(std::memory_order_relaxed)};
+                    std::size_t best {current};
+                    double best_weight {-1};
+                    accumulator.for_each([&](const std::size_t label, const double weight) {
+                        if (weight > best_weight || (weight == best_weight && best != current && (label == current || label < best))) {
+                            best = label;
+                            best_weight = weight;
+                        }
+                    });
+                    if (best != current) {
+                        labels[v].store(best, std::memory_order_relaxed);
+                        ++local_changes;
+                    }
+                }
+                changes.fetch_add(local_changes, std::memory_order_relaxed);
+            }, options.threads);
+
+            detail::trace_counter(tracer, "label_propagation.changes", static_cast<double>(changes.load()));
+            if (changes.load() == 0) {
+                break;
+            }
+        }
+
+        Communities result {};
+        result.labels.resize(n);
+        for (std::size_t i {0}; i < n; ++i) {
+            result.labels[i] = labels[i].load(std::memory_order_relaxed);
+        }
+        result.count = detail::compact_labels(result.labels);
+        result.modularity = detail::modularity(graph, result.labels, result.count, 1.0);
+        return Result<Communities, ErrorType>::success(std::move(result));
+    }
+
+    /**
+     * @brief Communities maximizing modularity, by parallel Louvain with coarsening.
+     *
+     * @param weights Edge weights, e.g. `AdjacencyMatrix<double>::pattern(frozen, 1.0)` for an unweighted graph.
+     * @param options Resolution, convergence, seed and workers.
+     * @param tracer Receives `louvain.level` and `louvain.sweep` spans, the vertices moved per sweep as `louvain.moves`
+     *        and the modularity after every level as `louvain.modularity`.
+     * @return Result containing the communities, with the modularity at `options.resolution`, or `INVALID_ARGUMENT`
+     *         for a negative weight.
+     */
+    template <typename T, typename Tracer = NoTracer>
+    Result<Communities, ErrorType> louvain(const AdjacencyMatrix<T>& weights, const LouvainOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        auto symmetric = detail::symmetrize(weights);
+        if (!symmetric.is_ok()) {
+            return Result<Communities, ErrorType>::error(symmetric.get_error());
+        }
+        const detail::CommunityGraph& original {symmetric.get_ok()};
+        Communities result {};
+        result.labels.resize(original.size());
+        std::iota(result.labels.begin(), result.labels.end(), std::size_t{0});
+        result.count = original.size();
+        if (original.total <= 0) {
+            return Result<Communities, ErrorType>::success(std::move(result));
+        }
+
+        std::mt19937_64 random {options.seed};
+        detail::CommunityGraph level_graph {};
+        const detail::CommunityGraph* current {&original};
+        std::vector<std::size_t> level_labels {};
+        for (std::size_t level {0}; level < options.max_levels; ++level) {
+            const detail::TraceSpan span {tracer, "louvain.level"};
+            if (!detail::louvain_local_moving(*current, level_labels, options, random, tracer)) {
+                break;
+            }
+            const std::size_t count {detail::compact_labels(level_labels)};
+            for (std::size_t& label : result.labels) {
+                label = level_labels[label];
+            }
+            result.count = count;
+            detail::trace_counter(tracer, "louvain.modularity", detail::modularity(original, result.labels, count, options.resolution));
+            if (count == current->size()) {
+                break;
+            }
+            level_graph = detail::coarsen(*current, level_labels, count, options.threads);
+            current = &level_graph;
+        }
+
+        result.count = detail::compact_labels(result.labels);
+        result.modularity = detail::modularity(original, result.labels, result.count, options.resolution);
+        return Result<Communities, ErrorType>::success(std::move(result));
+    }
+}
@@ -0,0 +1,376 @@
+/**
+ * @file connectivity.hpp
+ *
+ * @brief Weakly connected components maintained under streaming edge updates.
+ *
+ * @Detail
+ * Both structures here are observer policies (see `observers.hpp`): plug one into a `DirectedGraph` and it follows
+ * every mutation, answering "are `u` and `v` in the same weakly connected component" without recomputing components.
+ *
+ * - `IncrementalConnectivity` is a union-find. Inserts cost near O(1). It is meant for insert-only workloads: an edge
+ *   deletion forces a rebuild from the remaining edges on the next query.
+ * - `DynamicConnectivity` is the structure of Holm, de Lichtenberg and Thorup. Every edge has a level, and level `i`
+ *   keeps a spanning forest of the edges of level at least `i` as Euler tour trees, so the forest of level 0 spans every
+ *   component. Inserts and non-tree deletions are O(log V). Deleting a tree edge cuts it from every forest it is in and
+ *   then, from its level down, searches the smaller of the two trees for a non-tree edge that reconnects them; every
+ *   edge inspected without success moves up a level. Levels never exceed log V, so updates are O(log^2 V) amortized.
+ *
+ * Queries compare Euler tour roots, O(log V) for `DynamicConnectivity`.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/detail/euler_tour_forest.hpp"
+#include "cgrapht/models.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Union-find connectivity for insert-only edge streams. An observer policy.
+     */
+    class IncrementalConnectivity {
+    private:
+        std::unordered_map<std::size_t, std::size_t> slot_of{};
+        std::vector<std::size_t> parent{};
+        std::vector<std::size_t> size{};
+        std::vector<std::size_t> free_slots{};
+        std::unordered_map<std::size_t, std::pair<std::size_t, std::size_t>> edges{};
+        std::size_t components {0};
+        bool stale {false};
+
+        std::size_t find(std::size_t slot) {
+            while (parent[slot] != slot) {
+                parent[slot] = parent[parent[slot]];
+                slot = parent[slot];
+            }
+            return slot;
+        }
+
+        void unite(const std::size_t a, const std::size_t b) {
+            std::size_t ra {find(a)};
+            std::size_t rb {find(b)};
+            if (ra == rb) {
+                return;
+            }
+            if (size[ra] < size[rb]) {
+                std::swap(ra, rb);
+            }
+            parent[rb] = ra;
+            size[ra] += size[rb];
+            --components;
+        }
+
+        void rebuild() {
+            components = slot_of.size();
+            for (const auto& [_, slot] : slot_of) {
+                parent[slot] = slot;
+                size[slot] = 1;
+            }
+            for (const auto& [_, endpoints] : edges) {
+                unite(endpoints.first, endpoints.second);
+            }
+            stale = false;
+        }
+
+    public:
+        /**
+         * @brief Check whether two vertices are weakly connected.
+         * @return Result containing the answer or `ABSENT_VERTEX`.
+         */
+        Result<bool, ErrorType> connected(const std::size_t u_id, const std::size_t v_id) {
+            auto u = slot_of.find(u_id);
+            auto v = slot_of.find(v_id);
+            if (u == slot_of.end() || v == slot_of.end()) {
+                return Result<bool, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            if (stale) {
+                rebuild();
+            }
+            return Result<bool, ErrorType>::success(find(u->second) == find(v->second));
+        }
+
+        /**
+         * @brief Number of weakly connected components.
+         */
+        std::size_t component_count() {
+            if (stale) {
+                rebuild();
+            }
+            return components;
+        }
+
+        void on_vertex_added(const std::size_t vertex_id) {
+            std::size_t slot {parent.size()};
+            if (!free_slots.empty()) {
+                slot = free_slots.back();
+                free_slots.pop_back();
+            } else {
+                parent.push_back(0);
+                size.push_back(0);
+            }
+            parent[slot] = slot;
+            size[slot] = 1;
+            slot_of.emplace(vertex_id, slot);
+            ++components;
+        }
+
+        void on_vertex_deleted(const std::size_t vertex_id) {
+            // A deleted vertex has no edges, so in an up to date forest it is a singleton root nothing points to. In a
+            // stale forest the next rebuild recounts everything anyway.
+            free_slots.push_back(slot_of.at(vertex_id));
+            slot_of.erase(vertex_id);
+            if (!stale) {
+                --components;
+            }
+        }
+
+        void on_edge_added(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            const std::pair endpoints {slot_of.at(from_id), slot_of.at(to_id)};
+            edges.emplace(edge_id, endpoints);
+            if (!stale) {
+                unite(endpoints.first, endpoints.second);
+            }
+        }
+
+        void on_edge_deleted(const std::size_t edge_id, std::size_t, std::size_t) {
+            edges.erase(edge_id);
+            stale = true;
+        }
+    };
+
+    /**
+     * @brief Fully dynamic connectivity with polylogarithmic updates (Holm, de Lichtenberg and Thorup). An observer
+     * policy.
+     */
+    class DynamicConnectivity {
+    private:
+        using Forest = detail::EulerTourForest;
+        static constexpr std::size_t NONE {Forest::NONE};
+        // Arc of a tree edge whose level is the forest's level.
+        static constexpr Forest::Mark LEVEL_TREE_EDGE {Forest::FIRST};
+        // Vertex with non-tree edges at the forest's level.
+        static constexpr Forest::Mark LEVEL_NON_TREE_EDGES {Forest::SECOND};
+
+        struct EdgeRecord {
+            std::size_t u;
+            std::size_t v;
+            std::size_t level;
+            bool tree;
+            std::size_t position_u;         // non-tree edges: index in `non_tree[u][level]`
+            std::size_t position_v;         // non-tree edges: index in `non_tree[v][level]`
+            std::vector<std::size_t> arcs;  // tree edges: the two arc nodes in every forest up to `level`
+        };
+
+        std::unordered_map<std::size_t, std::size_t> slot_of{};
+        std::vector<std::vector<std::size_t>> tour_node{};             // per slot, per level; NONE for a lone vertex
+        std::vector<std::vector<std::vector<std::size_t>>> non_tree{}; // per slot, per level
+        std::vector<std::size_t> free_slots{};
+        std::unordered_map<std::size_t, EdgeRecord> edges{};
+        Forest forest{};
+        std::size_t components {0};
+
+        [[nodiscard]] std::size_t other(const EdgeRecord& edge, const std::size_t slot) const {
+            return edge.u == slot ? edge.v : edge.u;
+        }
+
+        std::size_t node(const std::size_t slot, const std::size_t level) {
+            auto& nodes {tour_node[slot]};
+            if (nodes.size() <= level) {
+                nodes.resize(level + 1, NONE);
+            }
+            if (nodes[level] == NONE) {
+                nodes[level] = forest.make_vertex(slot);
+            }
+            return nodes[level];
+        }
+
+        [[nodiscard]] std::size_t root(const std::size_t slot, const std::size_t level) const {
+            return forest.root(tour_node[slot][level]);
+        }
+
+        void add_non_tree(const std::size_t edge_id, EdgeRecord& edge) {
+            for (const std::size_t slot : {edge.u, edge.v}) {
+                auto& lists {non_tree[slot]};
+                if (lists.size() <= edge.level) {
+                    lists.resize(edge.level + 1);
+                }
+                (slot == edge.u ? edge.position_u : edge.position_v) = lists[edge.level].size();
+                lists[edge.level].push_back(edge_id);
+                if (lists[edge.level].size() == 1) {
+                    forest.set_mark(node(slot, edge.level), LEVEL_NON_TREE_EDGES, true);
+                }
+            }
+        }
+
+        void remove_non_tree(const EdgeRecord& edge) {
+            for (const std::size_t slot : {edge.u, edge.v}) {
+                auto& list {non_tree[slot][edge.level]};
+                const std::size_t position {slot == edge.u ? edge.position_u : edge.position_v};
+                const std::size_t moved {list.back()};
+                list[position] = moved;
+                list.pop_back();
+                if (position < list.size()) {
+                    EdgeRecord& moved_edge {edges.at(moved)};
+                    (moved_edge.u == slot ? moved_edge.position_u : moved_edge.position_v) = position;
+                }
+                if (list.empty()) {
+                    forest.set_mark(tour_node[slot][edge.level], LEVEL_NON_TREE_EDGES, false);
+                }
+            }
+        }
+
+        // Add a tree edge to the forests of levels `from` through `edge.level`.
+        void link(const std::size_t edge_id, EdgeRecord& edge, const std::size_t from) {
+            for (std::size_t level {from}; level <= edge.level; ++level) {
+                const auto [forward, backward] {forest.link(node(edge.u, level), node(edge.v, level), edge_id)};
+                edge.arcs.push_back(forward);
+                edge.arcs.push_back(backward);
+            }
+            forest.set_mark(edge.arcs[2 * edge.level], LEVEL_TREE_EDGE, true);
+        }
+
+        /**
+         * Look for a replacement of a deleted tree edge of `level` between the trees of `u` and `v` in the forest of that
+         * level. Edges of the smaller tree move up one level, which bounds levels by log V: the forest of level `i` only
+         * ever holds trees of at most V / 2^i vertices.
+         */
+        bool replace(const std::size_t u, const std::size_t v, const std::size_t level) {
+            const std::size_t root_u {root(u, level)};
+            const std::size_t root_v {root(v, level)};
+            const std::size_t smaller {forest.vertex_count(root_u) <= forest.vertex_count(root_v) ? root_u : root_v};
+
+            for (const std::size_t edge_id : forest.marked(smaller, LEVEL_TREE_EDGE)) {
+                EdgeRecord& edge {edges.at(edge_id)};
+                forest.set_mark(edge.arcs[2 * level], LEVEL_TREE_EDGE, false);
+                ++edge.level;
+                link(edge_id, edge, edge.level);
+            }
+
+            for (const std::size_t slot : forest.marked(smaller, LEVEL_NON_TREE_EDGES)) {
+                while (non_tree[slot].size() > level && !non_tree[slot][level].empty()) {
+                    const std::size_t edge_id {non_tree[slot][level].back()};
+                    EdgeRecord& edge {edges.at(edge_id)};
+                    remove_non_tree(edge);
+                    if (root(other(edge, slot), level) != smaller) {
+                        edge.tree = true;
+                        link(edge_id, edge, 0);
+                        return true;
+                    }
+                    // Both ends are inside the smaller tree; charge the scan to the edge by raising its level.
+                    ++edge.level;
+                    add_non_tree(edge_id, edge);
+                }
+            }
+            return false;
+        }
+
+    public:
+        /**
+         * @brief Check whether two vertices are weakly connected. O(log V) expected.
+         * @return Result containing the answer or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<bool, ErrorType> connected(const std::size_t u_id, const std::size_t v_id) const {
+            auto u = slot_of.find(u_id);
+            auto v = slot_of.find(v_id);
+            if (u == slot_of.end() || v == slot_of.end()) {
+                return Result<bool, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            return Result<bool, ErrorType>::success(root(u->second, 0) == root(v->second, 0));
+        }
+
+        /**
+         * @brief Number of vertices in the component of a vertex. O(log V) expected.
+         * @return Result containing the size or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> component_size(const std::size_t vertex_id) const {
+            if (auto it = slot_of.find(vertex_id); it != slot_of.end()) {
+                return Result<std::size_t, ErrorType>::success(forest.vertex_count(root(it->second, 0)));
+            }
+            return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+        }
+
+        /**
+         * @brief Number of weakly connected components.
+         */
+        [[nodiscard]] std::size_t component_count() const {
+            return components;
+        }
+
+        void on_vertex_added(const std::size_t vertex_id) {
+            std::size_t slot {tour_node.size()};
+            if (!free_slots.empty()) {
+                slot = free_slots.back();
+                free_slots.pop_back();
+            } else {
+                tour_node.emplace_back();
+                non_tree.emplace_back();
+            }
+            // Level 0 always has a node so queries never need to create one.
+            node(slot, 0);
+            slot_of.emplace(vertex_id, slot);
+            ++components;
+        }
+
+        void on_vertex_deleted(const std::size_t vertex_id) {
+            // A deleted vertex has no edges, so it is a lone vertex in every forest.
+            const std::size_t slot {slot_of.at(vertex_id)};
+            for (const std::size_t x : tour_node[slot]) {
+                if (x != NONE) {
+                    forest.release(x);
+                }
+            }
+            tour_node[slot].clear();
+            non_tree[slot].clear();
+            free_slots.push_back(slot);
+            slot_of.erase(vertex_id);
+            --components;
+        }
+
+        void on_edge_added(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            const std::size_t u {slot_of.at(from_id)};
+            const std::size_t v {slot_of.at(to_id)};
+            EdgeRecord& edge {edges.emplace(edge_id, EdgeRecord{u, v, 0, false, 0, 0, {}}).first->second};
+            if (u == v) {
+                // Self loops never matter for connectivity and are not indexed.
+                return;
+            }
+            if (root(u, 0) == root(v, 0)) {
+                add_non_tree(edge_id, edge);
+                return;
+            }
+            edge.tree = true;
+            link(edge_id, edge, 0);
+            --components;
+        }
+
+        void on_edge_deleted(const std::size_t edge_id, std::size_t, std::size_t) {
+            const auto it {edges.find(edge_id)};
+            EdgeRecord edge {std::move(it->second)};
+            edges.erase(it);
+            if (edge.u == edge.v) {
+                return;
+            }
+            if (!edge.tree) {
+                remove_non_tree(edge);
+                return;
+            }
+
+            for (std::size_t level {0}; level <= edge.level; ++level) {
+                forest.cut(edge.arcs[2 * level], edge.arcs[2 * level + 1]);
+            }
+            for (std::size_t level {edge.level + 1}; level-- > 0;) {
+                if (replace(edge.u, edge.v, level)) {
+                    return;
+                }
+            }
+            ++components;
+        }
+    };
+}
@@ -0,0 +1,606 @@
+/**
+ * @file contraction_hierarchy.hpp
+ *
+ * @brief Contraction hierarchies for fast point-to-point shortest path queries.
+ *
+ * @Detail
+ * A `ContractionHierarchy` is built once from non negative edge weights, after which shortest path queries touch only
+ * a few hundred vertices even on continental road networks.
+ *
+ * Preprocessing contracts the vertices one by one, from least to most important. Contracting `u` removes it and adds a
+ * shortcut `x -> y` for every pair of neighbours `x -> u -> y` unless a witness search (a Dijkstra from `x` that avoids
+ * `u`, bounded by the shortcut length and a settle limit) finds a path that is at most as short. The importance of a
+ * vertex is twice its edge difference (shortcuts added minus edges removed) plus the number of its already contracted
+ * neighbours and its depth in the hierarchy so far, which spreads contraction evenly. Importance is only estimated, with
+ * witness searches of a few hops and a few settled vertices. Every round contracts in parallel an independent set of
+ * vertices whose importance is a local minimum among their neighbours; the full witness searches of the contraction
+ * re-evaluate it, and a vertex that is no longer a local minimum waits for a later round. The round then re-estimates
+ * the importance of the neighbours of the contracted vertices in parallel, and only those vertices and their neighbours
+ * are checked for local minima in the next round. Vertices contracted in the same round are not adjacent, and witness
+ * searches avoid all of them.
+ *
+ * The result is two compact CSR arrays: the upward graph (edges from a vertex to later contracted ones) and the
+ * downward graph (edges into a vertex from later contracted ones, stored reversed). A query runs Dijkstra upward from
+ * the source and, reversed, from the target, skipping vertices that are provably reached more cheaply from above
+ * (stall on demand), and stops as soon as neither search can improve the best meeting point.
+ * Shortcuts remember the vertex they bypass, so paths are unpacked into original edges.
+ *
+ * ```cpp
+ * auto weights = AdjacencyMatrix<double>::weighted(frozen, city_graph, [](const Road& r) { return r.distance_km; }).consume_ok();
+ * auto hierarchy = ContractionHierarchy<double>::build(weights).consume_ok();
+ * double km = hierarchy.distance(seattle, portland).get_ok();
+ * ```
+ *
+ * Reference: Geisberger, Sanders, Schultes and Delling, "Contraction Hierarchies: Faster and Simpler Hierarchical
+ * Routing in Road Networks", 2008; Vetter, "Parallel Time-Dependent Contraction Hierarchies", 2009.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/detail/epoch_stamps.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Options for `ContractionHierarchy::build`.
+     */
+    struct ContractionOptions {
+        std::size_t witness_settle_limit {500};    ///< Vertices a witness search may settle before giving up.
+        std::size_t priority_settle_limit {20};    ///< Vertices a witness search may settle when only estimating importance.
+        std::size_t priority_hop_limit {3};        ///< Arcs a witness search may follow when only estimating importance.
+        std::size_t threads {0};                   ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Contraction hierarchy over the dense indices of a frozen graph.
+     *
+     * Queries are thread safe. The hierarchy refers to the frozen graph, which must outlive it.
+     *
+     * @tparam T Weight type.
+     */
+    template <typename T>
+    class ContractionHierarchy {
+    public:
+        /**
+         * @brief Marks an arc that is an original edge rather than a shortcut.
+         */
+        static constexpr std::size_t NO_MIDDLE {std::numeric_limits<std::size_t>::max()};
+
+        /**
+         * @brief Arc of the upward or downward graph.
+         */
+        struct Arc {
+            std::size_t target;     ///< Dense index of the later contracted endpoint.
+            T weight;
+            std::size_t middle;     ///< Dense index of the bypassed vertex, or `NO_MIDDLE`.
+        };
+
+    private:
+        struct Shortcut {
+            std::size_t from;
+            std::size_t to;
+            T weight;
+        };
+
+        // Dijkstra scratch space, one per thread.
+        struct Search {
+            detail::EpochStamps reached{};
+            std::vector<T> distance{};
+            std::vector<std::size_t> parent{};      // previous vertex of the search
+            std::vector<std::size_t> parent_arc{};  // arc used to reach the vertex
+            std::vector<std::size_t> hops{};        // witness searches: arcs on the path to the vertex
+            detail::EpochStamps targets{};          // witness searches: out-neighbours of the contracted vertex
+            std::vector<std::pair<T, std::size_t>> heap{};
+
+            void begin(const std::size_t n) {
+                reached.begin(n);
+                if (distance.size() < n) {
+                    distance.resize(n);
+                    parent.resize(n);
+                    parent_arc.resize(n);
+                    hops.resize(n);
+                }
+                heap.clear();
+            }
+
+            [[nodiscard]] T at(const std::size_t v) const {
+                return reached.visited(v) ? distance[v] : MinPlus<T>::zero();
+            }
+
+            bool improve(const std::size_t v, const T d, const std::size_t from, const std::size_t arc) {
+                if (reached.visited(v) && distance[v] <= d) {
+                    return false;
+                }
+                reached.visit(v);
+                distance[v] = d;
+                parent[v] = from;
+                parent_arc[v] = arc;
+                heap.emplace_back(d, v);
+                std::ranges::push_heap(heap, std::greater<>{});
+                return true;
+            }
+
+            // `improve` without the parent pointers, which witness searches never read.
+            bool relax(const std::size_t v, const T d) {
+                if (reached.visited(v) && distance[v] <= d) {
+                    return false;
+                }
+                reached.visit(v);
+                distance[v] = d;
+                heap.emplace_back(d, v);
+                std::ranges::push_heap(heap, std::greater<>{});
+                return true;
+            }
+
+            std::pair<T, std::size_t> pop() {
+                std::ranges::pop_heap(heap, std::greater<>{});
+                const auto top {heap.back()};
+                heap.pop_back();
+                return top;
+            }
+        };
+
+        const FrozenGraph* graph;
+        std::vector<std::size_t> rank{};
+        std::vector<std::size_t> up_offsets{};
+        std::vector<Arc> up_arcs{};
+        std::vector<std::size_t> down_offsets{};
+        std::vector<Arc> down_arcs{};
+        std::size_t shortcuts {0};
+
+        explicit ContractionHierarchy(const FrozenGraph& graph) : graph{&graph} {}
+
+        static void upsert(std::vector<Arc>& arcs, const std::size_t target, const T weight, const std::size_t middle) {
+            for (Arc& arc : arcs) {
+                if (arc.target == target) {
+                    if (weight < arc.weight) {
+                        arc.weight = weight;
+                        arc.middle = middle;
+                    }
+                    return;
+                }
+            }
+            arcs.push_back(Arc{target, weight, middle});
+        }
+
+        static void erase(std::vector<Arc>& arcs, const std::size_t target) {
+            std::erase_if(arcs, [target](const Arc& arc) { return arc.target == target; });
+        }
+
+        /**
+         * Shortcuts needed to contract `u` in the overlay graph. Witness searches skip `u` and every vertex marked in
+         * `skip`, and do not extend paths of `hop_limit` arcs. Tighter limits find fewer witnesses, so they can only
+         * overestimate the shortcuts.
+         */
+        static void simulate(const std::size_t u, const std::vector<std::vector<Arc>>& out, const std::vector<std::vector<Arc>>& in,
+                             const std::vector<std::uint8_t>& skip, const std::size_t settle_limit, const std::size_t hop_limit,
+                             Search& search, std::vector<Shortcut>& found) {
+            found.clear();
+            if (out[u].empty() || in[u].empty()) {
+                return;
+            }
+            T longest_out {out[u].front().weight};
+            for (const Arc& arc : out[u]) {
+                longest_out = std::max(longest_out, arc.weight);
+            }
+            const std::size_t n {out.size()};
+            search.targets.begin(n);
+            for (const Arc& arc : out[u]) {
+                search.targets.visit(arc.target);
+            }
+            for (const Arc& incoming : in[u]) {
+                const std::size_t x {incoming.target};
+                const T limit {incoming.weight + longest_out};
+                search.begin(n);
+                search.relax(x, T{0});
+                search.hops[x] = 0;
+                // Stop once every out-neighbour of u is settled: their distances are final.
+                std::size_t unsettled {out[u].size()};
+                for (std::size_t settled {0}; !search.heap.empty() && settled < settle_limit && unsettled != 0;) {
+                    const auto [d, v] = search.pop();
+                    if (d > search.distance[v]) {
+                        continue;
+                    }
+                    if (d > limit) {
+                        break;
+                    }
+                    ++settled;
+                    unsettled -= search.targets.visited(v) ? 1 : 0;
+                    if (search.hops[v] == hop_limit) {
+                        continue;
+                    }
+                    for (const Arc& arc : out[v]) {
+                        if (arc.target != u && !skip[arc.target] && d + arc.weight <= limit && search.relax(arc.target, d + arc.weight)) {
+                            search.hops[arc.target] = search.hops[v] + 1;
+                        }
+                    }
+                }
+                for (const Arc& outgoing : out[u]) {
+                    const std::size_t y {outgoing.target};
+                    const T via {incoming.weight + outgoing.weight};
+                    if (y != x && search.at(y) > via) {
+                        found.push_back(Shortcut{x, y, via});
+                    }
+                }
+            }
+        }
+
+        // Arc stored at `at` with the given target.
+        static const Arc& find_arc(std::span<const std::size_t> offsets, const std::vector<Arc>& arcs, const std::size_t at, const std::size_t target) {
+            const Arc* best {nullptr};
+            for (std::size_t i {offsets[at]}; i < offsets[at + 1]; ++i) {
+                if (arcs[i].target == target && (best == nullptr || arcs[i].weight < best->weight)) {
+                    best = &arcs[i];
+                }
+            }
+            return *best;
+        }
+
+        // Append the vertices after `from` on the original path of edge from -> to (bypassing `middle`).
+        void unpack(const std::size_t from, const std::size_t to, const std::size_t middle, std::vector<std::size_t>& out) const {
+            struct Pending {
+                std::size_t from;
+                std::size_t to;
+                std::size_t middle;
+            };
+            std::vector<Pending> stack {{from, to, middle}};
+            while (!stack.empty()) {
+                const Pending edge {stack.back()};
+                stack.pop_back();
+                if (edge.middle == NO_MIDDLE) {
+                    out.push_back(edge.to);
+                    continue;
+                }
+                // The bypassed vertex is contracted before both endpoints.
+                const Arc& second {find_arc(up_offsets, up_arcs, edge.middle, edge.to)};
+                const Arc& first {find_arc(down_offsets, down_arcs, edge.middle, edge.from)};
+                stack.push_back(Pending{edge.middle, edge.to, second.middle});
+                stack.push_back(Pending{edge.from, edge.middle, first.middle});
+            }
+        }
+
+        /**
+         * Bidirectional upward search. Returns the best distance and the meeting vertex (`NO_MIDDLE` if none).
+         */
+        std::pair<T, std::size_t> search(const std::size_t source, const std::size_t target, Search& forward, Search& backward) const {
+            const std::size_t n {rank.size()};
+            forward.begin(n);
+            backward.begin(n);
+            forward.improve(source, T{0}, source, 0);
+            backward.improve(target, T{0}, target, 0);
+            T best {MinPlus<T>::zero()};
+            std::size_t meeting {NO_MIDDLE};
+            while (!forward.heap.empty() || !backward.heap.empty()) {
+                const bool go_forward {backward.heap.empty() || (!forward.heap.empty() && forward.heap.front().first <= backward.heap.front().first)};
+                Search& side {go_forward ? forward : backward};
+                const Search& other {go_forward ? backward : forward};
+                if (!(side.heap.front().first < best)) {
+                    break;
+                }
+                const auto [d, v] = side.pop();
+                if (d > side.distance[v]) {
+                    continue;
+                }
+                if (other.reached.visited(v) && d + other.distance[v] < best) {
+                    best = d + other.distance[v];
+                    meeting = v;
+                }
+                // Stall on demand: if a higher vertex already reached reaches v more cheaply through an arc pointing
+                // the other way, no shortest path continues from v.
+                const auto& reverse_offsets {go_forward ? down_offsets : up_offsets};
+                const auto& reverse_arcs {go_forward ? down_arcs : up_arcs};
+                bool stalled {false};
+                for (std::size_t i {reverse_offsets[v]}; i < reverse_offsets[v + 1] && !stalled; ++i) {
+                    stalled = side.reached.visited(reverse_arcs[i].target) && side.distance[reverse_arcs[i].target] + reverse_arcs[i].weight < d;
+                }
+                if (stalled) {
+                    continue;
+                }
+                const auto& offsets {go_forward ? up_offsets : down_offsets};
+                const auto& arcs {go_forward ? up_arcs : down_arcs};
+                for (std::size_t i {offsets[v]}; i < offsets[v + 1]; ++i) {
+                    side.improve(arcs[i].target, d + arcs[i].weight, v, i);
+                }
+            }
+            return {best, meeting};
+        }
+
+        static Search& workspace(const bool forward) {
+            thread_local Search searches[2] {};
+            return searches[forward ? 0 : 1];
+        }
+
+    public:
+        /**
+         * @brief Contract all vertices.
+         *
+         * Parallel edges keep the lightest one and self loops are dropped.
+         *
+         * @param weights Non negative edge weights, e.g. from `AdjacencyMatrix<T>::weighted`.
+         * @param options Witness search limit and workers.
+         * @param tracer Receives a `contraction_hierarchy.round` span and a `contraction_hierarchy.remaining` counter
+         *        per round. See `tracing.hpp`.
+         * @return Result containing the hierarchy, or `INVALID_ARGUMENT` if a weight is negative.
+         */
+        template <typename Tracer = NoTracer>
+        static Result<ContractionHierarchy, ErrorType> build(const AdjacencyMatrix<T>& weights, const ContractionOptions& options = {}, Tracer&& tracer = Tracer{}) {
+            const FrozenGraph& frozen {weights.frozen_graph()};
+            const std::size_t n {frozen.vertex_count()};
+            const auto offsets {frozen.outgoing_offsets()};
+            const auto targets {frozen.outgoing_targets()};
+            const auto values {weights.row_values()};
+            if (std::ranges::any_of(values, [](const T weight) { return weight < T{0}; })) {
+                return Result<ContractionHierarchy, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+
+            // Overlay graph of the vertices not contracted yet. `in` arcs point at the source.
+            std::vector<std::vector<Arc>> out(n);
+            std::vector<std::vector<Arc>> in(n);
+            for (std::size_t u {0}; u < n; ++u) {
+                for (std::size_t slot {offsets[u]}; slot < offsets[u + 1]; ++slot) {
+                    if (targets[slot] != u) {
+                        upsert(out[u], targets[slot], values[slot], NO_MIDDLE);
+                        upsert(in[targets[slot]], u, values[slot], NO_MIDDLE);
+                    }
+                }
+            }
+
+            constexpr std::size_t NO_HOP_LIMIT {std::numeric_limits<std::size_t>::max()};
+            ContractionHierarchy hierarchy {frozen};
+            hierarchy.rank.assign(n, 0);
+            std::vector<std::vector<Arc>> up(n);
+            std::vector<std::vector<Arc>> down(n);
+            std::vector<std::uint8_t> contracted(n, 0);
+            std::vector<std::uint8_t> in_batch(n, 0);
+            std::vector<std::size_t> contracted_neighbours(n, 0);
+            std::vector<std::size_t> level(n, 0);
+            std::vector<long long> priority(n, 0);
+            const std::size_t workers {worker_count(options.threads)};
+            std::vector<Search> searches(workers);
+            std::vector<std::vector<Shortcut>> scratch(workers);
+
+            auto importance = [&](const std::size_t u, const std::size_t shortcut_count) {
+                return 2 * (static_cast<long long>(shortcut_count) - static_cast<long long>(out[u].size() + in[u].size())) +
+                       static_cast<long long>(contracted_neighbours[u]) + static_cast<long long>(level[u]);
+            };
+            // Importance is only estimated, with hop limited witness searches; contraction re-evaluates it exactly.
+            auto update_priorities = [&](std::span<const std::size_t> vertices) {
+                parallel_for(vertices.size(), [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                    for (std::size_t i {begin}; i < end; ++i) {
+                        const std::size_t u {vertices[i]};
+                        simulate(u, out, in, in_batch, options.priority_settle_limit, options.priority_hop_limit, searches[worker], scratch[worker]);
+                        priority[u] = importance(u, scratch[worker].size());
+                    }
+                }, options.threads, 16);
+            };
+            auto key_less = [&](const std::size_t a, const std::size_t b) {
+                return priority[a] < priority[b] || (priority[a] == priority[b] && a < b);
+            };
+            auto minimal = [&](const std::size_t u) {
+                return std::ranges::all_of(out[u], [&](const Arc& arc) { return key_less(u, arc.target); }) &&
+                       std::ranges::all_of(in[u], [&](const Arc& arc) { return key_less(u, arc.target); });
+            };
+
+            // Vertices that may have become local minima: only a change to a vertex's key or to its neighbourhood can
+            // make it one, so each round rechecks the vertices it touched and their neighbours.
+            std::vector<std::size_t> candidates(n);
+            for (std::size_t u {0}; u < n; ++u) {
+                candidates[u] = u;
+            }
+            update_priorities(candidates);
+
+            std::size_t next_rank {0};
+            std::vector<std::size_t> batch {};
+            std::vector<std::vector<Shortcut>> batch_shortcuts {};
+            std::vector<std::size_t> deferred {};
+            std::vector<std::size_t> touched {};
+            detail::EpochStamps touched_stamps {};
+            detail::EpochStamps candidate_stamps {};
+            while (next_rank < n) {
+                const detail::TraceSpan span {tracer, "contraction_hierarchy.round"};
+                detail::trace_counter(tracer, "contraction_hierarchy.remaining", static_cast<double>(n - next_rank));
+
+                // Independent set of local minima.
+                batch.clear();
+                for (const std::size_t u : candidates) {
+                    if (minimal(u)) {
+                        batch.push_back(u);
+                        in_batch[u] = 1;
+                    }
+                }
+
+                batch_shortcuts.resize(batch.size());
+                parallel_for(batch.size(), [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                    for (std::size_t i {begin}; i < end; ++i) {
+                        simulate(batch[i], out, in, in_batch, options.witness_settle_limit, NO_HOP_LIMIT, searches[worker], batch_shortcuts[i]);
+                    }
+                }, options.threads, 4);
+
+                // Lazy re-evaluation: with exact shortcut counts, a vertex that is no longer a local minimum waits. Batch
+                // vertices are not adjacent, so this does not change whether the others are minimal. The kept vertices'
+                // witness searches also avoided the deferred ones, which can only add shortcuts.
+                deferred.clear();
+                std::size_t kept {0};
+                for (std::size_t i {0}; i < batch.size(); ++i) {
+                    const std::size_t u {batch[i]};
+                    priority[u] = importance(u, batch_shortcuts[i].size());
+                    if (!minimal(u)) {
+                        deferred.push_back(u);
+                        in_batch[u] = 0;
+                        continue;
+                    }
+                    batch[kept] = u;
+                    std::swap(batch_shortcuts[kept], batch_shortcuts[i]);
+                    ++kept;
+                }
+                batch.resize(kept);
+
+                touched.clear();
+                touched_stamps.begin(n);
+                for (std::size_t i {0}; i < batch.size(); ++i) {
+                    const std::size_t u {batch[i]};
+                    hierarchy.rank[u] = next_rank++;
+                    up[u] = std::move(out[u]);
+                    down[u] = std::move(in[u]);
+                    for (const Arc& arc : up[u]) {
+                        erase(in[arc.target], u);
+                    }
+                    for (const Arc& arc : down[u]) {
+                        erase(out[arc.target], u);
+                    }
+                    for (const auto* arcs : {&up[u], &down[u]}) {
+                        for (const Arc& arc : *arcs) {
+                            ++contracted_neighbours[arc.target];
+                            level[arc.target] = std::max(level[arc.target], level[u] + 1);
+                            if (!touched_stamps.visited(arc.target)) {
+                                touched_stamps.visit(arc.target);
+                                touched.push_back(arc.target);
+                            }
+                        }
+                    }
+                    for (const Shortcut& shortcut : batch_shortcuts[i]) {
+                        upsert(out[shortcut.from], shortcut.to, shortcut.weight, u);
+                        upsert(in[shortcut.to], shortcut.from, shortcut.weight, u);
+                    }
+                    hierarchy.shortcuts += batch_shortcuts[i].size();
+                    out[u].clear();
+                    in[u].clear();
+                    contracted[u] = 1;
+                    in_batch[u] = 0;
+                }
+                update_priorities(touched);
+
+                candidates.clear();
+                candidate_stamps.begin(n);
+                auto add_candidate = [&](const std::size_t v) {
+                    if (contracted[v] == 0 && !candidate_stamps.visited(v)) {
+                        candidate_stamps.visit(v);
+                        candidates.push_back(v);
+                    }
+                };
+                for (const auto* changed : {&touched, &deferred}) {
+                    for (const std::size_t v : *changed) {
+                        add_candidate(v);
+                        for (const auto* arcs : {&out[v], &in[v]}) {
+                            for (const Arc& arc : *arcs) {
+                                add_candidate(arc.target);
+                            }
+                        }
+                    }
+                }
+                std::ranges::sort(candidates);
+            }
+
+            // Flatten into CSR.
+            for (const bool upward : {true, false}) {
+                const auto& lists {upward ? up : down};
+                auto& offsets_out {upward ? hierarchy.up_offsets : hierarchy.down_offsets};
+                auto& arcs_out {upward ? hierarchy.up_arcs : hierarchy.down_arcs};
+                offsets_out.assign(n + 1, 0);
+                for (std::size_t u {0}; u < n; ++u) {
+                    offsets_out[u + 1] = offsets_out[u] + lists[u].size();
+                }
+                arcs_out.reserve(offsets_out[n]);
+                for (const auto& list : lists) {
+                    arcs_out.insert(arcs_out.end(), list.begin(), list.end());
+                }
+            }
+            return Result<ContractionHierarchy, ErrorType>::success(std::move(hierarchy));
+        }
+
+        /**
+         * @brief Shortest path distance between two vertices.
+         * @param from_id Source vertex id.
+         * @param to_id Target vertex id.
+         * @return Result containing the distance (`MinPlus<T>::zero()` if unreachable), or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<T, ErrorType> distance(const std::size_t from_id, const std::size_t to_id) const {
+            auto from = graph->index_of(from_id);
+            auto to = graph->index_of(to_id);
+            if (!from.is_ok() || !to.is_ok()) {
+                return Result<T, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            return Result<T, ErrorType>::success(search(from.get_ok(), to.get_ok(), workspace(true), workspace(false)).first);
+        }
+
+        /**
+         * @brief Shortest path between two vertices, unpacked into original edges.
+         * @param from_id Source vertex id.
+         * @param to_id Target vertex id.
+         * @return Result containing the vertex ids from `from_id` to `to_id` (empty if unreachable), or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<std::vector<std::size_t>, ErrorType> shortest_path(const std::size_t from_id, const std::size_t to_id) const {
+            auto from = graph->index_of(from_id);
+            auto to = graph->index_of(to_id);
+            if (!from.is_ok() || !to.is_ok()) {
+                return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            Search& forward {workspace(true)};
+            Search& backward {workspace(false)};
+            const std::size_t meeting {search(from.get_ok(), to.get_ok(), forward, backward).second};
+            std::vector<std::size_t> path {};
+            if (meeting == NO_MIDDLE) {
+                return Result<std::vector<std::size_t>, ErrorType>::success(std::move(path));
+            }
+
+            // Upward arcs from the source to the meeting vertex, then downward arcs to the target.
+            std::vector<std::size_t> climb {};
+            for (std::size_t v {meeting}; v != from.get_ok(); v = forward.parent[v]) {
+                climb.push_back(v);
+            }
+            std::vector<std::size_t> dense {from.get_ok()};
+            for (std::size_t previous {from.get_ok()}; !climb.empty(); climb.pop_back()) {
+                const std::size_t v {climb.back()};
+                unpack(previous, v, up_arcs[forward.parent_arc[v]].middle, dense);
+                previous = v;
+            }
+            for (std::size_t v {meeting}; v != to.get_ok(); v = backward.parent[v]) {
+                unpack(v, backward.parent[v], down_arcs[backward.parent_arc[v]].middle, dense);
+            }
+            for (const std::size_t index : dense) {
+                path.push_back(graph->vertex_id(index));
+            }
+            return Result<std::vector<std::size_t>, ErrorType>::success(std::move(path));
+        }
+
+        /**
+         * @brief The frozen graph the hierarchy was built on.
+         */
+        [[nodiscard]] const FrozenGraph& frozen_graph() const {
+            return *graph;
+        }
+
+        /**
+         * @brief Contraction order of every dense index: 0 was contracted first.
+         */
+        [[nodiscard]] std::span<const std::size_t> get_ranks() const {
+            return rank;
+        }
+
+        /**
+         * @brief Number of shortcuts added during preprocessing.
+         */
+        [[nodiscard]] std::size_t shortcut_count() const {
+            return shortcuts;
+        }
+
+        /**
+         * @brief Bytes held by the upward and downward graphs.
+         */
+        [[nodiscard]] std::size_t memory_bytes() const {
+            return (up_arcs.size() + down_arcs.size()) * sizeof(Arc) + (up_offsets.size() + down_offsets.size() + rank.size()) * sizeof(std::size_t);
+        }
+    };
+}
@@ -0,0 +1,286 @@
+/**
+ * @file cycles.hpp
+ *
+ * @brief Enumerate the elementary cycles of a directed graph, optionally up to a length bound.
+ *
+ * @Detail
+ * `enumerate_cycles` reports every elementary cycle (no repeated vertex) of a `FrozenGraph` exactly once, rotated so
+ * that it starts at its vertex of smallest dense index. Parallel edges are collapsed, so a cycle is a sequence of
+ * vertices; a self loop is a cycle of length 1.
+ *
+ * The search is split by that smallest vertex `s`: cycles through `s` only use vertices above `s`, and every start is
+ * independent, so starts are spread across workers with per worker state in dense arrays. For each start, a reverse
+ * BFS from `s` over vertices above `s` finds which vertices can return to `s` and in how many edges; the forward
+ * search never leaves that set, which plays the role of the strongly connected component in Johnson's algorithm.
+ *
+ * - Without a bound, the forward search is Johnson's circuit search: a vertex stays blocked after a fruitless visit
+ *   until a cycle is found through one of its successors, which is tracked in per vertex blocked lists. Work is
+ *   O((n + m)(c + 1)) per start for c cycles.
+ * - With `max_length`, a plain block is too strong, since a vertex that failed on a long path may succeed on a shorter
+ *   one. Gupta and Suzumura's lock levels replace it: entering a vertex with a path of `l` edges locks it at `l`, so
+ *   only shorter paths may enter it again. When the search leaves a vertex after finding a cycle `b` edges below it,
+ *   its lock is raised to `max_length - b + 1`, and every lock that rises is passed on through the blocked lists, one
+ *   edge less per step. Unlike in the paper, a vertex joins the blocked lists of its successors whenever it is left,
+ *   not only after a fruitless visit: a successor that was on the path may later offer a shorter way back than the
+ *   cycle that was found. Each list holds a vertex once, so lists stay within the in-degree. A path of length `l` is
+ *   also only extended to `w` while `l + 1 + distance(w, s) <= max_length`. The paper bounds the work of its search
+ *   by O(max_length (n + m)(c + 1)) per start for c cycles; a plain DFS over simple paths can instead spend
+ *   exponential time on paths that never close.
+ *
+ * Cycles are handed to a callback as soon as they are found and never collected.
+ *
+ * Reference: Johnson, "Finding all the elementary circuits of a directed graph", SIAM J. Comput. 1975; Gupta and
+ * Suzumura, "Finding All Bounded-Length Simple Cycles in a Directed Graph", 2021.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/detail/epoch_stamps.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Options for `enumerate_cycles`.
+     */
+    struct CycleOptions {
+        std::size_t max_length {0};     ///< Longest cycle to report, in edges, 0 for no bound.
+        std::size_t threads {0};        ///< Workers, 0 for one per hardware thread.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * Per worker search state over dense indices. Only vertices reached by the reverse BFS of the current start are
+         * ever touched, and they are reset after the start is done.
+         */
+        struct CycleState {
+            static constexpr std::size_t NO_CYCLE {std::numeric_limits<std::size_t>::max()};
+
+            struct Frame {
+                std::size_t vertex;
+                std::size_t cursor;
+                std::size_t back;   // edges of the shortest way back to the start found so far, or NO_CYCLE
+            };
+
+            EpochStamps reached{};
+            std::vector<std::size_t> distance{};                // edges back to the start, valid where reached
+            std::vector<std::size_t> queue{};                   // reverse BFS order, i.e. every reached vertex
+            std::vector<std::uint8_t> blocked{};                // Johnson: blocked; bounded: on the path
+            std::vector<std::size_t> lock{};                    // bounded: only paths shorter than this may enter
+            std::vector<std::vector<std::size_t>> blocked_by{}; // unblock or relax these with the vertex
+            std::vector<std::uint8_t> listed{};                 // bounded: by edge slot, the source is in blocked_by
+            std::vector<std::size_t> unblocking{};
+            std::vector<std::pair<std::size_t, std::size_t>> relaxing{};
+            std::vector<Frame> frames{};
+            std::vector<std::size_t> cycle_ids{};
+
+            void prepare(const FrozenGraph& graph) {
+                if (distance.size() != graph.vertex_count()) {
+                    distance.assign(graph.vertex_count(), 0);
+                    blocked.assign(graph.vertex_count(), 0);
+                    lock.assign(graph.vertex_count(), NO_CYCLE);
+                    blocked_by.assign(graph.vertex_count(), {});
+                    listed.assign(graph.edge_count(), 0);
+                }
+            }
+
+            /**
+             * Reverse BFS from `start` over vertices above it, up to `depth` edges.
+             */
+            void reach(const FrozenGraph& graph, const std::size_t start, const std::size_t depth) {
+                reached.begin(graph.vertex_count());
+                reached.visit(start);
+                distance[start] = 0;
+                queue.assign(1, start);
+                for (std::size_t head {0}; head < queue.size(); ++head) {
+                    const std::size_t v {queue[head]};
+                    if (distance[v] + 1 > depth) {
+                        continue;
+                    }
+                    for (const std::size_t u : graph.parents(v)) {
+                        if (u > start && !reached.visited(u)) {
+                            reached.visit(u);
+                            distance[u] = distance[v] + 1;
+                            queue.push_back(u);
+                        }
+                    }
+                }
+            }
+
+            void unblock(const std::size_t vertex) {
+                unblocking.assign(1, vertex);
+                while (!unblocking.empty()) {
+                    const std::size_t v {unblocking.back()};
+                    unblocking.pop_back();
+                    if (!blocked[v]) {
+                        continue;
+                    }
+                    blocked[v] = 0;
+                    for (const std::size_t w : blocked_by[v]) {
+                        if (blocked[w]) {
+                            unblocking.push_back(w);
+                        }
+                    }
+                    blocked_by[v].clear();
+                }
+            }
+
+            /**
+             * Bounded search leaving `vertex` with lock `level`: every vertex that failed through it may now be entered
+             * by paths one edge shorter, and so on backwards.
+             */
+            void release(const std::size_t vertex, const std::size_t level) {
+                lock[vertex] = level;
+                relaxing.clear();
+                for (const std::size_t w : blocked_by[vertex]) {
+                    relaxing.emplace_back(w, level - 1);
+                }
+                while (!relaxing.empty()) {
+                    const auto [v, l] {relaxing.back()};
+                    relaxing.pop_back();
+                    if (lock[v] >= l) {
+                        continue;
+                    }
+                    lock[v] = l;
+                    for (const std::size_t w : blocked_by[v]) {
+                        relaxing.emplace_back(w, l - 1);
+                    }
+                }
+            }
+
+            void reset(const FrozenGraph& graph) {
+                for (const std::size_t v : queue) {
+                    blocked[v] = 0;
+                    lock[v] = NO_CYCLE;
+                    blocked_by[v].clear();
+                    std::fill(listed.begin() + static_cast<std::ptrdiff_t>(graph.outgoing_offsets()[v]),
+                              listed.begin() + static_cast<std::ptrdiff_t>(graph.outgoing_offsets()[v + 1]), 0);
+                }
+            }
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Stream every elementary cycle of the graph to a callback.
+     *
+     * @param graph Frozen graph to search.
+     * @param on_cycle Called as `on_cycle(std::span<const std::size_t> vertex_ids)` once per cycle, with the vertex
+     *        ids in edge order starting at the vertex of smallest dense index. The span is only valid during the call.
+     *        With several workers it is called concurrently and must be thread safe. It may return `bool`; returning
+     *        false stops the search as soon as possible.
+     * @param options Length bound and workers.
+     * @param tracer Receives a `cycles.enumerate` span and a final `cycles.found` counter. See `tracing.hpp`.
+     * @return The number of cycles reported.
+     */
+    template <typename OnCycle, typename Tracer = NoTracer>
+    std::size_t enumerate_cycles(const FrozenGraph& graph, OnCycle&& on_cycle, const CycleOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        const detail::TraceSpan span {tracer, "cycles.enumerate"};
+        const std::size_t n {graph.vertex_count()};
+        const bool bounded {options.max_length != 0};
+        const std::size_t depth {bounded ? options.max_length - 1 : std::numeric_limits<std::size_t>::max()};
+        std::atomic<std::size_t> cycles {0};
+        std::atomic<bool> stopped {false};
+        std::vector<detail::CycleState> states(worker_count(options.threads));
+
+        // Reports the cycle closed by the current frames and returns whether to stop.
+        auto report = [&](detail::CycleState& state) {
+            state.cycle_ids.clear();
+            for (const auto& frame : state.frames) {
+                state.cycle_ids.push_back(graph.vertex_id(frame.vertex));
+            }
+            cycles.fetch_add(1, std::memory_order_relaxed);
+            if constexpr (std::is_same_v<std::invoke_result_t<OnCycle&, std::span<const std::size_t>>, bool>) {
+                if (!on_cycle(std::span<const std::size_t>{state.cycle_ids})) {
+                    stopped.store(true, std::memory_order_relaxed);
+                }
+            } else {
+                on_cycle(std::span<const std::size_t>{state.cycle_ids});
+            }
+            return stopped.load(std::memory_order_relaxed);
+        };
+
+        auto search = [&](detail::CycleState& state, const std::size_t start) {
+            state.reach(graph, start, depth);
+            state.frames.assign(1, {start, 0, detail::CycleState::NO_CYCLE});
+            state.blocked[start] = 1;
+            while (!state.frames.empty()) {
+                const std::size_t top {state.frames.size() - 1};
+                const std::size_t v {state.frames[top].vertex};
+                const auto children {graph.children(v)};
+                if (state.frames[top].cursor < children.size()) {
+                    const std::size_t i {state.frames[top].cursor++};
+                    const std::size_t w {children[i]};
+                    if (i != 0 && children[i - 1] == w) {
+                        continue;
+                    }
+                    if (w == start) {
+                        state.frames[top].back = 1;
+                        if (report(state)) {
+                            break;
+                        }
+                    } else if (w > start && state.reached.visited(w) && !state.blocked[w] && (!bounded || (state.frames.size() < state.lock[w] && state.frames.size() + state.distance[w] <= options.max_length))) {
+                        state.blocked[w] = 1;
+                        state.lock[w] = state.frames.size();
+                        state.frames.push_back({w, 0, detail::CycleState::NO_CYCLE});
+                    }
+                    continue;
+                }
+
+                const std::size_t back {state.frames[top].back};
+                state.frames.pop_back();
+                if (bounded) {
+                    // Listed even after a cycle: a child that was on the path may later offer a shorter way back.
+                    const std::size_t first_slot {graph.outgoing_offsets()[v]};
+                    for (std::size_t i {0}; i < children.size(); ++i) {
+                        const std::size_t w {children[i]};
+                        if (w > start && state.reached.visited(w) && (i == 0 || children[i - 1] != w) && !state.listed[first_slot + i]) {
+                            state.listed[first_slot + i] = 1;
+                            state.blocked_by[w].push_back(v);
+                        }
+                    }
+                    state.blocked[v] = 0;
+                    state.release(v, back == detail::CycleState::NO_CYCLE ? state.lock[v] : std::max(state.lock[v], options.max_length - back + 1));
+                } else if (back != detail::CycleState::NO_CYCLE) {
+                    state.unblock(v);
+                } else {
+                    for (const std::size_t w : children) {
+                        if (w > start && state.reached.visited(w)) {
+                            state.blocked_by[w].push_back(v);
+                        }
+                    }
+                }
+                if (back != detail::CycleState::NO_CYCLE && !state.frames.empty()) {
+                    state.frames.back().back = std::min(state.frames.back().back, back + 1);
+                }
+            }
+            state.blocked[start] = 0;
+            state.reset(graph);
+        };
+
+        // Low starts see most of the graph and high starts almost none of it, so starts are handed out one at a time.
+        parallel_for(n, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+            detail::CycleState& state {states[worker]};
+            state.prepare(graph);
+            for (std::size_t start {begin}; start < end && !stopped.load(std::memory_order_relaxed); ++start) {
+                search(state, start);
+            }
+        }, options.threads, 1);
+
+        detail::trace_counter(tracer, "cycles.found", static_cast<double>(cycles.load()));
+        return cycles.load();
+    }
+}
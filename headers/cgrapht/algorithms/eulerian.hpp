@@ -0,0 +1,190 @@
+/**
+ * @file eulerian.hpp
+ *
+ * @brief Eulerian paths and circuits, and the degree imbalance a Chinese postman tour has to repair.
+ *
+ * @Detail
+ * A directed graph has an Eulerian circuit if every vertex has as many incoming as outgoing edges and all edges are
+ * reachable from one vertex; it has an Eulerian path if, in addition, one vertex may have one more outgoing edge (the
+ * start) and one vertex one more incoming edge (the end). The degree checks are O(1) per vertex on a `FrozenGraph`.
+ *
+ * The walk is Hierholzer's algorithm without recursion. Every vertex has a cursor into its outgoing edges, so each edge
+ * is taken exactly once and neither the graph nor its adjacency is copied or modified. The current trail lives on an
+ * explicit stack; when the vertex on top has no untaken edge left, the edge that led to it is final and moves to the
+ * output. Memory is three words per edge for the stack and output plus one cursor per vertex, and the call depth stays
+ * constant, so graphs with hundreds of millions of edges are fine.
+ *
+ * A graph without an Eulerian circuit can still be toured if some edges are walked twice. `degree_imbalance` lists
+ * where the extra walks have to start and end; pairing them with the cheapest paths (e.g. shortest paths fed to
+ * `auction_assignment` or a min cost flow) and adding those paths as edges yields a graph with a circuit.
+ *
+ * Reference: Hierholzer and Wiener, "Über die Möglichkeit, einen Linienzug ohne Wiederholung und ohne Unterbrechung zu
+ * umfahren", Math. Ann. 1873; Edmonds and Johnson, "Matching, Euler tours and the Chinese postman", Math. Prog. 1973.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief A vertex whose in- and out-degree differ.
+     */
+    struct Imbalance {
+        std::size_t vertex_id;  ///< Vertex id in the source graph.
+        std::size_t amount;     ///< Absolute difference between in- and out-degree.
+
+        bool operator==(const Imbalance& other) const = default;
+    };
+
+    /**
+     * @brief Where the extra walks of a Chinese postman tour start and end.
+     */
+    struct DegreeImbalance {
+        std::vector<Imbalance> starts{};    ///< More incoming than outgoing edges: extra walks leave from here.
+        std::vector<Imbalance> ends{};      ///< More outgoing than incoming edges: extra walks arrive here.
+        std::size_t total {0};              ///< Number of extra walks, the sum of the amounts on either side.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * Iterative Hierholzer from `start`. Returns the edge ids in walk order, or an empty vector if some edge is not
+         * reachable from `start`.
+         */
+        template <typename Tracer>
+        std::vector<std::size_t> hierholzer(const FrozenGraph& graph, const std::size_t start, Tracer& tracer) {
+            const TraceSpan span {tracer, "eulerian.walk"};
+            struct Step {
+                std::size_t vertex;
+                std::size_t edge_id;
+            };
+
+            std::vector<std::size_t> cursor(graph.vertex_count(), 0);
+            std::vector<Step> trail {};
+            std::vector<std::size_t> walk {};
+            trail.reserve(graph.edge_count() + 1);
+            walk.reserve(graph.edge_count());
+            trail.push_back({start, 0});
+            while (!trail.empty()) {
+                const std::size_t v {trail.back().vertex};
+                if (cursor[v] < graph.out_degree(v)) {
+                    const std::size_t slot {cursor[v]++};
+                    trail.push_back({graph.children(v)[slot], graph.outgoing_edges(v)[slot]});
+                    continue;
+                }
+                // Every edge out of v is taken, so the edge into v is final. The bottom step has no edge.
+                if (trail.size() > 1) {
+                    walk.push_back(trail.back().edge_id);
+                }
+                trail.pop_back();
+            }
+            if (walk.size() != graph.edge_count()) {
+                return {};
+            }
+            std::ranges::reverse(walk);
+            return walk;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Vertices whose in- and out-degree differ, in dense index order.
+     *
+     * The graph has an Eulerian circuit only if `total` is 0, and an Eulerian path only if `total` is at most 1.
+     */
+    inline DegreeImbalance degree_imbalance(const FrozenGraph& graph) {
+        DegreeImbalance imbalance {};
+        for (std::size_t v {0}; v < graph.vertex_count(); ++v) {
+            const std::size_t in {graph.in_degree(v)};
+            const std::size_t out {graph.out_degree(v)};
+            if (in > out) {
+                imbalance.starts.push_back({graph.vertex_id(v), in - out});
+                imbalance.total += in - out;
+            } else if (out > in) {
+                imbalance.ends.push_back({graph.vertex_id(v), out - in});
+            }
+        }
+        return imbalance;
+    }
+
+    /**
+     * @brief Closed walk that takes every edge exactly once.
+     *
+     * The walk starts at the vertex with the smallest dense index that has an outgoing edge.
+     *
+     * @param graph Frozen graph.
+     * @param tracer Receives an `eulerian.walk` span. See `tracing.hpp`.
+     * @return Result containing the edge ids in walk order, empty for a graph without edges, or `INVALID_ARGUMENT` if
+     *         some vertex is unbalanced or the edges are not all reachable from one vertex.
+     */
+    template <typename Tracer = NoTracer>
+    Result<std::vector<std::size_t>, ErrorType> eulerian_circuit(const FrozenGraph& graph, Tracer&& tracer = Tracer{}) {
+        std::size_t start {graph.vertex_count()};
+        for (std::size_t v {0}; v < graph.vertex_count(); ++v) {
+            if (graph.in_degree(v) != graph.out_degree(v)) {
+                return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            if (start == graph.vertex_count() && graph.out_degree(v) != 0) {
+                start = v;
+            }
+        }
+        if (start == graph.vertex_count()) {
+            return Result<std::vector<std::size_t>, ErrorType>::success({});
+        }
+        auto walk {detail::hierholzer(graph, start, tracer)};
+        if (walk.empty()) {
+            return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        return Result<std::vector<std::size_t>, ErrorType>::success(std::move(walk));
+    }
+
+    /**
+     * @brief Walk that takes every edge exactly once, closed if the graph has an Eulerian circuit.
+     *
+     * The walk starts at the vertex with one more outgoing than incoming edge if there is one, and otherwise is the
+     * circuit `eulerian_circuit` returns.
+     *
+     * @param graph Frozen graph.
+     * @param tracer Receives an `eulerian.walk` span. See `tracing.hpp`.
+     * @return Result containing the edge ids in walk order, empty for a graph without edges, or `INVALID_ARGUMENT` if
+     *         the degrees allow no Eulerian path or the edges are not all reachable from the start.
+     */
+    template <typename Tracer = NoTracer>
+    Result<std::vector<std::size_t>, ErrorType> eulerian_path(const FrozenGraph& graph, Tracer&& tracer = Tracer{}) {
+        std::size_t start {graph.vertex_count()};
+        std::size_t starts {0};
+        std::size_t ends {0};
+        for (std::size_t v {0}; v < graph.vertex_count(); ++v) {
+            const std::size_t in {graph.in_degree(v)};
+            const std::size_t out {graph.out_degree(v)};
+            if (out == in + 1) {
+                start = v;
+                ++starts;
+            } else if (in == out + 1) {
+                ++ends;
+            } else if (in != out) {
+                return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+        }
+        if (starts == 0 && ends == 0) {
+            return eulerian_circuit(graph, tracer);
+        }
+        if (starts != 1 || ends != 1) {
+            return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        auto walk {detail::hierholzer(graph, start, tracer)};
+        if (walk.empty()) {
+            return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        return Result<std::vector<std::size_t>, ErrorType>::success(std::move(walk));
+    }
+}
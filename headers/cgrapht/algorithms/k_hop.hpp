@@ -0,0 +1,154 @@
+/**
+ * @file k_hop.hpp
+ *
+ * @brief k-hop neighbourhoods and ego networks.
+ *
+ * @Detail
+ * `k_hop` answers "which vertices are within `k` hops of `v`, and how far away are they" with a bounded BFS over a
+ * `FrozenGraph`. It is built for issuing many small queries back to back: the visited set is a per-thread array of
+ * integer stamps indexed by dense vertex index, and a query only bumps the current stamp instead of clearing the
+ * array. The answer is a span over a per-thread buffer, so a query performs no allocation once the buffers are warm.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/detail/epoch_stamps.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/models.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief One vertex of a k-hop neighbourhood.
+     */
+    struct Hop {
+        std::size_t vertex_id;  ///< Vertex id in the source graph.
+        std::size_t index;      ///< Dense index in the frozen graph.
+        std::uint32_t distance; ///< Hops from the query source.
+
+        bool operator==(const Hop& other) const = default;
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        struct HopWorkspace {
+            EpochStamps stamps{};
+            std::vector<Hop> hops{};
+
+            void begin(const std::size_t vertex_count) {
+                stamps.begin(vertex_count);
+                hops.clear();
+            }
+
+            [[nodiscard]] bool visited(const std::size_t index) const {
+                return stamps.visited(index);
+            }
+
+            void visit(const FrozenGraph& graph, const std::size_t index, const std::uint32_t distance) {
+                stamps.visit(index);
+                hops.push_back(Hop{graph.vertex_id(index), index, distance});
+            }
+        };
+
+        inline HopWorkspace& hop_workspace() {
+            thread_local HopWorkspace workspace {};
+            return workspace;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief All vertices within `k` hops of a source, with their distances.
+     *
+     * Vertices are reported in BFS order, so distances are non-decreasing and the source comes first with distance 0.
+     *
+     * @param graph Frozen graph to search.
+     * @param source_id Vertex id to start from.
+     * @param k Maximum number of hops.
+     * @param direction Which edges to follow.
+     * @return Result containing the neighbourhood or `ABSENT_VERTEX`. The span points into a thread local buffer and
+     *         stays valid until the next `k_hop` or `ego_subgraph` call on the same thread.
+     */
+    inline Result<std::span<const Hop>, ErrorType> k_hop(const FrozenGraph& graph, const std::size_t source_id, const std::size_t k,
+                                                         const Direction direction = Direction::OUTGOING) {
+        auto source = graph.index_of(source_id);
+        if (!source.is_ok()) {
+            return Result<std::span<const Hop>, ErrorType>::error(source.get_error());
+        }
+
+        auto& workspace {detail::hop_workspace()};
+        workspace.begin(graph.vertex_count());
+        workspace.visit(graph, source.get_ok(), 0);
+
+        // The result buffer doubles as the BFS queue.
+        for (std::size_t head {0}; head < workspace.hops.size(); ++head) {
+            const auto [_, v, distance] = workspace.hops[head];
+            if (distance >= k) {
+                break;
+            }
+            auto expand = [&](std::span<const std::size_t> neighbours) {
+                for (const std::size_t next : neighbours) {
+                    if (!workspace.visited(next)) {
+                        workspace.visit(graph, next, distance + 1);
+                    }
+                }
+            };
+            if (direction != Direction::INCOMING) {
+                expand(graph.children(v));
+            }
+            if (direction != Direction::OUTGOING) {
+                expand(graph.parents(v));
+            }
+        }
+        return Result<std::span<const Hop>, ErrorType>::success(std::span<const Hop>{workspace.hops});
+    }
+
+    /**
+     * @brief Induced subgraph over the k-hop neighbourhood of a source.
+     *
+     * The neighbourhood is found as in `k_hop`. The returned graph contains those vertices and every edge of `graph`
+     * between two of them, regardless of `direction`, with payloads copied from `graph`. The result is unobserved.
+     *
+     * @param graph Graph holding the payloads.
+     * @param frozen Snapshot of `graph` used for the search.
+     * @param source_id Vertex id to start from.
+     * @param k Maximum number of hops.
+     * @param direction Which edges to follow while collecting vertices.
+     * @return Result containing the ego network or `ABSENT_VERTEX`.
+     */
+    template <Hashable V, Hashable E, typename Observer>
+    Result<DirectedGraph<V, E>, ErrorType> ego_subgraph(const DirectedGraph<V, E, Observer>& graph, const FrozenGraph& frozen, const std::size_t source_id,
+                                                        const std::size_t k, const Direction direction = Direction::OUTGOING) {
+        auto hops = k_hop(frozen, source_id, k, direction);
+        if (!hops.is_ok()) {
+            return Result<DirectedGraph<V, E>, ErrorType>::error(hops.get_error());
+        }
+
+        DirectedGraph<V, E> ego {};
+        for (const Hop& hop : hops.get_ok()) {
+            ego.add_vertex(graph.get_vertex(hop.vertex_id).get_ok());
+        }
+
+        // Membership is read straight from the stamps that the search just left behind.
+        const auto& workspace {detail::hop_workspace()};
+        for (const Hop& hop : hops.get_ok()) {
+            const auto children {frozen.children(hop.index)};
+            const auto edges {frozen.outgoing_edges(hop.index)};
+            for (std::size_t slot {0}; slot < children.size(); ++slot) {
+                if (workspace.visited(children[slot])) {
+                    const auto edge {graph.get_edge(edges[slot]).get_ok()};
+                    ego.add_edge(edge.from_id, edge.to_id, edge.edge);
+                }
+            }
+        }
+        return Result<DirectedGraph<V, E>, ErrorType>::success(std::move(ego));
+    }
+}
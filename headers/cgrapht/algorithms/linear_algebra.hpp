@@ -0,0 +1,191 @@
+/**
+ * @file linear_algebra.hpp
+ *
+ * @brief BFS, single source shortest paths and PageRank expressed as semiring products.
+ *
+ * @Detail
+ * All three algorithms here are loops around the one `vxm` kernel of `semiring.hpp`:
+ *
+ * - `bfs_levels` advances a boolean frontier with `OrAnd`, masking out visited vertices. `SpmvStrategy::AUTO` makes it
+ *   direction optimizing: small frontiers are pushed, large ones pulled, and pulls stop at the first visited parent.
+ * - `sssp` is frontier based Bellman-Ford: every round relaxes only the edges leaving vertices whose distance just
+ *   improved, with a `MinPlus` product. Negative weights are allowed; a reachable negative cycle is reported.
+ * - `pagerank` is the power iteration, one dense `PlusTimes` pull per iteration.
+ *
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Level reported by `bfs_levels` for vertices the source does not reach.
+     */
+    inline constexpr std::uint32_t UNREACHED_LEVEL {std::numeric_limits<std::uint32_t>::max()};
+
+    /**
+     * @brief Options for the semiring traversals `bfs_levels` and `sssp`.
+     */
+    struct TraversalOptions {
+        SpmvStrategy strategy {SpmvStrategy::AUTO};
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Options for `pagerank`.
+     */
+    struct PageRankOptions {
+        double damping {0.85};              ///< Probability of following an edge rather than teleporting.
+        double tolerance {1e-9};            ///< Stop once the L1 change of the ranks falls below this.
+        std::size_t max_iterations {100};
+        std::size_t threads {0};            ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Hop distance from a source to every vertex, following outgoing edges.
+     *
+     * @param graph Frozen graph to traverse.
+     * @param source_id Vertex id to start from.
+     * @param options Push/pull strategy and workers.
+     * @param tracer Receives a `bfs.level` span and a `bfs.frontier` counter per level. See `tracing.hpp`.
+     * @return Result containing the levels indexed by dense index (`UNREACHED_LEVEL` where unreached), or
+     *         `ABSENT_VERTEX`.
+     */
+    template <typename Tracer = NoTracer>
+    Result<std::vector<std::uint32_t>, ErrorType> bfs_levels(const FrozenGraph& graph, const std::size_t source_id, const TraversalOptions& options = {},
+                                                             Tracer&& tracer = Tracer{}) {
+        auto source = graph.index_of(source_id);
+        if (!source.is_ok()) {
+            return Result<std::vector<std::uint32_t>, ErrorType>::error(source.get_error());
+        }
+        const std::size_t n {graph.vertex_count()};
+        const AdjacencyMatrix<std::uint8_t> adjacency {AdjacencyMatrix<std::uint8_t>::pattern(graph, 1)};
+        std::vector<std::uint32_t> levels(n, UNREACHED_LEVEL);
+        std::vector<std::uint8_t> visited(n, 0);
+        levels[source.get_ok()] = 0;
+        visited[source.get_ok()] = 1;
+
+        GraphVector<OrAnd> frontier {GraphVector<OrAnd>::sparse(n, {{source.get_ok(), 1}})};
+        const SpmvOptions spmv {.strategy = options.strategy, .mask = visited, .complement_mask = true, .threads = options.threads};
+        for (std::uint32_t depth {1}; frontier.nnz() != 0; ++depth) {
+            const detail::TraceSpan span {tracer, "bfs.level"};
+            frontier = vxm(std::move(frontier), adjacency, spmv).consume_ok();
+            frontier.make_sparse();
+            for (const auto& entry : frontier.entries()) {
+                levels[entry.first] = depth;
+                visited[entry.first] = 1;
+            }
+            detail::trace_counter(tracer, "bfs.frontier", static_cast<double>(frontier.entries().size()));
+        }
+        return Result<std::vector<std::uint32_t>, ErrorType>::success(std::move(levels));
+    }
+
+    /**
+     * @brief Shortest path distances from a source, following outgoing edges.
+     *
+     * @tparam T Weight type.
+     * @param weights Edge weights, e.g. from `AdjacencyMatrix<T>::weighted`.
+     * @param source_id Vertex id to start from.
+     * @param options Push/pull strategy and workers.
+     * @param tracer Receives a `sssp.round` span and a `sssp.frontier` counter per relaxation round.
+     * @return Result containing the distances indexed by dense index (`MinPlus<T>::zero()` where unreachable),
+     *         `ABSENT_VERTEX`, or `CYCLE_DETECTED` if a negative cycle is reachable from the source.
+     */
+    template <typename T, typename Tracer = NoTracer>
+    Result<std::vector<T>, ErrorType> sssp(const AdjacencyMatrix<T>& weights, const std::size_t source_id, const TraversalOptions& options = {},
+                                           Tracer&& tracer = Tracer{}) {
+        using S = MinPlus<T>;
+        const FrozenGraph& graph {weights.frozen_graph()};
+        auto source = graph.index_of(source_id);
+        if (!source.is_ok()) {
+            return Result<std::vector<T>, ErrorType>::error(source.get_error());
+        }
+        const std::size_t n {graph.vertex_count()};
+        std::vector<T> distances(n, S::zero());
+        distances[source.get_ok()] = T{0};
+
+        GraphVector<S> frontier {GraphVector<S>::sparse(n, {{source.get_ok(), T{0}}})};
+        const SpmvOptions spmv {.strategy = options.strategy, .threads = options.threads};
+        // Without negative cycles every shortest path has fewer than n edges, so round n must find nothing to improve.
+        for (std::size_t round {1}; frontier.nnz() != 0; ++round) {
+            if (round > n) {
+                return Result<std::vector<T>, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+            }
+            const detail::TraceSpan span {tracer, "sssp.round"};
+            GraphVector<S> candidates {vxm(std::move(frontier), weights, spmv).consume_ok()};
+            candidates.make_sparse();
+            std::vector<typename GraphVector<S>::Entry> improved {};
+            for (const auto& [index, distance] : candidates.entries()) {
+                if (distance < distances[index]) {
+                    distances[index] = distance;
+                    improved.emplace_back(index, distance);
+                }
+            }
+            detail::trace_counter(tracer, "sssp.frontier", static_cast<double>(improved.size()));
+            frontier = GraphVector<S>::sparse(n, std::move(improved));
+        }
+        return Result<std::vector<T>, ErrorType>::success(std::move(distances));
+    }
+
+    /**
+     * @brief PageRank of every vertex.
+     *
+     * Rank mass of vertices without outgoing edges is spread uniformly. Parallel edges count once each.
+     *
+     * @param graph Frozen graph.
+     * @param options Damping, convergence and workers.
+     * @param tracer Receives a `pagerank.iteration` span and a `pagerank.residual` counter (the L1 change) per iteration.
+     * @return Result containing the ranks indexed by dense index, summing to 1, or `INVALID_ARGUMENT` if `damping` is
+     *         outside `[0, 1]`.
+     */
+    template <typename Tracer = NoTracer>
+    Result<std::vector<double>, ErrorType> pagerank(const FrozenGraph& graph, const PageRankOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        if (!(options.damping >= 0.0 && options.damping <= 1.0)) {
+            return Result<std::vector<double>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const std::size_t n {graph.vertex_count()};
+        if (n == 0) {
+            return Result<std::vector<double>, ErrorType>::success({});
+        }
+        using S = PlusTimes<double>;
+        const AdjacencyMatrix<double> adjacency {AdjacencyMatrix<double>::pattern(graph, 1.0)};
+        const SpmvOptions spmv {.strategy = SpmvStrategy::PULL, .threads = options.threads};
+        const double uniform {1.0 / static_cast<double>(n)};
+
+        std::vector<double> ranks(n, uniform);
+        std::vector<double> shares(n);
+        for (std::size_t iteration {0}; iteration < options.max_iterations; ++iteration) {
+            const detail::TraceSpan span {tracer, "pagerank.iteration"};
+            double dangling {0};
+            for (std::size_t i {0}; i < n; ++i) {
+                const std::size_t degree {graph.out_degree(i)};
+                shares[i] = degree == 0 ? 0.0 : ranks[i] / static_cast<double>(degree);
+                dangling += degree == 0 ? ranks[i] : 0.0;
+            }
+
+            const GraphVector<S> inflow {vxm(GraphVector<S>::dense(shares), adjacency, spmv).consume_ok()};
+            const double base {(1.0 - options.damping) * uniform + options.damping * dangling * uniform};
+            double residual {0};
+            for (std::size_t i {0}; i < n; ++i) {
+                const double rank {base + options.damping * inflow.values()[i]};
+                residual += std::abs(rank - ranks[i]);
+                ranks[i] = rank;
+            }
+            detail::trace_counter(tracer, "pagerank.residual", residual);
+            if (residual < options.tolerance) {
+                break;
+            }
+        }
+        return Result<std::vector<double>, ErrorType>::success(std::move(ranks));
+    }
+}
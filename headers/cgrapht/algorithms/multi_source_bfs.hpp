@@ -0,0 +1,213 @@
+/**
+ * @file multi_source_bfs.hpp
+ *
+ * @brief Bit-parallel breadth first search from many sources at once (MS-BFS).
+ *
+ * @Detail
+ * Running one BFS per source scans every adjacency list once per source. MS-BFS runs up to `LANES` traversals in
+ * lock step instead: each vertex carries a bitmask with one bit per traversal, and a single scan of a neighbourhood
+ * propagates the frontier bits of all traversals with one bitwise OR. The masks are fixed size word arrays so the OR,
+ * AND-NOT and emptiness checks compile to SIMD instructions where the target supports them.
+ *
+ * Reference: Then et al., "The More the Merrier: Efficient Multi-Source Graph Traversal", VLDB 2014.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Hop distances from a set of sources to every vertex of a `FrozenGraph`.
+     *
+     * Distances are stored row major, one row of `vertex_count()` entries per source, indexed by dense vertex index.
+     */
+    class MultiSourceDistances {
+    private:
+        std::size_t vertices {};
+        std::vector<std::uint32_t> distances{};
+
+    public:
+        /**
+         * @brief Distance reported for vertices a source does not reach (within the depth limit).
+         */
+        static constexpr std::uint32_t UNREACHED {std::numeric_limits<std::uint32_t>::max()};
+
+        /// @cond INTERNAL
+        MultiSourceDistances(const std::size_t source_count, const std::size_t vertex_count)
+            : vertices{vertex_count}, distances(source_count * vertex_count, UNREACHED) {}
+        /// @endcond
+
+        /**
+         * @brief Number of sources, i.e. rows.
+         */
+        [[nodiscard]] std::size_t source_count() const {
+            return vertices == 0 ? 0 : distances.size() / vertices;
+        }
+
+        /**
+         * @brief Number of vertices, i.e. columns.
+         */
+        [[nodiscard]] std::size_t vertex_count() const {
+            return vertices;
+        }
+
+        /**
+         * @brief Distance from a source to a vertex.
+         * @param source Position of the source in the list passed to `multi_source_bfs`.
+         * @param index Dense vertex index.
+         * @return Hop count, or `UNREACHED`.
+         */
+        [[nodiscard]] std::uint32_t distance(const std::size_t source, const std::size_t index) const {
+            return distances[source * vertices + index];
+        }
+
+        /**
+         * @brief All distances from one source, indexed by dense vertex index.
+         * @param source Position of the source in the list passed to `multi_source_bfs`.
+         */
+        [[nodiscard]] std::span<const std::uint32_t> row(const std::size_t source) const {
+            return std::span{distances}.subspan(source * vertices, vertices);
+        }
+
+        /// @cond INTERNAL
+        std::uint32_t& at(const std::size_t source, const std::size_t index) {
+            return distances[source * vertices + index];
+        }
+        /// @endcond
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <std::size_t WORDS>
+        using LaneMask = std::array<std::uint64_t, WORDS>;
+
+        template <std::size_t WORDS>
+        bool any(const LaneMask<WORDS>& mask) {
+            std::uint64_t folded {0};
+            for (std::size_t w {0}; w < WORDS; ++w) {
+                folded |= mask[w];
+            }
+            return folded != 0;
+        }
+
+        template <std::size_t WORDS>
+        void or_into(LaneMask<WORDS>& target, const LaneMask<WORDS>& source) {
+            for (std::size_t w {0}; w < WORDS; ++w) {
+                target[w] |= source[w];
+            }
+        }
+
+        /**
+         * @brief Run one batch of at most `WORDS * 64` traversals and record the distances.
+         */
+        template <std::size_t WORDS, typename Tracer>
+        void multi_source_bfs_batch(const FrozenGraph& graph, std::span<const std::size_t> sources, const std::size_t first_row,
+                                    const std::size_t max_depth, MultiSourceDistances& result, Tracer& tracer) {
+            const std::size_t n {graph.vertex_count()};
+            std::vector<LaneMask<WORDS>> seen(n);
+            std::vector<LaneMask<WORDS>> visit(n);
+            std::vector<LaneMask<WORDS>> visit_next(n);
+
+            for (std::size_t lane {0}; lane < sources.size(); ++lane) {
+                const std::uint64_t bit {std::uint64_t{1} << (lane % 64)};
+                seen[sources[lane]][lane / 64] |= bit;
+                visit[sources[lane]][lane / 64] |= bit;
+                result.at(first_row + lane, sources[lane]) = 0;
+            }
+
+            bool active {!sources.empty()};
+            for (std::uint32_t depth {1}; active && depth <= max_depth; ++depth) {
+                trace_begin(tracer, "multi_source_bfs.level");
+                std::size_t frontier {0};
+
+                // Top-down step: push the frontier bits of every active vertex to all of its children in one scan.
+                for (std::size_t v {0}; v < n; ++v) {
+                    if (!any(visit[v])) {
+                        continue;
+                    }
+                    for (const std::size_t child : graph.children(v)) {
+                        or_into(visit_next[child], visit[v]);
+                    }
+                }
+
+                active = false;
+                for (std::size_t v {0}; v < n; ++v) {
+                    LaneMask<WORDS> fresh {};
+                    for (std::size_t w {0}; w < WORDS; ++w) {
+                        fresh[w] = visit_next[v][w] & ~seen[v][w];
+                        seen[v][w] |= fresh[w];
+                        visit_next[v][w] = 0;
+                    }
+                    visit[v] = fresh;
+                    if (!any(fresh)) {
+                        continue;
+                    }
+                    active = true;
+                    ++frontier;
+                    for (std::size_t w {0}; w < WORDS; ++w) {
+                        for (std::uint64_t bits {fresh[w]}; bits != 0; bits &= bits - 1) {
+                            const std::size_t lane {w * 64 + static_cast<std::size_t>(std::countr_zero(bits))};
+                            result.at(first_row + lane, v) = depth;
+                        }
+                    }
+                }
+                trace_counter(tracer, "multi_source_bfs.frontier", static_cast<double>(frontier));
+                trace_end(tracer, "multi_source_bfs.level");
+            }
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Hop distances from many sources, following outgoing edges.
+     *
+     * The sources are processed in batches of `LANES` concurrent traversals. Larger batches share more of each
+     * neighbourhood scan but use `LANES / 8` bytes of state per vertex and per mask (three masks are kept).
+     *
+     * @tparam LANES Traversals per batch, a positive multiple of 64 (typically 64 or 256).
+     * @param graph Frozen graph to traverse.
+     * @param source_ids Vertex ids to start from. Duplicates are allowed and produce identical rows.
+     * @param max_depth Stop expanding after this many hops. Vertices further away are reported as unreached.
+     * @param tracer Receives a `multi_source_bfs.batch` span per batch and, per level, a `multi_source_bfs.level` span
+     *        and the number of vertices newly reached as `multi_source_bfs.frontier`. See `tracing.hpp`.
+     * @return Result containing one row of distances per source, or `ABSENT_VERTEX` if a source is not in the graph.
+     */
+    template <std::size_t LANES = 64, typename Tracer = NoTracer>
+    Result<MultiSourceDistances, ErrorType> multi_source_bfs(const FrozenGraph& graph, std::span<const std::size_t> source_ids,
+                                                             const std::size_t max_depth = std::numeric_limits<std::size_t>::max(),
+                                                             Tracer&& tracer = Tracer{}) {
+        static_assert(LANES > 0 && LANES % 64 == 0, "LANES must be a positive multiple of 64");
+
+        std::vector<std::size_t> sources {};
+        sources.reserve(source_ids.size());
+        for (const std::size_t id : source_ids) {
+            auto index = graph.index_of(id);
+            if (!index.is_ok()) {
+                return Result<MultiSourceDistances, ErrorType>::error(index.get_error());
+            }
+            sources.push_back(index.get_ok());
+        }
+
+        MultiSourceDistances result {sources.size(), graph.vertex_count()};
+        for (std::size_t first {0}; first < sources.size(); first += LANES) {
+            const auto batch {std::span{sources}.subspan(first, std::min(LANES, sources.size() - first))};
+            detail::trace_begin(tracer, "multi_source_bfs.batch");
+            detail::multi_source_bfs_batch<LANES / 64>(graph, batch, first, max_depth, result, tracer);
+            detail::trace_end(tracer, "multi_source_bfs.batch");
+        }
+        return Result<MultiSourceDistances, ErrorType>::success(std::move(result));
+    }
+}
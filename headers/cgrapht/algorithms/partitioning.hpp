@@ -0,0 +1,665 @@
+/**
+ * @file partitioning.hpp
+ *
+ * @brief Balanced k-way vertex partitioning and a per-partition view with ghost vertices.
+ *
+ * @Detail
+ * A partitioning assigns every dense vertex index of a `FrozenGraph` to one of `k` parts so that parts have about
+ * `n / k` vertices and few edges run between parts. Edge direction is ignored for placement; the edge cut counts every
+ * edge whose endpoints sit in different parts once. `max_imbalance` bounds the largest part at
+ * `max_imbalance * n / k` vertices (but never below `ceil(n / k)`), and the reported `imbalance` uses the same unit.
+ *
+ * - `streaming_partition` places vertices one at a time in dense index order, each in the part holding most of its
+ *   already placed neighbours, discounted by how full the part is. `LDG` multiplies the neighbour count by the free
+ *   fraction of the part, `FENNEL` subtracts a marginal cost that grows with the part size. One pass, O(n + m) time and
+ *   O(k) extra memory per vertex, so it also suits graphs that arrive as a stream.
+ * - `multilevel_partition` follows METIS: it coarsens the symmetrized graph by heavy edge matching (collapsing
+ *   matched pairs with the same machinery as `louvain`) until it is small, grows the parts of an initial partition
+ *   one at a time on the coarsest graph, then projects it back level by level and refines each level by greedily
+ *   moving boundary vertices to the neighbouring part they are most connected to, as long as capacity allows.
+ *   Vertices in overweight parts move even at a loss, so the final partition respects the bound.
+ *
+ * `PartitionedGraph` splits a frozen graph along a partitioning. Every part gets local indices: the vertices it owns
+ * first, then the ghosts, i.e. vertices of other parts adjacent to an owned vertex. Owned vertices carry their full
+ * outgoing and incoming adjacency as local indices and edge ids; ghosts carry none but know their owner. Algorithms
+ * can run on one part with dense local arrays and exchange ghost values between parts.
+ *
+ * Reference: Stanton and Kliot, "Streaming Graph Partitioning for Large Distributed Graphs", KDD 2012; Tsourakakis et
+ * al., "FENNEL: Streaming Graph Partitioning for Massive Scale Graphs", WSDM 2014; Karypis and Kumar, "A Fast and High
+ * Quality Multilevel Scheme for Partitioning Irregular Graphs", SIAM J. Sci. Comput. 1998.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/algorithms/community.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief An assignment of vertices to parts, with its quality.
+     */
+    struct Partitioning {
+        std::vector<std::size_t> parts{};   ///< Part of every dense vertex index.
+        std::size_t count {0};              ///< Number of parts.
+        std::vector<std::size_t> sizes{};   ///< Vertices per part.
+        std::size_t cut_edges {0};          ///< Edges between different parts; self loops are never cut.
+        double imbalance {0};               ///< Largest part over the average part size, 1 for a perfect balance.
+    };
+
+    /**
+     * @brief Scoring rule of `streaming_partition`.
+     */
+    enum class StreamingHeuristic {
+        LDG,        ///< Linear deterministic greedy: neighbours in the part times its free fraction.
+        FENNEL      ///< Neighbours in the part minus the marginal cost of growing it.
+    };
+
+    /**
+     * @brief Options for `streaming_partition`.
+     */
+    struct StreamingPartitionOptions {
+        std::size_t parts {2};                                  ///< Number of parts, at least 1.
+        StreamingHeuristic heuristic {StreamingHeuristic::FENNEL};
+        double max_imbalance {1.03};                            ///< Largest part over the average part size, at least 1.
+        double gamma {1.5};                                     ///< Exponent of the Fennel cost, greater than 1.
+    };
+
+    /**
+     * @brief Options for `multilevel_partition`.
+     */
+    struct MultilevelPartitionOptions {
+        std::size_t parts {2};                  ///< Number of parts, at least 1.
+        double max_imbalance {1.03};            ///< Largest part over the average part size, at least 1.
+        std::size_t refinement_sweeps {8};      ///< Refinement sweeps per level.
+        std::uint64_t seed {0x5eed};            ///< Seed of the matching and refinement orders.
+        std::size_t threads {0};                ///< Workers for coarsening, 0 for one per hardware thread.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        inline std::size_t part_capacity(const std::size_t weight, const std::size_t parts, const double max_imbalance) {
+            const std::size_t even {(weight + parts - 1) / parts};
+            return std::max(even, static_cast<std::size_t>(max_imbalance * static_cast<double>(weight) / static_cast<double>(parts)));
+        }
+
+        /**
+         * Heavy edge matching: every vertex, in random order, pairs with the unmatched neighbour it shares the most
+         * weight with, unless the pair would outweigh `max_weight`. Returns the number of coarse vertices.
+         */
+        inline std::size_t heavy_edge_matching(const CommunityGraph& graph, std::span<const std::size_t> weights, const std::size_t max_weight,
+                                               std::vector<std::size_t>& labels, std::mt19937_64& random, WeightAccumulator& accumulator) {
+            constexpr std::size_t NONE {std::numeric_limits<std::size_t>::max()};
+            labels.assign(graph.size(), NONE);
+            std::size_t count {0};
+            for (const std::size_t v : shuffled_order(graph.size(), random)) {
+                if (labels[v] != NONE) {
+                    continue;
+                }
+                accumulator.reset(graph.offsets[v + 1] - graph.offsets[v]);
+                for (std::size_t k {graph.offsets[v]}; k < graph.offsets[v + 1]; ++k) {
+                    const std::size_t u {graph.neighbours[k]};
+                    if (u != v && labels[u] == NONE && weights[u] + weights[v] <= max_weight) {
+                        accumulator.add(u, graph.weights[k]);
+                    }
+                }
+                std::size_t mate {v};
+                double heaviest {0};
+                accumulator.for_each([&](const std::size_t u, const double weight) {
+                    if (weight > heaviest || (weight == heaviest && u < mate)) {
+                        mate = u;
+                        heaviest = weight;
+                    }
+                });
+                labels[v] = count;
+                labels[mate] = count;
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * Initial partition of the coarsest graph by greedy graph growing: each part starts from the first unassigned
+         * vertex and repeatedly takes the unassigned vertex most connected to it until it holds its share of the
+         * remaining weight. The last part takes the rest.
+         */
+        inline void grow_partition(const CommunityGraph& graph, std::span<const std::size_t> weights, const std::size_t parts,
+                                   const std::size_t capacity, std::vector<std::size_t>& labels, std::vector<std::size_t>& part_weights) {
+            constexpr std::size_t NONE {std::numeric_limits<std::size_t>::max()};
+            const std::size_t n {graph.size()};
+            labels.assign(n, NONE);
+            part_weights.assign(parts, 0);
+            std::size_t remaining {std::accumulate(weights.begin(), weights.end(), std::size_t{0})};
+            std::vector<double> connection(n);
+            for (std::size_t part {0}; part + 1 < parts; ++part) {
+                const std::size_t share {(remaining + parts - part - 1) / (parts - part)};
+                connection.assign(n, 0.0);
+                // Max heap with lazy deletion: an entry is stale once the vertex is assigned or its connection grew.
+                std::priority_queue<std::pair<double, std::size_t>> frontier {};
+                std::size_t next_seed {0};
+                while (part_weights[part] < share) {
+                    if (frontier.empty()) {
+                        while (next_seed < n && labels[next_seed] != NONE) {
+                            ++next_seed;
+                        }
+                        if (next_seed == n) {
+                            break;
+                        }
+                        frontier.emplace(connection[next_seed], next_seed);
+                        ++next_seed;
+                    }
+                    const auto [strength, v] = frontier.top();
+                    frontier.pop();
+                    if (labels[v] != NONE || strength != connection[v] || part_weights[part] + weights[v] > capacity) {
+                        continue;
+                    }
+                    labels[v] = part;
+                    part_weights[part] += weights[v];
+                    remaining -= weights[v];
+                    for (std::size_t k {graph.offsets[v]}; k < graph.offsets[v + 1]; ++k) {
+                        const std::size_t u {graph.neighbours[k]};
+                        if (labels[u] == NONE && u != v) {
+                            connection[u] += graph.weights[k];
+                            frontier.emplace(connection[u], u);
+                        }
+                    }
+                }
+            }
+            for (std::size_t v {0}; v < n; ++v) {
+                if (labels[v] == NONE) {
+                    labels[v] = parts - 1;
+                    part_weights[parts - 1] += weights[v];
+                }
+            }
+        }
+
+        /**
+         * Greedy boundary refinement. A vertex moves to the neighbouring part it is most connected to if that part has
+         * room and the move cuts less weight, or cuts the same weight and evens out the two parts. A vertex of an
+         * overweight part moves regardless of the gain, to the lightest part if no neighbouring part has room. Returns
+         * the number of moves.
+         */
+        inline std::size_t refine_partition(const CommunityGraph& graph, std::span<const std::size_t> weights, const std::size_t capacity,
+                                            const std::size_t sweeps, std::vector<std::size_t>& labels, std::vector<std::size_t>& part_weights,
+                                            std::mt19937_64& random, WeightAccumulator& accumulator) {
+            constexpr std::size_t NONE {std::numeric_limits<std::size_t>::max()};
+            std::size_t total_moves {0};
+            for (std::size_t sweep {0}; sweep < sweeps; ++sweep) {
+                std::size_t moves {0};
+                for (const std::size_t v : shuffled_order(graph.size(), random)) {
+                    const std::size_t current {labels[v]};
+                    accumulator.reset(graph.offsets[v + 1] - graph.offsets[v]);
+                    for (std::size_t k {graph.offsets[v]}; k < graph.offsets[v + 1]; ++k) {
+                        if (graph.neighbours[k] != v) {
+                            accumulator.add(labels[graph.neighbours[k]], graph.weights[k]);
+                        }
+                    }
+                    double internal {0};
+                    std::size_t best {NONE};
+                    double best_weight {0};
+                    accumulator.for_each([&](const std::size_t part, const double weight) {
+                        if (part == current) {
+                            internal = weight;
+                        } else if (part_weights[part] + weights[v] <= capacity
+                                   && (best == NONE || weight > best_weight || (weight == best_weight && part_weights[part] < part_weights[best]))) {
+                            best = part;
+                            best_weight = weight;
+                        }
+                    });
+
+                    const bool overweight {part_weights[current] > capacity};
+                    if (overweight && best == NONE) {
+                        const std::size_t lightest {static_cast<std::size_t>(std::ranges::min_element(part_weights) - part_weights.begin())};
+                        if (part_weights[lightest] + weights[v] <= capacity) {
+                            best = lightest;
+                        }
+                    }
+                    if (best == NONE) {
+                        continue;
+                    }
+                    if (overweight || best_weight > internal || (best_weight == internal && part_weights[best] + weights[v] < part_weights[current])) {
+                        part_weights[current] -= weights[v];
+                        part_weights[best] += weights[v];
+                        labels[v] = best;
+                        ++moves;
+                    }
+                }
+                total_moves += moves;
+                if (moves == 0) {
+                    break;
+                }
+            }
+            return total_moves;
+        }
+
+        inline Partitioning finish_partitioning(const FrozenGraph& graph, std::vector<std::size_t> parts, const std::size_t count) {
+            Partitioning result {};
+            result.parts = std::move(parts);
+            result.count = count;
+            result.sizes.assign(count, 0);
+            for (std::size_t v {0}; v < graph.vertex_count(); ++v) {
+                ++result.sizes[result.parts[v]];
+                for (const std::size_t child : graph.children(v)) {
+                    if (result.parts[child] != result.parts[v]) {
+                        ++result.cut_edges;
+                    }
+                }
+            }
+            if (graph.vertex_count() != 0) {
+                result.imbalance = static_cast<double>(*std::ranges::max_element(result.sizes)) * static_cast<double>(count)
+                                   / static_cast<double>(graph.vertex_count());
+            }
+            return result;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Sizes, edge cut and imbalance of a given assignment.
+     *
+     * @param graph Frozen graph.
+     * @param parts Part of every dense vertex index.
+     * @param count Number of parts.
+     * @return Result containing the partitioning, or `INVALID_ARGUMENT` if `parts` does not have one entry per vertex
+     *         or names a part outside `0 .. count - 1`.
+     */
+    inline Result<Partitioning, ErrorType> evaluate_partitioning(const FrozenGraph& graph, std::span<const std::size_t> parts, const std::size_t count) {
+        if (parts.size() != graph.vertex_count() || std::ranges::any_of(parts, [&](const std::size_t part) { return part >= count; })) {
+            return Result<Partitioning, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        return Result<Partitioning, ErrorType>::success(detail::finish_partitioning(graph, {parts.begin(), parts.end()}, count));
+    }
+
+    /**
+     * @brief One pass LDG or Fennel partitioning in dense index order.
+     *
+     * A vertex counts its children and parents placed before it. Ties go to the smaller part, then the lower index.
+     *
+     * @param graph Frozen graph.
+     * @param options Parts, heuristic and balance.
+     * @param tracer Receives a `partition.stream` span. See `tracing.hpp`.
+     * @return Result containing the partitioning, or `INVALID_ARGUMENT` for zero parts, `max_imbalance < 1` or a Fennel
+     *         `gamma <= 1`.
+     */
+    template <typename Tracer = NoTracer>
+    Result<Partitioning, ErrorType> streaming_partition(const FrozenGraph& graph, const StreamingPartitionOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        if (options.parts == 0 || !(options.max_imbalance >= 1.0) || (options.heuristic == StreamingHeuristic::FENNEL && !(options.gamma > 1.0))) {
+            return Result<Partitioning, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const detail::TraceSpan span {tracer, "partition.stream"};
+        constexpr std::size_t NONE {std::numeric_limits<std::size_t>::max()};
+        const std::size_t n {graph.vertex_count()};
+        const std::size_t k {options.parts};
+        const std::size_t capacity {detail::part_capacity(n, k, options.max_imbalance)};
+        const double alpha {n == 0 ? 0.0 : static_cast<double>(graph.edge_count()) * std::pow(static_cast<double>(k), options.gamma - 1.0)
+                                               / std::pow(static_cast<double>(n), options.gamma)};
+
+        std::vector<std::size_t> parts(n, NONE);
+        std::vector<std::size_t> sizes(k, 0);
+        std::vector<std::size_t> neighbours(k, 0);
+        std::vector<std::size_t> touched {};
+        for (std::size_t v {0}; v < n; ++v) {
+            auto count = [&](std::span<const std::size_t> adjacent) {
+                for (const std::size_t u : adjacent) {
+                    if (parts[u] != NONE && neighbours[parts[u]]++ == 0) {
+                        touched.push_back(parts[u]);
+                    }
+                }
+            };
+            count(graph.children(v));
+            count(graph.parents(v));
+
+            // Parts without placed neighbours all score by size alone, so only the smallest of them is a candidate.
+            std::size_t best {static_cast<std::size_t>(std::ranges::min_element(sizes) - sizes.begin())};
+            auto score = [&](const std::size_t part) {
+                const auto size {static_cast<double>(sizes[part])};
+                if (options.heuristic == StreamingHeuristic::LDG) {
+                    return static_cast<double>(neighbours[part]) * (1.0 - size / static_cast<double>(capacity));
+                }
+                return static_cast<double>(neighbours[part]) - alpha * options.gamma * std::pow(size, options.gamma - 1.0);
+            };
+            double best_score {score(best)};
+            for (const std::size_t part : touched) {
+                if (sizes[part] >= capacity) {
+                    continue;
+                }
+                const double candidate {score(part)};
+                if (candidate > best_score || (candidate == best_score && (sizes[part] < sizes[best] || (sizes[part] == sizes[best] && part < best)))) {
+                    best = part;
+                    best_score = candidate;
+                }
+            }
+            parts[v] = best;
+            ++sizes[best];
+            for (const std::size_t part : touched) {
+                neighbours[part] = 0;
+            }
+            touched.clear();
+        }
+        return Result<Partitioning, ErrorType>::success(detail::finish_partitioning(graph, std::move(parts), k));
+    }
+
+    /**
+     * @brief METIS style multilevel partitioning: heavy edge matching, greedy growing and boundary refinement.
+     *
+     * With `threads = 1` the result is deterministic for a given seed.
+     *
+     * @param graph Frozen graph.
+     * @param options Parts, balance, refinement, seed and workers.
+     * @param tracer Receives `partition.coarsen`, `partition.initial` and per level `partition.refine` spans, the
+     *        vertex count of every coarse level as `partition.coarse_vertices` and the moves per level as
+     *        `partition.moves`. See `tracing.hpp`.
+     * @return Result containing the partitioning, or `INVALID_ARGUMENT` for zero parts or `max_imbalance < 1`.
+     */
+    template <typename Tracer = NoTracer>
+    Result<Partitioning, ErrorType> multilevel_partition(const FrozenGraph& graph, const MultilevelPartitionOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        if (options.parts == 0 || !(options.max_imbalance >= 1.0)) {
+            return Result<Partitioning, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const std::size_t n {graph.vertex_count()};
+        const std::size_t k {options.parts};
+        const std::size_t capacity {detail::part_capacity(n, k, options.max_imbalance)};
+        std::mt19937_64 random {options.seed};
+        detail::WeightAccumulator accumulator {};
+
+        // levels[0] is the symmetrized input; matchings[i] maps the vertices of level i to those of level i + 1.
+        std::vector<detail::CommunityGraph> levels {};
+        std::vector<std::vector<std::size_t>> weights {};
+        std::vector<std::vector<std::size_t>> matchings {};
+        levels.push_back(detail::symmetrize(AdjacencyMatrix<double>::pattern(graph, 1.0)).consume_ok());
+        weights.emplace_back(n, 1);
+        {
+            const detail::TraceSpan span {tracer, "partition.coarsen"};
+            const std::size_t coarsest {std::max<std::size_t>(16 * k, 64)};
+            const std::size_t max_weight {std::max<std::size_t>(1, (3 * n) / (2 * coarsest))};
+            while (levels.back().size() > coarsest) {
+                std::vector<std::size_t> labels {};
+                const std::size_t count {detail::heavy_edge_matching(levels.back(), weights.back(), max_weight, labels, random, accumulator)};
+                // Matching stalls on stars and isolated vertices; stop once a level barely shrinks.
+                if (10 * count > 9 * levels.back().size()) {
+                    break;
+                }
+                std::vector<std::size_t> coarse_weights(count, 0);
+                for (std::size_t v {0}; v < labels.size(); ++v) {
+                    coarse_weights[labels[v]] += weights.back()[v];
+                }
+                detail::CommunityGraph coarse {detail::coarsen(levels.back(), labels, count, options.threads)};
+                matchings.push_back(std::move(labels));
+                levels.push_back(std::move(coarse));
+                weights.push_back(std::move(coarse_weights));
+                detail::trace_counter(tracer, "partition.coarse_vertices", static_cast<double>(count));
+            }
+        }
+
+        std::vector<std::size_t> parts {};
+        std::vector<std::size_t> part_weights {};
+        {
+            const detail::TraceSpan span {tracer, "partition.initial"};
+            detail::grow_partition(levels.back(), weights.back(), k, capacity, parts, part_weights);
+        }
+        for (std::size_t level {levels.size()}; level-- > 0;) {
+            const detail::TraceSpan span {tracer, "partition.refine"};
+            if (level + 1 < levels.size()) {
+                std::vector<std::size_t> finer(levels[level].size());
+                for (std::size_t v {0}; v < finer.size(); ++v) {
+                    finer[v] = parts[matchings[level][v]];
+                }
+                parts = std::move(finer);
+            }
+            const std::size_t moves {detail::refine_partition(levels[level], weights[level], capacity, options.refinement_sweeps, parts, part_weights,
+                                                              random, accumulator)};
+            detail::trace_counter(tracer, "partition.moves", static_cast<double>(moves));
+        }
+        return Result<Partitioning, ErrorType>::success(detail::finish_partitioning(graph, std::move(parts), k));
+    }
+
+    /**
+     * @brief The vertices one part owns, its ghosts, and the adjacency of the owned vertices in local indices.
+     *
+     * Local indices `0 .. owned_count() - 1` are the owned vertices and the rest are ghosts, each range in increasing
+     * dense index order.
+     */
+    class GraphPartition {
+    private:
+        friend class PartitionedGraph;
+
+        std::size_t id {0};
+        std::size_t owned {0};
+        std::vector<std::size_t> globals{};         // local -> dense index
+        std::vector<std::size_t> ghost_owners{};    // ghost position -> owning part
+        std::vector<std::size_t> out_offsets{};
+        std::vector<std::size_t> out_targets{};
+        std::vector<std::size_t> out_edge_ids{};
+        std::vector<std::size_t> in_offsets{};
+        std::vector<std::size_t> in_sources{};
+        std::vector<std::size_t> in_edge_ids{};
+
+    public:
+        /**
+         * @brief Index of this part.
+         */
+        [[nodiscard]] std::size_t part() const {
+            return id;
+        }
+
+        /**
+         * @brief Number of owned vertices.
+         */
+        [[nodiscard]] std::size_t owned_count() const {
+            return owned;
+        }
+
+        /**
+         * @brief Number of ghost vertices.
+         */
+        [[nodiscard]] std::size_t ghost_count() const {
+            return globals.size() - owned;
+        }
+
+        /**
+         * @brief Number of owned and ghost vertices.
+         */
+        [[nodiscard]] std::size_t vertex_count() const {
+            return globals.size();
+        }
+
+        /**
+         * @brief Whether a local index is a ghost.
+         */
+        [[nodiscard]] bool is_ghost(const std::size_t local) const {
+            return local >= owned;
+        }
+
+        /**
+         * @brief Dense index in the frozen graph of a local index.
+         */
+        [[nodiscard]] std::size_t global_index(const std::size_t local) const {
+            return globals[local];
+        }
+
+        /**
+         * @brief Part owning a local index: this part for owned vertices.
+         */
+        [[nodiscard]] std::size_t owner(const std::size_t local) const {
+            return local < owned ? id : ghost_owners[local - owned];
+        }
+
+        /**
+         * @brief Local index of a dense index.
+         * @return Result containing the local index, or `ABSENT_VERTEX` if the vertex is neither owned nor a ghost.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> local_index(const std::size_t global) const {
+            for (const auto& [first, last] : {std::pair{std::size_t{0}, owned}, std::pair{owned, globals.size()}}) {
+                const auto begin {globals.begin() + static_cast<std::ptrdiff_t>(first)};
+                const auto end {globals.begin() + static_cast<std::ptrdiff_t>(last)};
+                if (const auto it {std::lower_bound(begin, end, global)}; it != end && *it == global) {
+                    return Result<std::size_t, ErrorType>::success(static_cast<std::size_t>(it - globals.begin()));
+                }
+            }
+            return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+        }
+
+        /**
+         * @brief Children of a local index as local indices. Empty for ghosts.
+         */
+        [[nodiscard]] std::span<const std::size_t> children(const std::size_t local) const {
+            return std::span<const std::size_t>{out_targets}.subspan(out_offsets[local], out_offsets[local + 1] - out_offsets[local]);
+        }
+
+        /**
+         * @brief Parents of a local index as local indices. Empty for ghosts.
+         */
+        [[nodiscard]] std::span<const std::size_t> parents(const std::size_t local) const {
+            return std::span<const std::size_t>{in_sources}.subspan(in_offsets[local], in_offsets[local + 1] - in_offsets[local]);
+        }
+
+        /**
+         * @brief Edge ids parallel to `children(local)`.
+         */
+        [[nodiscard]] std::span<const std::size_t> outgoing_edges(const std::size_t local) const {
+            return std::span<const std::size_t>{out_edge_ids}.subspan(out_offsets[local], out_offsets[local + 1] - out_offsets[local]);
+        }
+
+        /**
+         * @brief Edge ids parallel to `parents(local)`.
+         */
+        [[nodiscard]] std::span<const std::size_t> incoming_edges(const std::size_t local) const {
+            return std::span<const std::size_t>{in_edge_ids}.subspan(in_offsets[local], in_offsets[local + 1] - in_offsets[local]);
+        }
+    };
+
+    /**
+     * @brief A frozen graph split into parts with local indices and ghost vertices.
+     *
+     * The view refers to the frozen graph, which must outlive it.
+     */
+    class PartitionedGraph {
+    private:
+        const FrozenGraph* graph;
+        std::vector<std::size_t> owners{};
+        std::vector<GraphPartition> partitions{};
+
+        explicit PartitionedGraph(const FrozenGraph& graph) : graph{&graph} {}
+
+    public:
+        /**
+         * @brief Split a frozen graph, building the parts in parallel.
+         *
+         * @param graph Frozen graph.
+         * @param partitioning Assignment of the vertices, e.g. from `multilevel_partition`.
+         * @param threads Workers, 0 for one per hardware thread.
+         * @return Result containing the view, or `INVALID_ARGUMENT` if the partitioning does not fit the graph.
+         */
+        static Result<PartitionedGraph, ErrorType> build(const FrozenGraph& graph, const Partitioning& partitioning, const std::size_t threads = 0) {
+            const std::size_t n {graph.vertex_count()};
+            const std::size_t k {partitioning.count};
+            if (partitioning.parts.size() != n || std::ranges::any_of(partitioning.parts, [&](const std::size_t part) { return part >= k; })) {
+                return Result<PartitionedGraph, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            PartitionedGraph view {graph};
+            view.owners = partitioning.parts;
+            view.partitions.resize(k);
+
+            // Owned vertices of every part by counting sort, and the local index of every vertex within its owner.
+            std::vector<std::size_t> local_of(n);
+            for (std::size_t v {0}; v < n; ++v) {
+                GraphPartition& partition {view.partitions[view.owners[v]]};
+                local_of[v] = partition.globals.size();
+                partition.globals.push_back(v);
+            }
+
+            parallel_for(k, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                for (std::size_t p {begin}; p < end; ++p) {
+                    GraphPartition& partition {view.partitions[p]};
+                    partition.id = p;
+                    partition.owned = partition.globals.size();
+                    for (std::size_t i {0}; i < partition.owned; ++i) {
+                        for (const auto adjacent : {graph.children(partition.globals[i]), graph.parents(partition.globals[i])}) {
+                            for (const std::size_t u : adjacent) {
+                                if (view.owners[u] != p) {
+                                    partition.globals.push_back(u);
+                                }
+                            }
+                        }
+                    }
+                    std::sort(partition.globals.begin() + static_cast<std::ptrdiff_t>(partition.owned), partition.globals.end());
+                    partition.globals.erase(std::unique(partition.globals.begin() + static_cast<std::ptrdiff_t>(partition.owned), partition.globals.end()),
+                                            partition.globals.end());
+                    const auto ghosts_begin {partition.globals.begin() + static_cast<std::ptrdiff_t>(partition.owned)};
+                    for (auto it {ghosts_begin}; it != partition.globals.end(); ++it) {
+                        partition.ghost_owners.push_back(view.owners[*it]);
+                    }
+
+                    auto local = [&](const std::size_t u) {
+                        if (view.owners[u] == p) {
+                            return local_of[u];
+                        }
+                        return static_cast<std::size_t>(std::lower_bound(ghosts_begin, partition.globals.end(), u) - partition.globals.begin());
+                    };
+                    auto fill = [&](std::vector<std::size_t>& offsets, std::vector<std::size_t>& neighbours, std::vector<std::size_t>& edge_ids,
+                                    const bool forward) {
+                        offsets.assign(partition.globals.size() + 1, 0);
+                        for (std::size_t i {0}; i < partition.owned; ++i) {
+                            const std::size_t v {partition.globals[i]};
+                            const auto adjacent {forward ? graph.children(v) : graph.parents(v)};
+                            const auto edges {forward ? graph.outgoing_edges(v) : graph.incoming_edges(v)};
+                            for (std::size_t slot {0}; slot < adjacent.size(); ++slot) {
+                                neighbours.push_back(local(adjacent[slot]));
+                                edge_ids.push_back(edges[slot]);
+                            }
+                            offsets[i + 1] = neighbours.size();
+                        }
+                        std::fill(offsets.begin() + static_cast<std::ptrdiff_t>(partition.owned) + 1, offsets.end(), neighbours.size());
+                    };
+                    fill(partition.out_offsets, partition.out_targets, partition.out_edge_ids, true);
+                    fill(partition.in_offsets, partition.in_sources, partition.in_edge_ids, false);
+                }
+            }, threads, 1);
+            return Result<PartitionedGraph, ErrorType>::success(std::move(view));
+        }
+
+        /**
+         * @brief Number of parts.
+         */
+        [[nodiscard]] std::size_t partition_count() const {
+            return partitions.size();
+        }
+
+        /**
+         * @brief One part.
+         */
+        [[nodiscard]] const GraphPartition& partition(const std::size_t part) const {
+            return partitions[part];
+        }
+
+        /**
+         * @brief Part owning a dense index.
+         */
+        [[nodiscard]] std::size_t owner(const std::size_t index) const {
+            return owners[index];
+        }
+
+        /**
+         * @brief The frozen graph the view splits.
+         */
+        [[nodiscard]] const FrozenGraph& frozen_graph() const {
+            return *graph;
+        }
+    };
+}
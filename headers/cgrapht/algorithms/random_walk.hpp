@@ -0,0 +1,312 @@
+/**
+ * @file random_walk.hpp
+ *
+ * @brief Batched parallel random walks: uniform, weighted and node2vec.
+ *
+ * @Detail
+ * `RandomWalker` generates walks over a `FrozenGraph` for embedding training (DeepWalk, node2vec). It is built once,
+ * then asked for any number of walks:
+ *
+ * - `RandomWalker::uniform(frozen)` picks every outgoing edge with equal probability.
+ * - `RandomWalker::weighted(weights)` picks edges proportionally to their weight. Every vertex gets an alias table
+ *   over its outgoing edges when the walker is built, so each step is O(1).
+ * - Setting `WalkOptions::return_parameter` (p) or `WalkOptions::in_out_parameter` (q) makes the walks second order
+ *   as in node2vec: stepping from `v` (having come from `t`) to `x` is biased by `1/p` if `x == t`, by 1 if `t -> x`
+ *   is an edge and by `1/q` otherwise. Steps are drawn from the first order distribution and accepted with
+ *   probability bias / max bias (rejection sampling as in KnightKing), so no per-edge-pair tables are needed.
+ *
+ * Walks are generated in batches of `WalkOptions::batch_size`, spread over the workers. Every batch has its own random
+ * generator, seeded from `WalkOptions::seed` and the batch number, so the walks do not depend on the number of
+ * workers. Completed batches are handed to a sink as one contiguous buffer of `length + 1` vertex ids per walk, padded
+ * with `WALK_END` where a walk reached a vertex without outgoing edges, and are never collected by the walker.
+ *
+ * ```cpp
+ * const RandomWalker walker {RandomWalker::uniform(frozen)};
+ * const WalkOptions options {.length = 40, .walks_per_vertex = 10};
+ * std::vector<std::size_t> walks(walker.walk_count(options) * (options.length + 1));
+ * walker.walk(options, [&](const std::size_t first_walk, const std::span<const std::size_t> batch) {
+ *     std::ranges::copy(batch, walks.begin() + first_walk * (options.length + 1));
+ * });
+ * ```
+ *
+ * Reference: Grover and Leskovec, "node2vec: Scalable Feature Learning for Networks", 2016; Yang et al., "KnightKing:
+ * A Fast Distributed Graph Random Walk Engine", 2019.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Padding after the last vertex of a walk that stopped early.
+     */
+    inline constexpr std::size_t WALK_END {std::numeric_limits<std::size_t>::max()};
+
+    /**
+     * @brief Options for `RandomWalker::walk`.
+     */
+    struct WalkOptions {
+        std::size_t length {80};            ///< Steps per walk; walks hold `length + 1` vertices.
+        std::size_t walks_per_vertex {10};  ///< Walks started from every start vertex.
+        double return_parameter {1.0};      ///< node2vec p, the bias against stepping back is `1/p`.
+        double in_out_parameter {1.0};      ///< node2vec q, the bias towards moving away is `1/q`.
+        std::uint64_t seed {0x5eed};
+        std::size_t batch_size {1024};      ///< Walks per sink call.
+        std::size_t threads {0};            ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Sink writing walks to a stream, one walk per line with its vertex ids separated by spaces.
+     *
+     * Batches are written whole under a lock, in completion order.
+     */
+    class WalkStreamWriter {
+    private:
+        std::ostream* out;
+        std::size_t stride;
+        std::mutex mutex {};
+
+    public:
+        /**
+         * @param out Stream to write to.
+         * @param options Options the walks are generated with.
+         */
+        WalkStreamWriter(std::ostream& out, const WalkOptions& options) : out{&out}, stride{options.length + 1} {}
+
+        void operator()(std::size_t, const std::span<const std::size_t> batch) {
+            const std::scoped_lock lock {mutex};
+            for (std::size_t begin {0}; begin < batch.size(); begin += stride) {
+                for (std::size_t i {begin}; i < begin + stride && batch[i] != WALK_END; ++i) {
+                    *out << (i == begin ? "" : " ") << batch[i];
+                }
+                *out << '\n';
+            }
+        }
+    };
+
+    /**
+     * @brief Random walk generator over a frozen graph.
+     *
+     * The walker refers to the frozen graph, which must outlive it.
+     */
+    class RandomWalker {
+    private:
+        const FrozenGraph* graph;
+        std::vector<double> probability{};      // alias tables aligned with the CSR slots, empty for uniform walks
+        std::vector<std::uint32_t> alias{};     // slot offset within the row
+
+        explicit RandomWalker(const FrozenGraph& graph) : graph{&graph} {}
+
+        // Vose's alias method over one row.
+        static void build_alias(std::span<const double> weights, std::span<double> probability, std::span<std::uint32_t> alias,
+                                std::vector<std::uint32_t>& small, std::vector<std::uint32_t>& large) {
+            const std::size_t degree {weights.size()};
+            double total {0};
+            for (const double weight : weights) {
+                total += weight;
+            }
+            small.clear();
+            large.clear();
+            for (std::size_t i {0}; i < degree; ++i) {
+                probability[i] = total > 0 ? weights[i] * static_cast<double>(degree) / total : 1.0;
+                alias[i] = static_cast<std::uint32_t>(i);
+                (probability[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+            }
+            while (!small.empty() && !large.empty()) {
+                const std::uint32_t less {small.back()};
+                const std::uint32_t more {large.back()};
+                small.pop_back();
+                alias[less] = more;
+                probability[more] -= 1.0 - probability[less];
+                if (probability[more] < 1.0) {
+                    large.pop_back();
+                    small.push_back(more);
+                }
+            }
+            // Whatever is left is 1 up to rounding.
+            for (const std::uint32_t i : small) {
+                probability[i] = 1.0;
+            }
+            for (const std::uint32_t i : large) {
+                probability[i] = 1.0;
+            }
+        }
+
+        // Dense index of a first order step from `current`, which has at least one outgoing edge.
+        std::size_t step(const std::size_t current, std::mt19937_64& random) const {
+            const std::size_t begin {graph->outgoing_offsets()[current]};
+            const std::size_t degree {graph->out_degree(current)};
+            std::size_t slot {std::uniform_int_distribution<std::size_t>{0, degree - 1}(random)};
+            if (!probability.empty() && std::uniform_real_distribution<double>{0.0, 1.0}(random) >= probability[begin + slot]) {
+                slot = alias[begin + slot];
+            }
+            return graph->outgoing_targets()[begin + slot];
+        }
+
+        template <typename Sink>
+        void walk_batches(std::span<const std::size_t> starts, const WalkOptions& options, Sink& sink) const {
+            const std::size_t stride {options.length + 1};
+            const std::size_t walks {starts.size() * options.walks_per_vertex};
+            const std::size_t batch_size {std::max<std::size_t>(options.batch_size, 1)};
+            const std::size_t batches {(walks + batch_size - 1) / batch_size};
+            const bool second_order {options.return_parameter != 1.0 || options.in_out_parameter != 1.0};
+            const double return_bias {1.0 / options.return_parameter};
+            const double away_bias {1.0 / options.in_out_parameter};
+            const double max_bias {std::max({return_bias, 1.0, away_bias})};
+            std::vector<std::vector<std::size_t>> buffers(worker_count(options.threads));
+
+            parallel_for(batches, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+                std::vector<std::size_t>& buffer {buffers[worker]};
+                for (std::size_t batch {begin}; batch < end; ++batch) {
+                    std::seed_seq seed {options.seed & 0xffffffffU, options.seed >> 32, static_cast<std::uint64_t>(batch)};
+                    std::mt19937_64 random {seed};
+                    std::uniform_real_distribution<double> coin {0.0, max_bias};
+                    const std::size_t first {batch * batch_size};
+                    const std::size_t count {std::min(batch_size, walks - first)};
+                    buffer.assign(count * stride, WALK_END);
+
+                    for (std::size_t w {0}; w < count; ++w) {
+                        // Walks are numbered round by round: walk `r * starts + s` is the `r`-th from `starts[s]`.
+                        std::size_t* out {buffer.data() + w * stride};
+                        std::size_t previous {WALK_END};
+                        std::size_t current {starts[(first + w) % starts.size()]};
+                        out[0] = graph->vertex_id(current);
+                        for (std::size_t s {1}; s < stride && graph->out_degree(current) != 0; ++s) {
+                            std::size_t next {step(current, random)};
+                            if (second_order && previous != WALK_END) {
+                                const auto around {graph->children(previous)};
+                                for (;;) {
+                                    const double bias {next == previous ? return_bias
+                                                       : std::binary_search(around.begin(), around.end(), next) ? 1.0
+                                                                                                                 : away_bias};
+                                    if (coin(random) < bias) {
+                                        break;
+                                    }
+                                    next = step(current, random);
+                                }
+                            }
+                            previous = current;
+                            current = next;
+                            out[s] = graph->vertex_id(current);
+                        }
+                    }
+                    sink(first, std::span<const std::size_t>{buffer});
+                }
+            }, options.threads, 1);
+        }
+
+    public:
+        /**
+         * @brief Walker picking outgoing edges uniformly.
+         * @param graph Frozen graph to walk.
+         */
+        static RandomWalker uniform(const FrozenGraph& graph) {
+            return RandomWalker{graph};
+        }
+
+        /**
+         * @brief Walker picking outgoing edges proportionally to their weight, with one alias table per vertex.
+         *
+         * Vertices whose outgoing weights are all zero pick uniformly.
+         *
+         * @param weights Edge weights, e.g. from `AdjacencyMatrix<double>::weighted`.
+         * @param threads Workers building the tables, 0 for one per hardware thread.
+         * @return Result containing the walker, or `INVALID_ARGUMENT` if a weight is negative or not finite.
+         */
+        static Result<RandomWalker, ErrorType> weighted(const AdjacencyMatrix<double>& weights, const std::size_t threads = 0) {
+            const FrozenGraph& graph {weights.frozen_graph()};
+            const std::span<const double> values {weights.row_values()};
+            if (std::ranges::any_of(values, [](const double weight) { return !(weight >= 0.0 && std::isfinite(weight)); })) {
+                return Result<RandomWalker, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            RandomWalker walker {graph};
+            walker.probability.resize(values.size());
+            walker.alias.resize(values.size());
+            const auto offsets {graph.outgoing_offsets()};
+            parallel_for(graph.vertex_count(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                std::vector<std::uint32_t> small {};
+                std::vector<std::uint32_t> large {};
+                for (std::size_t i {begin}; i < end; ++i) {
+                    const std::size_t first {offsets[i]};
+                    const std::size_t degree {graph.out_degree(i)};
+                    build_alias(values.subspan(first, degree), std::span<double>{walker.probability}.subspan(first, degree),
+                                std::span<std::uint32_t>{walker.alias}.subspan(first, degree), small, large);
+                }
+            }, threads);
+            return Result<RandomWalker, ErrorType>::success(std::move(walker));
+        }
+
+        /**
+         * @brief The frozen graph being walked.
+         */
+        [[nodiscard]] const FrozenGraph& frozen_graph() const {
+            return *graph;
+        }
+
+        /**
+         * @brief Number of walks `walk(options, sink)` generates.
+         */
+        [[nodiscard]] std::size_t walk_count(const WalkOptions& options) const {
+            return graph->vertex_count() * options.walks_per_vertex;
+        }
+
+        /**
+         * @brief Generate walks from the given start vertices.
+         *
+         * @param start_ids Vertex ids to start from.
+         * @param options Walk shape, node2vec parameters, seed, batching and workers.
+         * @param sink Called as `sink(first_walk, batch)` once per batch, where `batch` holds walks `first_walk`
+         *        onwards, `options.length + 1` vertex ids each, and is only valid during the call. With several workers
+         *        it is called concurrently and must be thread safe. See `WalkStreamWriter`.
+         * @param tracer Receives a `random_walk` span and a `random_walk.walks` counter. See `tracing.hpp`.
+         * @return Result containing the number of walks generated, `ABSENT_VERTEX` for an unknown start, or
+         *         `INVALID_ARGUMENT` if p or q is not positive.
+         */
+        template <typename Sink, typename Tracer = NoTracer>
+        Result<std::size_t, ErrorType> walk(std::span<const std::size_t> start_ids, const WalkOptions& options, Sink&& sink, Tracer&& tracer = Tracer{}) const {
+            if (!(options.return_parameter > 0.0 && options.in_out_parameter > 0.0)) {
+                return Result<std::size_t, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            std::vector<std::size_t> starts {};
+            starts.reserve(start_ids.size());
+            for (const std::size_t id : start_ids) {
+                auto index = graph->index_of(id);
+                if (!index.is_ok()) {
+                    return Result<std::size_t, ErrorType>::error(index.get_error());
+                }
+                starts.push_back(index.get_ok());
+            }
+            const detail::TraceSpan span {tracer, "random_walk"};
+            walk_batches(starts, options, sink);
+            detail::trace_counter(tracer, "random_walk.walks", static_cast<double>(starts.size() * options.walks_per_vertex));
+            return Result<std::size_t, ErrorType>::success(starts.size() * options.walks_per_vertex);
+        }
+
+        /**
+         * @brief Generate walks from every vertex, `walk_count(options)` in total.
+         *
+         * Same as the overload taking start ids with all vertex ids in dense index order.
+         */
+        template <typename Sink, typename Tracer = NoTracer>
+        Result<std::size_t, ErrorType> walk(const WalkOptions& options, Sink&& sink, Tracer&& tracer = Tracer{}) const {
+            return walk(graph->get_vertex_ids(), options, std::forward<Sink>(sink), std::forward<Tracer>(tracer));
+        }
+    };
+}
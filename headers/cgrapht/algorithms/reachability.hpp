@@ -0,0 +1,307 @@
+/**
+ * @file reachability.hpp
+ *
+ * @brief Reachability index for directed acyclic graphs (GRAIL).
+ *
+ * @Detail
+ * Answering "can `u` reach `v`" with a fresh traversal costs O(V + E) per query. `ReachabilityIndex` precomputes a
+ * handful of randomized interval labelings instead. Every labeling assigns each vertex an interval
+ * `[low, post]`, where `post` is its rank in a post-order DFS and `low` is the smallest rank among its descendants.
+ * If `u` reaches `v` then the interval of `v` is contained in the interval of `u` in every labeling, so a single
+ * non-contained interval proves that `v` is unreachable without touching the graph. The first labeling also keeps
+ * DFS pre-order ranks, which proves reachability for descendants in its DFS spanning tree. Only queries that neither
+ * test settles fall back to a DFS, and that DFS skips every child whose intervals rule out the target.
+ *
+ * The labelings are independent, so they are built concurrently.
+ *
+ * Reference: Yildirim, Chaoji and Zaki, "GRAIL: Scalable Reachability Index for Large Graphs", VLDB 2010.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/detail/epoch_stamps.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Parameters for building a `ReachabilityIndex`.
+     */
+    struct ReachabilityOptions {
+        std::size_t labelings {5};      ///< Number of interval labelings. More labelings prune more queries but cost memory.
+        std::uint64_t seed {0x5eed};    ///< Seed for the randomized DFS orders.
+        std::size_t threads {0};        ///< Build workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Interval-labeling reachability index over a frozen DAG.
+     *
+     * Queries are read only and may run concurrently from several threads.
+     */
+    class ReachabilityIndex {
+    private:
+        struct Interval {
+            std::uint32_t low;
+            std::uint32_t post;
+        };
+
+        FrozenGraph graph;
+        std::size_t labelings {};
+        std::vector<Interval> intervals{};       // labelings consecutive entries per vertex
+        std::vector<std::uint32_t> tree_pre{};   // pre-order rank in the first labeling's DFS tree
+        std::vector<std::uint32_t> levels{};     // longest distance from a source, strictly increasing along edges
+
+        ReachabilityIndex(FrozenGraph graph, const std::size_t labelings) : graph{std::move(graph)}, labelings{labelings} {}
+
+        [[nodiscard]] bool contains(const std::size_t outer, const std::size_t inner) const {
+            const Interval* a {&intervals[outer * labelings]};
+            const Interval* b {&intervals[inner * labelings]};
+            for (std::size_t i {0}; i < labelings; ++i) {
+                if (b[i].low < a[i].low || b[i].post > a[i].post) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool tree_descendant(const std::size_t ancestor, const std::size_t descendant) const {
+            return tree_pre[ancestor] <= tree_pre[descendant] && intervals[descendant * labelings].post <= intervals[ancestor * labelings].post;
+        }
+
+        void label(std::size_t labeling, std::uint64_t seed);
+
+        static std::vector<std::uint32_t> topological_levels(const FrozenGraph& graph);
+
+    public:
+        /**
+         * @brief Build an index.
+         * @param graph Frozen graph to index. The index takes ownership of the snapshot.
+         * @param options Build parameters.
+         * @param tracer Receives the `reachability.levels` and `reachability.labeling` phase spans. See `tracing.hpp`.
+         * @return Result containing the index, `CYCLE_DETECTED` if the graph has a cycle, or `INVALID_ARGUMENT` if
+         *         `options.labelings` is 0.
+         */
+        template <typename Tracer = NoTracer>
+        static Result<ReachabilityIndex, ErrorType> build(FrozenGraph graph, const ReachabilityOptions& options = {}, Tracer&& tracer = Tracer{});
+
+        /**
+         * @brief Check whether `to_id` is reachable from `from_id` along directed edges.
+         *
+         * Every vertex reaches itself.
+         *
+         * @param from_id Source vertex id.
+         * @param to_id Target vertex id.
+         * @return Result containing the answer or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<bool, ErrorType> reachable(std::size_t from_id, std::size_t to_id) const;
+
+        /**
+         * @brief Dense index variant of `reachable`.
+         * @param from Dense index of the source.
+         * @param to Dense index of the target.
+         */
+        [[nodiscard]] bool reachable_index(std::size_t from, std::size_t to) const;
+
+        /**
+         * @brief The indexed snapshot.
+         */
+        [[nodiscard]] const FrozenGraph& frozen_graph() const {
+            return graph;
+        }
+
+        /**
+         * @brief Number of interval labelings.
+         */
+        [[nodiscard]] std::size_t labeling_count() const {
+            return labelings;
+        }
+
+        /**
+         * @brief Memory held by the labels, excluding the frozen graph.
+         */
+        [[nodiscard]] std::size_t label_bytes() const {
+            return intervals.size() * sizeof(Interval) + (tree_pre.size() + levels.size()) * sizeof(std::uint32_t);
+        }
+    };
+
+    inline std::vector<std::uint32_t> ReachabilityIndex::topological_levels(const FrozenGraph& graph) {
+        const std::size_t n {graph.vertex_count()};
+        std::vector<std::size_t> pending(n);
+        std::vector<std::size_t> queue {};
+        queue.reserve(n);
+        for (std::size_t v {0}; v < n; ++v) {
+            pending[v] = graph.in_degree(v);
+            if (pending[v] == 0) {
+                queue.push_back(v);
+            }
+        }
+
+        std::vector<std::uint32_t> level(n, 0);
+        for (std::size_t head {0}; head < queue.size(); ++head) {
+            const std::size_t v {queue[head]};
+            for (const std::size_t child : graph.children(v)) {
+                level[child] = std::max(level[child], level[v] + 1);
+                if (--pending[child] == 0) {
+                    queue.push_back(child);
+                }
+            }
+        }
+
+        if (queue.size() != n) {
+            level.clear();
+        }
+        return level;
+    }
+
+    inline void ReachabilityIndex::label(const std::size_t labeling, const std::uint64_t seed) {
+        const std::size_t n {graph.vertex_count()};
+        std::mt19937_64 rng {seed + labeling};
+
+        std::vector<std::size_t> roots(n);
+        std::iota(roots.begin(), roots.end(), 0);
+        if (labeling != 0) {
+            std::ranges::shuffle(roots, rng);
+        }
+
+        // Children are visited starting at a random rotation, which randomizes the DFS without materializing per-vertex
+        // permutations.
+        auto rotation = [&](const std::size_t v, const std::size_t degree) -> std::size_t {
+            if (labeling == 0 || degree < 2) {
+                return 0;
+            }
+            return static_cast<std::size_t>((v * 0x9e3779b97f4a7c15ULL) ^ (seed * (labeling + 1))) % degree;
+        };
+
+        struct Frame {
+            std::size_t vertex;
+            std::size_t step;
+            std::size_t start;
+        };
+        std::vector<char> visited(n, 0);
+        std::vector<Frame> stack {};
+        std::uint32_t pre_rank {1};
+        std::uint32_t post_rank {1};
+
+        for (const std::size_t root : roots) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = 1;
+            stack.push_back({root, 0, rotation(root, graph.out_degree(root))});
+            if (labeling == 0) {
+                tree_pre[root] = pre_rank++;
+            }
+
+            while (!stack.empty()) {
+                Frame& frame {stack.back()};
+                const auto children {graph.children(frame.vertex)};
+                if (frame.step < children.size()) {
+                    const std::size_t child {children[(frame.start + frame.step++) % children.size()]};
+                    if (!visited[child]) {
+                        visited[child] = 1;
+                        if (labeling == 0) {
+                            tree_pre[child] = pre_rank++;
+                        }
+                        stack.push_back({child, 0, rotation(child, graph.out_degree(child))});
+                    }
+                    continue;
+                }
+
+                // All children are finished (the graph is acyclic), so their lows are final.
+                Interval& interval {intervals[frame.vertex * labelings + labeling]};
+                interval.post = post_rank++;
+                interval.low = interval.post;
+                for (const std::size_t child : children) {
+                    interval.low = std::min(interval.low, intervals[child * labelings + labeling].low);
+                }
+                stack.pop_back();
+            }
+        }
+    }
+
+    template <typename Tracer>
+    Result<ReachabilityIndex, ErrorType> ReachabilityIndex::build(FrozenGraph graph, const ReachabilityOptions& options, Tracer&& tracer) {
+        if (options.labelings == 0) {
+            return Result<ReachabilityIndex, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+
+        std::vector<std::uint32_t> levels {};
+        {
+            const detail::TraceSpan span {tracer, "reachability.levels"};
+            levels = topological_levels(graph);
+        }
+        if (levels.size() != graph.vertex_count()) {
+            return Result<ReachabilityIndex, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+        }
+
+        ReachabilityIndex index {std::move(graph), options.labelings};
+        const std::size_t n {index.graph.vertex_count()};
+        index.levels = std::move(levels);
+        index.intervals.assign(n * index.labelings, Interval{0, 0});
+        index.tree_pre.assign(n, 0);
+
+        // Each labeling writes a disjoint column of the interval table.
+        const detail::TraceSpan span {tracer, "reachability.labeling"};
+        parallel_for(index.labelings, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t labeling {begin}; labeling < end; ++labeling) {
+                index.label(labeling, options.seed);
+            }
+        }, options.threads, 1);
+
+        return Result<ReachabilityIndex, ErrorType>::success(std::move(index));
+    }
+
+    inline bool ReachabilityIndex::reachable_index(const std::size_t from, const std::size_t to) const {
+        if (from == to) {
+            return true;
+        }
+        if (levels[from] >= levels[to] || !contains(from, to)) {
+            return false;
+        }
+        if (tree_descendant(from, to)) {
+            return true;
+        }
+
+        thread_local detail::EpochStamps visited {};
+        thread_local std::vector<std::size_t> stack {};
+        visited.begin(graph.vertex_count());
+        stack.clear();
+        stack.push_back(from);
+        visited.visit(from);
+
+        while (!stack.empty()) {
+            const std::size_t v {stack.back()};
+            stack.pop_back();
+            for (const std::size_t child : graph.children(v)) {
+                if (child == to || tree_descendant(child, to)) {
+                    return true;
+                }
+                if (!visited.visited(child) && levels[child] < levels[to] && contains(child, to)) {
+                    visited.visit(child);
+                    stack.push_back(child);
+                }
+            }
+        }
+        return false;
+    }
+
+    inline Result<bool, ErrorType> ReachabilityIndex::reachable(const std::size_t from_id, const std::size_t to_id) const {
+        auto from = graph.index_of(from_id);
+        auto to = graph.index_of(to_id);
+        if (!from.is_ok() || !to.is_ok()) {
+            return Result<bool, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+        }
+        return Result<bool, ErrorType>::success(reachable_index(from.get_ok(), to.get_ok()));
+    }
+}
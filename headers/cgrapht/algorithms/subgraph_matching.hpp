@@ -0,0 +1,381 @@
+/**
+ * @file subgraph_matching.hpp
+ *
+ * @brief Enumerate the occurrences of a small pattern graph in a large graph.
+ *
+ * @Detail
+ * `match_subgraph` finds every mapping of the vertices of a pattern `DirectedGraph` onto vertices of a data graph such
+ * that every pattern edge `a -> b` has at least one data edge between the images of `a` and `b`, and vertex and edge
+ * payloads satisfy user predicates (e.g. same type). With `MatchSemantics::ISOMORPHISM` distinct pattern vertices map
+ * to distinct data vertices (subgraph monomorphism: the data may have extra edges among the matched vertices), with
+ * `MatchSemantics::HOMOMORPHISM` they need not.
+ *
+ * The search follows the VF2++ recipe with worst-case-optimal join style candidate generation:
+ * - Every pattern vertex first gets a candidate filter over the data vertices from its payload predicate and, for
+ *   isomorphisms, its degrees.
+ * - Pattern vertices are ordered by selectivity: the one with the fewest candidates first, then repeatedly the one
+ *   with the most edges to already ordered vertices, ties going to fewer candidates and higher degree.
+ * - The candidates of the next vertex are the intersection of the sorted neighbour spans (from the `FrozenGraph`) of
+ *   all its already matched neighbours, scanning the shortest span and binary searching the others.
+ * - The candidates of the first vertex are split across workers.
+ *
+ * Matches are handed to a callback as soon as they are found and never collected, so memory use is independent of
+ * the number of matches.
+ *
+ * Reference: Jüttner and Madarasi, "VF2++ - An improved subgraph isomorphism algorithm", 2018; Ngo et al.,
+ * "Worst-case optimal join algorithms", 2012.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief What counts as a match.
+     */
+    enum class MatchSemantics {
+        ISOMORPHISM,    ///< Injective: distinct pattern vertices map to distinct data vertices.
+        HOMOMORPHISM    ///< Pattern vertices may share a data vertex.
+    };
+
+    /**
+     * @brief Options for `match_subgraph`.
+     */
+    struct MatchOptions {
+        MatchSemantics semantics {MatchSemantics::ISOMORPHISM};
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Payload predicate accepting everything. Matching with it compares structure only and reads no payloads.
+     */
+    struct AnyMatch {
+        template <typename Pattern, typename Data>
+        constexpr bool operator()(const Pattern&, const Data&) const {
+            return true;
+        }
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        struct PatternConstraint {
+            std::size_t position;                   // order position of the matched neighbour
+            bool from_neighbour;                    // pattern edge runs neighbour -> vertex
+            std::vector<std::size_t> edge_ids{};    // pattern edges between the two, in this direction
+        };
+
+        struct MatchPlan {
+            std::vector<std::size_t> order{};                       // pattern dense index per position
+            std::vector<std::vector<PatternConstraint>> constraints{}; // per position, towards earlier positions
+            std::vector<std::vector<std::size_t>> self_loops{};     // per position, pattern self loop edge ids
+            std::vector<std::vector<std::uint8_t>> candidate{};     // per pattern dense index, over data dense indices
+        };
+
+        // Number of distinct values in a sorted span.
+        inline std::size_t distinct_count(const std::span<const std::size_t> sorted) {
+            std::size_t count {0};
+            for (std::size_t i {0}; i < sorted.size(); ++i) {
+                count += i == 0 || sorted[i] != sorted[i - 1];
+            }
+            return count;
+        }
+
+        /**
+         * Per worker search state.
+         */
+        struct MatchState {
+            std::vector<std::size_t> mapped{};                  // data dense index per position
+            std::vector<std::size_t> vertex_ids{};              // data vertex id per pattern dense index
+            std::vector<std::vector<std::size_t>> candidates{}; // scratch per position
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Stream every occurrence of `pattern` in `graph` to a callback.
+     *
+     * @param pattern Pattern graph, typically 3 to 6 vertices.
+     * @param graph Data graph holding the payloads.
+     * @param frozen Snapshot of `graph` used for the search.
+     * @param on_match Called as `on_match(std::span<const std::size_t> data_vertex_ids)` once per match, where entry
+     *        `i` is the image of the pattern vertex with the `i`-th smallest id. The span is only valid during the call.
+     *        With several workers it is called concurrently and must be thread safe. It may return `bool`; returning
+     *        false stops the search as soon as possible.
+     * @param options Semantics and workers.
+     * @param vertex_match Called as `vertex_match(const PV&, const V&)`; a data vertex can only host a pattern vertex
+     *        if it returns true.
+     * @param edge_match Called as `edge_match(const PE&, const E&)`; a pattern edge is matched if at least one data
+     *        edge between the images, in the same direction, satisfies it.
+     * @return Result containing the number of matches reported, or `INVALID_ARGUMENT` for an empty pattern.
+     */
+    template <Hashable PV, Hashable PE, typename PatternObserver, Hashable V, Hashable E, typename Observer, typename OnMatch,
+              typename VertexMatch = AnyMatch, typename EdgeMatch = AnyMatch>
+    Result<std::size_t, ErrorType> match_subgraph(const DirectedGraph<PV, PE, PatternObserver>& pattern, const DirectedGraph<V, E, Observer>& graph,
+                                                  const FrozenGraph& frozen, OnMatch&& on_match, const MatchOptions& options = {},
+                                                  VertexMatch vertex_match = {}, EdgeMatch edge_match = {}) {
+        const FrozenGraph shape {pattern};
+        const std::size_t k {shape.vertex_count()};
+        const std::size_t n {frozen.vertex_count()};
+        if (k == 0) {
+            return Result<std::size_t, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const bool injective {options.semantics == MatchSemantics::ISOMORPHISM};
+        detail::MatchPlan plan {};
+
+        // Candidate filters. Every data payload is fetched once and tested against all pattern vertices.
+        // An injective image needs at least as many distinct neighbours as the pattern vertex; parallel pattern
+        // edges may share one data edge, so they count once.
+        std::vector<PV> pattern_vertices {};
+        std::vector<std::size_t> distinct_children(k, 0);
+        std::vector<std::size_t> distinct_parents(k, 0);
+        for (std::size_t u {0}; u < k; ++u) {
+            pattern_vertices.push_back(pattern.get_vertex(shape.vertex_id(u)).get_ok());
+            distinct_children[u] = detail::distinct_count(shape.children(u));
+            distinct_parents[u] = detail::distinct_count(shape.parents(u));
+        }
+        plan.candidate.assign(k, std::vector<std::uint8_t>(n, 0));
+        parallel_for(n, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t d {begin}; d < end; ++d) {
+                std::optional<V> payload {};
+                if constexpr (!std::is_same_v<VertexMatch, AnyMatch>) {
+                    payload = graph.get_vertex(frozen.vertex_id(d)).get_ok();
+                }
+                for (std::size_t u {0}; u < k; ++u) {
+                    if (injective && (frozen.out_degree(d) < distinct_children[u] || frozen.in_degree(d) < distinct_parents[u])) {
+                        continue;
+                    }
+                    if constexpr (!std::is_same_v<VertexMatch, AnyMatch>) {
+                        if (!vertex_match(pattern_vertices[u], *payload)) {
+                            continue;
+                        }
+                    }
+                    plan.candidate[u][d] = 1;
+                }
+            }
+        }, options.threads);
+
+        std::vector<std::size_t> candidate_count(k, 0);
+        for (std::size_t u {0}; u < k; ++u) {
+            candidate_count[u] = static_cast<std::size_t>(std::ranges::count(plan.candidate[u], std::uint8_t{1}));
+        }
+
+        // Selectivity order.
+        std::vector<std::size_t> position_of(k, std::numeric_limits<std::size_t>::max());
+        auto degree = [&shape](const std::size_t u) {
+            return shape.out_degree(u) + shape.in_degree(u);
+        };
+        for (std::size_t p {0}; p < k; ++p) {
+            std::size_t best {k};
+            std::size_t best_links {0};
+            for (std::size_t u {0}; u < k; ++u) {
+                if (position_of[u] != std::numeric_limits<std::size_t>::max()) {
+                    continue;
+                }
+                std::size_t links {0};
+                for (const std::size_t w : shape.children(u)) {
+                    links += w != u && position_of[w] != std::numeric_limits<std::size_t>::max();
+                }
+                for (const std::size_t w : shape.parents(u)) {
+                    links += w != u && position_of[w] != std::numeric_limits<std::size_t>::max();
+                }
+                const bool better {best == k || links > best_links ||
+                                   (links == best_links && (candidate_count[u] < candidate_count[best] ||
+                                                            (candidate_count[u] == candidate_count[best] && degree(u) > degree(best))))};
+                if (better) {
+                    best = u;
+                    best_links = links;
+                }
+            }
+            position_of[best] = p;
+            plan.order.push_back(best);
+        }
+
+        // Constraints towards earlier positions, grouped per neighbour and direction.
+        plan.constraints.resize(k);
+        plan.self_loops.resize(k);
+        for (std::size_t p {0}; p < k; ++p) {
+            const std::size_t u {plan.order[p]};
+            auto add = [&](std::span<const std::size_t> neighbours, std::span<const std::size_t> edges, const bool from_neighbour) {
+                for (std::size_t slot {0}; slot < neighbours.size(); ++slot) {
+                    const std::size_t w {neighbours[slot]};
+                    if (w == u) {
+                        if (!from_neighbour) {
+                            plan.self_loops[p].push_back(edges[slot]);
+                        }
+                        continue;
+                    }
+                    if (position_of[w] > p) {
+                        continue;
+                    }
+                    auto& list {plan.constraints[p]};
+                    auto it {std::ranges::find_if(list, [&](const detail::PatternConstraint& c) {
+                        return c.position == position_of[w] && c.from_neighbour == from_neighbour;
+                    })};
+                    if (it == list.end()) {
+                        list.push_back(detail::PatternConstraint{position_of[w], from_neighbour});
+                        it = list.end() - 1;
+                    }
+                    it->edge_ids.push_back(edges[slot]);
+                }
+            };
+            add(shape.children(u), shape.outgoing_edges(u), false);
+            add(shape.parents(u), shape.incoming_edges(u), true);
+        }
+
+        // True if some data edge from -> to satisfies the pattern edge.
+        auto data_edge_matches = [&](const std::size_t pattern_edge, const std::size_t from, const std::size_t to) {
+            const auto children {frozen.children(from)};
+            const auto [first, last] = std::equal_range(children.begin(), children.end(), to);
+            if constexpr (std::is_same_v<EdgeMatch, AnyMatch>) {
+                (void)pattern_edge;
+                return first != last;
+            } else {
+                const PE wanted {pattern.get_edge(pattern_edge).get_ok().edge};
+                const auto edge_ids {frozen.outgoing_edges(from)};
+                for (auto it {first}; it != last; ++it) {
+                    if (edge_match(wanted, graph.get_edge(edge_ids[static_cast<std::size_t>(it - children.begin())]).get_ok().edge)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        };
+
+        std::vector<std::size_t> roots {};
+        for (std::size_t d {0}; d < n; ++d) {
+            if (plan.candidate[plan.order[0]][d]) {
+                roots.push_back(d);
+            }
+        }
+
+        std::atomic<std::size_t> matches {0};
+        std::atomic<bool> stopped {false};
+        std::vector<detail::MatchState> states(worker_count(options.threads));
+
+        // Whether data vertex x can take position p, given positions before p. Adjacency to the neighbours is
+        // already guaranteed by candidate generation, only payloads and self loops remain.
+        auto admissible = [&](const detail::MatchState& state, const std::size_t p, const std::size_t x) {
+            if (!plan.candidate[plan.order[p]][x]) {
+                return false;
+            }
+            if (injective && std::find(state.mapped.begin(), state.mapped.begin() + static_cast<std::ptrdiff_t>(p), x) != state.mapped.begin() + static_cast<std::ptrdiff_t>(p)) {
+                return false;
+            }
+            for (const std::size_t edge : plan.self_loops[p]) {
+                if (!data_edge_matches(edge, x, x)) {
+                    return false;
+                }
+            }
+            if constexpr (!std::is_same_v<EdgeMatch, AnyMatch>) {
+                for (const auto& constraint : plan.constraints[p]) {
+                    const std::size_t y {state.mapped[constraint.position]};
+                    for (const std::size_t edge : constraint.edge_ids) {
+                        if (!(constraint.from_neighbour ? data_edge_matches(edge, y, x) : data_edge_matches(edge, x, y))) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        };
+
+        auto report = [&](detail::MatchState& state) {
+            for (std::size_t p {0}; p < k; ++p) {
+                state.vertex_ids[plan.order[p]] = frozen.vertex_id(state.mapped[p]);
+            }
+            matches.fetch_add(1, std::memory_order_relaxed);
+            if constexpr (std::is_same_v<std::invoke_result_t<OnMatch&, std::span<const std::size_t>>, bool>) {
+                if (!on_match(std::span<const std::size_t>{state.vertex_ids})) {
+                    stopped.store(true, std::memory_order_relaxed);
+                }
+            } else {
+                on_match(std::span<const std::size_t>{state.vertex_ids});
+            }
+        };
+
+        auto extend = [&](auto& self, detail::MatchState& state, const std::size_t p) -> void {
+            if (p == k) {
+                report(state);
+                return;
+            }
+            std::vector<std::size_t>& candidates {state.candidates[p]};
+            candidates.clear();
+            const auto& constraints {plan.constraints[p]};
+            if (constraints.empty()) {
+                for (std::size_t x {0}; x < n; ++x) {
+                    if (admissible(state, p, x)) {
+                        candidates.push_back(x);
+                    }
+                }
+            } else {
+                // Multiway intersection: scan the shortest neighbour span, binary search the others.
+                auto span_of = [&](const detail::PatternConstraint& constraint) {
+                    const std::size_t y {state.mapped[constraint.position]};
+                    return constraint.from_neighbour ? frozen.children(y) : frozen.parents(y);
+                };
+                std::size_t shortest {0};
+                for (std::size_t c {1}; c < constraints.size(); ++c) {
+                    if (span_of(constraints[c]).size() < span_of(constraints[shortest]).size()) {
+                        shortest = c;
+                    }
+                }
+                const auto base {span_of(constraints[shortest])};
+                for (std::size_t i {0}; i < base.size(); ++i) {
+                    const std::size_t x {base[i]};
+                    if (i > 0 && base[i - 1] == x) {
+                        continue;
+                    }
+                    bool everywhere {true};
+                    for (std::size_t c {0}; c < constraints.size() && everywhere; ++c) {
+                        if (c != shortest) {
+                            const auto other {span_of(constraints[c])};
+                            everywhere = std::binary_search(other.begin(), other.end(), x);
+                        }
+                    }
+                    if (everywhere && admissible(state, p, x)) {
+                        candidates.push_back(x);
+                    }
+                }
+            }
+            // Recursion below reuses deeper scratch only, so iterating our own buffer is safe.
+            for (std::size_t i {0}; i < state.candidates[p].size() && !stopped.load(std::memory_order_relaxed); ++i) {
+                state.mapped[p] = state.candidates[p][i];
+                self(self, state, p + 1);
+            }
+        };
+
+        parallel_for(roots.size(), [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+            detail::MatchState& state {states[worker]};
+            if (state.mapped.size() != k) {
+                state.mapped.assign(k, 0);
+                state.vertex_ids.assign(k, 0);
+                state.candidates.assign(k, {});
+            }
+            for (std::size_t r {begin}; r < end && !stopped.load(std::memory_order_relaxed); ++r) {
+                state.mapped[0] = roots[r];
+                if (admissible(state, 0, roots[r])) {
+                    extend(extend, state, 1);
+                }
+            }
+        }, options.threads, 16);
+
+        return Result<std::size_t, ErrorType>::success(matches.load());
+    }
+}
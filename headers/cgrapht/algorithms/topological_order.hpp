@@ -0,0 +1,275 @@
+/**
+ * @file topological_order.hpp
+ *
+ * @brief Topological order of a DAG, maintained incrementally as edges are added.
+ *
+ * @Detail
+ * `DynamicTopologicalOrder` wraps a `DirectedGraph` and routes mutations through itself. Every vertex holds a position
+ * such that all edges point from lower to higher positions. Inserting an edge that already agrees with the order costs
+ * a hash lookup. Otherwise only the vertices whose positions lie between the two endpoints can be affected: the
+ * descendants of the head and the ancestors of the tail within that window are found with two bounded searches and
+ * reshuffled among their own positions. If the forward search reaches the tail, the edge would close a cycle and is
+ * rejected before the graph is touched. Deleting edges never invalidates a topological order.
+ *
+ * Reference: Pearce and Kelly, "A Dynamic Topological Sort Algorithm for Directed Acyclic Graphs", JEA 2006.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/models.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Mutation front end for a DAG that keeps a valid topological order at all times.
+     *
+     * All mutations of the wrapped graph must go through this object for the order to stay valid. Reads can still go
+     * to the graph directly.
+     *
+     * @tparam V Vertex payload type.
+     * @tparam E Edge payload type.
+     * @tparam Observer Observer policy of the wrapped graph.
+     */
+    template <Hashable V, Hashable E, typename Observer = NoObserver>
+    class DynamicTopologicalOrder {
+    private:
+        DirectedGraph<V, E, Observer>* graph;
+        std::unordered_map<std::size_t, std::size_t> position{};
+        std::vector<std::optional<std::size_t>> slots{};   // vertex id at each position, empty once deleted
+        std::size_t vacant_count {0};
+
+        explicit DynamicTopologicalOrder(DirectedGraph<V, E, Observer>& graph) : graph{&graph} {}
+
+        void place(const std::size_t vertex_id) {
+            position[vertex_id] = slots.size();
+            slots.push_back(vertex_id);
+        }
+
+        void compact();
+
+        bool collect(std::size_t start, std::size_t bound, bool forward, std::size_t forbidden, std::vector<std::size_t>& out) const;
+
+    public:
+        /**
+         * @brief Wrap a graph, computing an initial order.
+         * @param graph Graph to maintain. Must outlive the returned object.
+         * @return Result containing the wrapper, or `CYCLE_DETECTED` if the graph is not acyclic.
+         */
+        static Result<DynamicTopologicalOrder, ErrorType> create(DirectedGraph<V, E, Observer>& graph);
+
+        /**
+         * @brief Add a vertex. New vertices are placed last.
+         * @param v Vertex payload.
+         * @return Result of `DirectedGraph::add_vertex`.
+         */
+        Result<std::size_t, ErrorType> add_vertex(const V& v);
+
+        /**
+         * @brief Delete a vertex without incident edges.
+         * @param vertex_id Vertex id.
+         * @return Result of `DirectedGraph::delete_vertex`.
+         */
+        Result<std::size_t, ErrorType> delete_vertex(std::size_t vertex_id);
+
+        /**
+         * @brief Add an edge, reordering the affected region if needed.
+         * @param from_id Source vertex id.
+         * @param to_id Destination vertex id.
+         * @param e Edge payload.
+         * @return Result containing the edge id, `CYCLE_DETECTED` if the edge would close a cycle (the graph is left
+         *         unchanged), or any error of `DirectedGraph::add_edge`.
+         */
+        Result<std::size_t, ErrorType> add_edge(std::size_t from_id, std::size_t to_id, const E& e);
+
+        /**
+         * @brief Delete an edge. The current order stays valid.
+         * @param edge_id Edge id.
+         * @return Result of `DirectedGraph::delete_edge`.
+         */
+        Result<std::size_t, ErrorType> delete_edge(std::size_t edge_id);
+
+        /**
+         * @brief Rank of a vertex in the order. Ranks are comparable but not necessarily contiguous.
+         * @param vertex_id Vertex id.
+         * @return Result containing the rank or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> rank(std::size_t vertex_id) const;
+
+        /**
+         * @brief All vertex ids in topological order.
+         */
+        [[nodiscard]] std::vector<std::size_t> order() const;
+    };
+
+    template <Hashable V, Hashable E, typename Observer>
+    Result<DynamicTopologicalOrder<V, E, Observer>, ErrorType> DynamicTopologicalOrder<V, E, Observer>::create(DirectedGraph<V, E, Observer>& graph) {
+        DynamicTopologicalOrder wrapper {graph};
+
+        // Kahn's algorithm on in-degrees.
+        std::unordered_map<std::size_t, std::size_t> pending {};
+        std::vector<std::size_t> ready {};
+        for (const std::size_t id : graph.get_vertex_ids()) {
+            const std::size_t in_degree {graph.get_parents(id).consume_ok().size()};
+            pending.emplace(id, in_degree);
+            if (in_degree == 0) {
+                ready.push_back(id);
+            }
+        }
+        while (!ready.empty()) {
+            const std::size_t id {ready.back()};
+            ready.pop_back();
+            wrapper.place(id);
+            const auto children {graph.get_children(id).consume_ok()};
+            for (const std::size_t child : children) {
+                // Both neighbour views collapse parallel edges, so in-degrees count distinct parents.
+                if (--pending[child] == 0) {
+                    ready.push_back(child);
+                }
+            }
+        }
+
+        if (wrapper.slots.size() != pending.size()) {
+            return Result<DynamicTopologicalOrder, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+        }
+        return Result<DynamicTopologicalOrder, ErrorType>::success(std::move(wrapper));
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    Result<std::size_t, ErrorType> DynamicTopologicalOrder<V, E, Observer>::add_vertex(const V& v) {
+        auto result = graph->add_vertex(v);
+        if (result.is_ok() && !position.contains(result.get_ok())) {
+            place(result.get_ok());
+        }
+        return result;
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    Result<std::size_t, ErrorType> DynamicTopologicalOrder<V, E, Observer>::delete_vertex(const std::size_t vertex_id) {
+        auto result = graph->delete_vertex(vertex_id);
+        if (result.is_ok()) {
+            slots[position.at(vertex_id)].reset();
+            position.erase(vertex_id);
+            if (++vacant_count > slots.size() / 2) {
+                compact();
+            }
+        }
+        return result;
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    void DynamicTopologicalOrder<V, E, Observer>::compact() {
+        std::erase(slots, std::nullopt);
+        for (std::size_t i {0}; i < slots.size(); ++i) {
+            position[*slots[i]] = i;
+        }
+        vacant_count = 0;
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    bool DynamicTopologicalOrder<V, E, Observer>::collect(const std::size_t start, const std::size_t bound, const bool forward,
+                                                const std::size_t forbidden, std::vector<std::size_t>& out) const {
+        std::unordered_set<std::size_t> seen {start};
+        std::vector<std::size_t> stack {start};
+        while (!stack.empty()) {
+            const std::size_t v {stack.back()};
+            stack.pop_back();
+            out.push_back(v);
+            const auto next {forward ? graph->get_children(v).consume_ok() : graph->get_parents(v).consume_ok()};
+            for (const std::size_t w : next) {
+                if (w == forbidden) {
+                    return false;
+                }
+                const std::size_t rank {position.at(w)};
+                if ((forward ? rank < bound : rank > bound) && seen.insert(w).second) {
+                    stack.push_back(w);
+                }
+            }
+        }
+        return true;
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    Result<std::size_t, ErrorType> DynamicTopologicalOrder<V, E, Observer>::add_edge(const std::size_t from_id, const std::size_t to_id, const E& e) {
+        if (!position.contains(from_id) || !position.contains(to_id) || graph->get_edge(std::hash<E>{}(e)).is_ok()) {
+            // Missing endpoints and duplicate payloads are reported by the graph itself and never change the order.
+            return graph->add_edge(from_id, to_id, e);
+        }
+        if (from_id == to_id) {
+            return Result<std::size_t, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+        }
+
+        const std::size_t lower {position.at(to_id)};
+        const std::size_t upper {position.at(from_id)};
+        if (lower > upper) {
+            return graph->add_edge(from_id, to_id, e);
+        }
+
+        // Descendants of `to` and ancestors of `from` that sit inside the window [lower, upper].
+        std::vector<std::size_t> forward {};
+        if (!collect(to_id, upper, true, from_id, forward)) {
+            return Result<std::size_t, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+        }
+        std::vector<std::size_t> backward {};
+        collect(from_id, lower, false, to_id, backward);
+
+        auto by_rank = [this](const std::size_t a, const std::size_t b) { return position.at(a) < position.at(b); };
+        std::ranges::sort(forward, by_rank);
+        std::ranges::sort(backward, by_rank);
+
+        // Reuse exactly the positions the affected vertices held, handing the lowest ones to the ancestors.
+        std::vector<std::size_t> ranks {};
+        ranks.reserve(forward.size() + backward.size());
+        for (const std::size_t v : backward) {
+            ranks.push_back(position.at(v));
+        }
+        for (const std::size_t v : forward) {
+            ranks.push_back(position.at(v));
+        }
+        std::ranges::sort(ranks);
+
+        std::size_t next {0};
+        for (const auto* group : {&backward, &forward}) {
+            for (const std::size_t v : *group) {
+                position[v] = ranks[next];
+                slots[ranks[next]] = v;
+                ++next;
+            }
+        }
+
+        return graph->add_edge(from_id, to_id, e);
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    Result<std::size_t, ErrorType> DynamicTopologicalOrder<V, E, Observer>::delete_edge(const std::size_t edge_id) {
+        return graph->delete_edge(edge_id);
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    Result<std::size_t, ErrorType> DynamicTopologicalOrder<V, E, Observer>::rank(const std::size_t vertex_id) const {
+        if (auto it = position.find(vertex_id); it != position.end()) {
+            return Result<std::size_t, ErrorType>::success(it->second);
+        }
+        return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+    }
+
+    template <Hashable V, Hashable E, typename Observer>
+    std::vector<std::size_t> DynamicTopologicalOrder<V, E, Observer>::order() const {
+        std::vector<std::size_t> ids {};
+        ids.reserve(position.size());
+        for (const auto& slot : slots) {
+            if (slot) {
+                ids.push_back(*slot);
+            }
+        }
+        return ids;
+    }
+}
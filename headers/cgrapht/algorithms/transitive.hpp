@@ -0,0 +1,292 @@
+/**
+ * @file transitive.hpp
+ *
+ * @brief Transitive closure and transitive reduction of DAGs with bitset rows.
+ *
+ * @Detail
+ * Both operations sweep the DAG once in reverse topological order and give every vertex a row of bits, one per
+ * vertex, marking its descendants. A vertex's row is the OR of its children's rows plus the children themselves, so a
+ * row is finished once all children are. Vertices are grouped by topological level (longest path from a source); the
+ * children of a vertex always sit on deeper levels, so levels are processed deepest first and the rows of one level
+ * are filled in parallel. Rows are plain arrays of 64 bit words and the OR loops compile to SIMD instructions where
+ * the target supports them.
+ *
+ * - `TransitiveClosure::build` keeps all rows: n^2 bits, meant for small to medium graphs.
+ * - `transitive_reduction` only needs to know, for each edge `u -> v`, whether `v` is a descendant of another child of
+ *   `u`: that is the bit of `v` in the OR of the children's rows, taken before the children themselves are added. It
+ *   therefore sweeps the graph once per chunk of target columns and holds only `vertex_count()` rows of one chunk at a
+ *   time, so memory stays within `TransitiveOptions::max_bytes` on large dependency graphs.
+ *
+ * Reference: Aho, Garey and Ullman, "The Transitive Reduction of a Directed Graph", SIAM J. Comput. 1972.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Options for `TransitiveClosure::build` and `transitive_reduction`.
+     */
+    struct TransitiveOptions {
+        std::size_t max_bytes {std::size_t{1} << 28};   ///< Row memory per sweep of `transitive_reduction`; at least one word per vertex is used.
+        std::size_t threads {0};                        ///< Workers, 0 for one per hardware thread.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * Vertices grouped by topological level, deepest level first. Empty if the graph has a cycle.
+         */
+        struct TopologicalLevels {
+            std::vector<std::size_t> vertices{};
+            std::vector<std::size_t> offsets{};     // level i holds vertices[offsets[i] .. offsets[i + 1])
+        };
+
+        inline TopologicalLevels deepest_levels_first(const FrozenGraph& graph) {
+            const std::size_t n {graph.vertex_count()};
+            std::vector<std::size_t> pending(n);
+            TopologicalLevels levels {};
+            levels.vertices.reserve(n);
+            for (std::size_t v {0}; v < n; ++v) {
+                pending[v] = graph.in_degree(v);
+                if (pending[v] == 0) {
+                    levels.vertices.push_back(v);
+                }
+            }
+            levels.offsets.push_back(0);
+            // Kahn's algorithm one level at a time: a vertex joins the level after its last parent's.
+            for (std::size_t begin {0}; begin < levels.vertices.size();) {
+                const std::size_t end {levels.vertices.size()};
+                levels.offsets.push_back(end);
+                for (std::size_t i {begin}; i < end; ++i) {
+                    for (const std::size_t child : graph.children(levels.vertices[i])) {
+                        if (--pending[child] == 0) {
+                            levels.vertices.push_back(child);
+                        }
+                    }
+                }
+                begin = end;
+            }
+            if (levels.vertices.size() != n) {
+                return {};
+            }
+            std::ranges::reverse(levels.vertices);
+            for (std::size_t& offset : levels.offsets) {
+                offset = n - offset;
+            }
+            std::ranges::reverse(levels.offsets);
+            return levels;
+        }
+
+        /**
+         * One sweep over the columns `first_column .. first_column + 64 * words`. Fills `rows` (row major, `words` per
+         * vertex) with the descendants of every vertex and calls `on_vertex(v, children_row)` with the OR of the
+         * children's rows before the children are added.
+         */
+        template <typename F>
+        void descendant_rows(const FrozenGraph& graph, const TopologicalLevels& levels, const std::size_t first_column,
+                             const std::size_t words, std::vector<std::uint64_t>& rows, F&& on_vertex, const std::size_t threads) {
+            const std::size_t last_column {first_column + 64 * words};
+            rows.assign(graph.vertex_count() * words, 0);
+            for (std::size_t level {0}; level + 1 < levels.offsets.size(); ++level) {
+                const std::size_t first {levels.offsets[level]};
+                parallel_for(levels.offsets[level + 1] - first, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                    for (std::size_t i {first + begin}; i < first + end; ++i) {
+                        const std::size_t v {levels.vertices[i]};
+                        std::uint64_t* row {rows.data() + v * words};
+                        const auto children {graph.children(v)};
+                        for (const std::size_t child : children) {
+                            const std::uint64_t* below {rows.data() + child * words};
+                            for (std::size_t w {0}; w < words; ++w) {
+                                row[w] |= below[w];
+                            }
+                        }
+                        on_vertex(v, static_cast<const std::uint64_t*>(row));
+                        for (const std::size_t child : children) {
+                            if (child >= first_column && child < last_column) {
+                                row[(child - first_column) / 64] |= std::uint64_t{1} << ((child - first_column) % 64);
+                            }
+                        }
+                    }
+                }, threads, 64);
+            }
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Full transitive closure of a DAG as a bit matrix over the dense indices of a frozen graph.
+     *
+     * Row `v` marks every vertex reachable from `v` by a path of at least one edge, so the diagonal is empty. Queries
+     * are thread safe. The closure refers to the frozen graph, which must outlive it.
+     */
+    class TransitiveClosure {
+    private:
+        const FrozenGraph* graph;
+        std::size_t words {0};
+        std::vector<std::uint64_t> bits{};
+
+        explicit TransitiveClosure(const FrozenGraph& graph) : graph{&graph} {}
+
+    public:
+        /**
+         * @brief Compute the closure.
+         *
+         * @param graph Frozen DAG.
+         * @param options Workers; `max_bytes` does not apply, the closure always holds n^2 bits.
+         * @param tracer Receives `transitive_closure.levels` and `transitive_closure.rows` spans. See `tracing.hpp`.
+         * @return Result containing the closure or `CYCLE_DETECTED`.
+         */
+        template <typename Tracer = NoTracer>
+        static Result<TransitiveClosure, ErrorType> build(const FrozenGraph& graph, const TransitiveOptions& options = {}, Tracer&& tracer = Tracer{}) {
+            detail::TopologicalLevels levels {};
+            {
+                const detail::TraceSpan span {tracer, "transitive_closure.levels"};
+                levels = detail::deepest_levels_first(graph);
+                if (levels.vertices.size() != graph.vertex_count()) {
+                    return Result<TransitiveClosure, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+                }
+            }
+            TransitiveClosure closure {graph};
+            {
+                const detail::TraceSpan span {tracer, "transitive_closure.rows"};
+                closure.words = (graph.vertex_count() + 63) / 64;
+                detail::descendant_rows(graph, levels, 0, closure.words, closure.bits, [](std::size_t, const std::uint64_t*) {}, options.threads);
+            }
+            return Result<TransitiveClosure, ErrorType>::success(std::move(closure));
+        }
+
+        /**
+         * @brief Whether a path of at least one edge leads from one vertex to another.
+         * @return Result containing the answer or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<bool, ErrorType> reachable(const std::size_t from_id, const std::size_t to_id) const {
+            auto from = graph->index_of(from_id);
+            auto to = graph->index_of(to_id);
+            if (!from.is_ok() || !to.is_ok()) {
+                return Result<bool, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            return Result<bool, ErrorType>::success(((row(from.get_ok())[to.get_ok() / 64] >> (to.get_ok() % 64)) & 1) != 0);
+        }
+
+        /**
+         * @brief Descendants of a dense index, bit `w % 64` of word `w / 64` standing for dense index `w`.
+         */
+        [[nodiscard]] std::span<const std::uint64_t> row(const std::size_t index) const {
+            return std::span<const std::uint64_t>{bits}.subspan(index * words, words);
+        }
+
+        /**
+         * @brief Number of descendants of a dense index.
+         */
+        [[nodiscard]] std::size_t descendant_count(const std::size_t index) const {
+            std::size_t count {0};
+            for (const std::uint64_t word : row(index)) {
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Number of reachable pairs, i.e. edges of the closure graph.
+         */
+        [[nodiscard]] std::size_t pair_count() const {
+            std::size_t count {0};
+            for (const std::uint64_t word : bits) {
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Memory held by the bit matrix, excluding the frozen graph.
+         */
+        [[nodiscard]] std::size_t matrix_bytes() const {
+            return bits.size() * sizeof(std::uint64_t);
+        }
+    };
+
+    /**
+     * @brief Smallest subgraph of a DAG with the same reachability.
+     *
+     * An edge `u -> v` is dropped if `v` is also reachable through another child of `u`. Of several parallel edges
+     * `u -> v` only the one with the smallest edge id is kept. The returned graph contains every vertex of `graph` and
+     * the kept edges, with payloads copied from `graph`. The result is unobserved.
+     *
+     * @param graph Graph holding the payloads.
+     * @param frozen Snapshot of `graph`.
+     * @param options Row memory per sweep and workers.
+     * @param tracer Receives `transitive_reduction.levels` and, per chunk of columns, `transitive_reduction.rows` spans,
+     *        and the number of dropped edges as `transitive_reduction.dropped`. See `tracing.hpp`.
+     * @return Result containing the reduction or `CYCLE_DETECTED`.
+     */
+    template <Hashable V, Hashable E, typename Observer, typename Tracer = NoTracer>
+    Result<DirectedGraph<V, E>, ErrorType> transitive_reduction(const DirectedGraph<V, E, Observer>& graph, const FrozenGraph& frozen,
+                                                                const TransitiveOptions& options = {}, Tracer&& tracer = Tracer{}) {
+        const std::size_t n {frozen.vertex_count()};
+        detail::TopologicalLevels levels {};
+        {
+            const detail::TraceSpan span {tracer, "transitive_reduction.levels"};
+            levels = detail::deepest_levels_first(frozen);
+            if (levels.vertices.size() != n) {
+                return Result<DirectedGraph<V, E>, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+            }
+        }
+
+        // One flag per outgoing CSR slot.
+        const auto first_slot {frozen.outgoing_offsets()};
+        std::vector<std::uint8_t> dropped(frozen.edge_count(), 0);
+
+        const std::size_t all_words {(n + 63) / 64};
+        const std::size_t words {std::clamp<std::size_t>(options.max_bytes / (sizeof(std::uint64_t) * std::max<std::size_t>(n, 1)), 1, std::max<std::size_t>(all_words, 1))};
+        std::vector<std::uint64_t> rows {};
+        for (std::size_t first_column {0}; first_column < n; first_column += 64 * words) {
+            const detail::TraceSpan span {tracer, "transitive_reduction.rows"};
+            const std::size_t last_column {first_column + 64 * words};
+            detail::descendant_rows(frozen, levels, first_column, words, rows, [&](const std::size_t v, const std::uint64_t* below) {
+                const auto children {frozen.children(v)};
+                for (std::size_t slot {0}; slot < children.size(); ++slot) {
+                    const std::size_t child {children[slot]};
+                    if (child >= first_column && child < last_column && ((below[(child - first_column) / 64] >> ((child - first_column) % 64)) & 1) != 0) {
+                        dropped[first_slot[v] + slot] = 1;
+                    }
+                }
+            }, options.threads);
+        }
+
+        DirectedGraph<V, E> reduction {};
+        for (const std::size_t id : frozen.get_vertex_ids()) {
+            reduction.add_vertex(graph.get_vertex(id).get_ok());
+        }
+        std::size_t dropped_count {0};
+        for (std::size_t v {0}; v < n; ++v) {
+            // Children are sorted, so parallel edges are adjacent and come in edge id order.
+            const auto children {frozen.children(v)};
+            const auto edges {frozen.outgoing_edges(v)};
+            for (std::size_t slot {0}; slot < children.size(); ++slot) {
+                if (dropped[first_slot[v] + slot] != 0 || (slot != 0 && children[slot - 1] == children[slot])) {
+                    ++dropped_count;
+                    continue;
+                }
+                const auto edge {graph.get_edge(edges[slot]).get_ok()};
+                reduction.add_edge(edge.from_id, edge.to_id, edge.edge);
+            }
+        }
+        detail::trace_counter(tracer, "transitive_reduction.dropped", static_cast<double>(dropped_count));
+        return Result<DirectedGraph<V, E>, ErrorType>::success(std::move(reduction));
+    }
+}
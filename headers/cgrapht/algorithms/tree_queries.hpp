@@ -0,0 +1,280 @@
+/**
+ * @file tree_queries.hpp
+ *
+ * @brief Constant time lowest common ancestors and k-th ancestors on rooted trees.
+ *
+ * @Detail
+ * `TreeIndex::build` checks that a `FrozenGraph` is a rooted tree with edges from parent to child: exactly one vertex
+ * without parents, exactly one parent for every other vertex, and every vertex reachable from the root. It then
+ * numbers the vertices in DFS preorder in linear time and builds two tables over dense indices:
+ *
+ * - A sparse table for the preorder form of the Euler tour trick. For two distinct vertices with preorder numbers
+ *   `a < b`, their lowest common ancestor is the parent with the smallest preorder number among the vertices numbered
+ *   `a + 1 .. b`. Entry `[j][i]` holds the minimum of those parent numbers over `2^j` positions from `i`, so a query is
+ *   two overlapping lookups and one `min`, O(1). O(n log n) entries of 32 bits.
+ * - Binary lifting: entry `[j][v]` is the `2^j`-th ancestor of `v`, so the k-th ancestor is one hop per set bit of `k`.
+ *   O(n log depth) entries of 32 bits.
+ *
+ * Table levels are filled in parallel, and batches of queries over dense indices are spread across workers.
+ *
+ * Reference: Bender and Farach-Colton, "The LCA Problem Revisited", 2000.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Options for `TreeIndex::build`.
+     */
+    struct TreeIndexOptions {
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Ancestor queries on a rooted tree, over the dense indices of a frozen graph.
+     *
+     * Queries are thread safe. The index refers to the frozen graph, which must outlive it.
+     */
+    class TreeIndex {
+    private:
+        const FrozenGraph* graph;
+        std::size_t root {0};
+        std::vector<std::uint32_t> preorder{};      // vertex -> preorder number
+        std::vector<std::uint32_t> vertex{};        // preorder number -> vertex
+        std::vector<std::uint32_t> depths{};
+        std::vector<std::uint32_t> table{};         // level-major sparse table of parent preorder numbers
+        std::vector<std::uint32_t> lifting{};       // level-major 2^j-th ancestors, the root is its own ancestor
+
+        explicit TreeIndex(const FrozenGraph& graph) : graph{&graph} {}
+
+        [[nodiscard]] std::size_t lca_index(const std::size_t u, const std::size_t v) const {
+            if (u == v) {
+                return u;
+            }
+            const std::size_t n {vertex.size()};
+            const std::size_t first {std::min(preorder[u], preorder[v]) + std::size_t{1}};
+            const std::size_t last {std::max(preorder[u], preorder[v])};
+            const std::size_t level {static_cast<std::size_t>(std::bit_width(last - first + 1)) - 1};
+            const std::uint32_t best {std::min(table[level * n + first], table[level * n + last + 1 - (std::size_t{1} << level)])};
+            return vertex[best];
+        }
+
+        [[nodiscard]] std::size_t ancestor_index(std::size_t v, const std::size_t k) const {
+            const std::size_t n {vertex.size()};
+            for (std::size_t level {0}; (k >> level) != 0; ++level) {
+                if ((k >> level) & 1) {
+                    v = lifting[level * n + v];
+                }
+            }
+            return v;
+        }
+
+    public:
+        /**
+         * @brief Validate the tree and build the query tables.
+         *
+         * @param graph Frozen graph with edges from parent to child.
+         * @param options Workers.
+         * @param tracer Receives `tree_index.preorder`, `tree_index.sparse_table` and `tree_index.lifting` spans. See
+         *        `tracing.hpp`.
+         * @return Result containing the index, `INVALID_ARGUMENT` if the graph is empty, too large for 32 bit indices,
+         *         has no single root or a vertex with several parents, or `CYCLE_DETECTED` if some vertices are not
+         *         reachable from the root.
+         */
+        template <typename Tracer = NoTracer>
+        static Result<TreeIndex, ErrorType> build(const FrozenGraph& graph, const TreeIndexOptions& options = {}, Tracer&& tracer = Tracer{}) {
+            const std::size_t n {graph.vertex_count()};
+            if (n == 0 || n > std::numeric_limits<std::uint32_t>::max()) {
+                return Result<TreeIndex, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            TreeIndex index {graph};
+            std::size_t roots {0};
+            for (std::size_t v {0}; v < n; ++v) {
+                if (graph.in_degree(v) == 0) {
+                    index.root = v;
+                    ++roots;
+                } else if (graph.in_degree(v) != 1) {
+                    return Result<TreeIndex, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+                }
+            }
+            if (roots != 1) {
+                return Result<TreeIndex, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+
+            {
+                const detail::TraceSpan span {tracer, "tree_index.preorder"};
+                index.preorder.assign(n, 0);
+                index.depths.assign(n, 0);
+                index.vertex.reserve(n);
+                // Children are pushed in reverse so the smallest dense index is visited first.
+                std::vector<std::uint32_t> stack {static_cast<std::uint32_t>(index.root)};
+                while (!stack.empty()) {
+                    const std::uint32_t v {stack.back()};
+                    stack.pop_back();
+                    index.preorder[v] = static_cast<std::uint32_t>(index.vertex.size());
+                    index.vertex.push_back(v);
+                    const auto children {graph.children(v)};
+                    for (auto it {children.rbegin()}; it != children.rend(); ++it) {
+                        index.depths[*it] = index.depths[v] + 1;
+                        stack.push_back(static_cast<std::uint32_t>(*it));
+                    }
+                }
+                // With one parent per vertex, anything the root misses hangs off a cycle.
+                if (index.vertex.size() != n) {
+                    return Result<TreeIndex, ErrorType>::error(ErrorType::CYCLE_DETECTED);
+                }
+            }
+
+            auto parent = [&](const std::size_t v) {
+                return v == index.root ? v : graph.parents(v).front();
+            };
+            {
+                const detail::TraceSpan span {tracer, "tree_index.sparse_table"};
+                const std::size_t levels {static_cast<std::size_t>(std::bit_width(n))};
+                index.table.resize(levels * n);
+                parallel_for(n, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                    for (std::size_t i {begin}; i < end; ++i) {
+                        index.table[i] = index.preorder[parent(index.vertex[i])];
+                    }
+                }, options.threads, 4096);
+                for (std::size_t level {1}; level < levels; ++level) {
+                    const std::size_t half {std::size_t{1} << (level - 1)};
+                    const std::uint32_t* below {index.table.data() + (level - 1) * n};
+                    std::uint32_t* row {index.table.data() + level * n};
+                    parallel_for(n + 1 - 2 * half, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                        for (std::size_t i {begin}; i < end; ++i) {
+                            row[i] = std::min(below[i], below[i + half]);
+                        }
+                    }, options.threads, 4096);
+                }
+            }
+            {
+                const detail::TraceSpan span {tracer, "tree_index.lifting"};
+                const std::size_t levels {std::max<std::size_t>(1, std::bit_width(*std::ranges::max_element(index.depths)))};
+                index.lifting.resize(levels * n);
+                parallel_for(n, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                    for (std::size_t v {begin}; v < end; ++v) {
+                        index.lifting[v] = static_cast<std::uint32_t>(parent(v));
+                    }
+                }, options.threads, 4096);
+                for (std::size_t level {1}; level < levels; ++level) {
+                    const std::uint32_t* below {index.lifting.data() + (level - 1) * n};
+                    std::uint32_t* row {index.lifting.data() + level * n};
+                    parallel_for(n, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                        for (std::size_t v {begin}; v < end; ++v) {
+                            row[v] = below[below[v]];
+                        }
+                    }, options.threads, 4096);
+                }
+            }
+            return Result<TreeIndex, ErrorType>::success(std::move(index));
+        }
+
+        /**
+         * @brief Vertex id of the root.
+         */
+        [[nodiscard]] std::size_t root_id() const {
+            return graph->vertex_id(root);
+        }
+
+        /**
+         * @brief Number of edges between a vertex and the root.
+         * @return Result containing the depth or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> depth(const std::size_t vertex_id) const {
+            auto v = graph->index_of(vertex_id);
+            if (!v.is_ok()) {
+                return Result<std::size_t, ErrorType>::error(v.get_error());
+            }
+            return Result<std::size_t, ErrorType>::success(depths[v.get_ok()]);
+        }
+
+        /**
+         * @brief Deepest vertex that is an ancestor of both vertices. A vertex is its own ancestor.
+         * @return Result containing the vertex id or `ABSENT_VERTEX`.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> lowest_common_ancestor(const std::size_t u_id, const std::size_t v_id) const {
+            auto u = graph->index_of(u_id);
+            auto v = graph->index_of(v_id);
+            if (!u.is_ok() || !v.is_ok()) {
+                return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            return Result<std::size_t, ErrorType>::success(graph->vertex_id(lca_index(u.get_ok(), v.get_ok())));
+        }
+
+        /**
+         * @brief Ancestor `k` edges above a vertex; `k = 0` is the vertex itself.
+         * @return Result containing the vertex id, `ABSENT_VERTEX`, or `INVALID_ARGUMENT` if `k` exceeds the depth.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> kth_ancestor(const std::size_t vertex_id, const std::size_t k) const {
+            auto v = graph->index_of(vertex_id);
+            if (!v.is_ok()) {
+                return Result<std::size_t, ErrorType>::error(v.get_error());
+            }
+            if (k > depths[v.get_ok()]) {
+                return Result<std::size_t, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            return Result<std::size_t, ErrorType>::success(graph->vertex_id(ancestor_index(v.get_ok(), k)));
+        }
+
+        /**
+         * @brief Lowest common ancestors of many pairs of dense indices, in parallel.
+         *
+         * @param pairs Pairs of dense indices.
+         * @param threads Workers, 0 for one per hardware thread.
+         * @return Result containing the dense index of the ancestor per pair, or `INVALID_ARGUMENT` if an index is out
+         *         of range.
+         */
+        [[nodiscard]] Result<std::vector<std::size_t>, ErrorType> lowest_common_ancestors(std::span<const std::pair<std::size_t, std::size_t>> pairs,
+                                                                                          const std::size_t threads = 0) const {
+            const std::size_t n {vertex.size()};
+            if (std::ranges::any_of(pairs, [n](const auto& pair) { return pair.first >= n || pair.second >= n; })) {
+                return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            std::vector<std::size_t> answers(pairs.size());
+            parallel_for(pairs.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                for (std::size_t i {begin}; i < end; ++i) {
+                    answers[i] = lca_index(pairs[i].first, pairs[i].second);
+                }
+            }, threads, 4096);
+            return Result<std::vector<std::size_t>, ErrorType>::success(std::move(answers));
+        }
+
+        /**
+         * @brief K-th ancestors of many (dense index, k) pairs, in parallel.
+         *
+         * @param queries Dense index and number of edges to climb.
+         * @param threads Workers, 0 for one per hardware thread.
+         * @return Result containing the dense index of the ancestor per query, or `INVALID_ARGUMENT` if an index is
+         *         out of range or a `k` exceeds the depth.
+         */
+        [[nodiscard]] Result<std::vector<std::size_t>, ErrorType> kth_ancestors(std::span<const std::pair<std::size_t, std::size_t>> queries,
+                                                                                const std::size_t threads = 0) const {
+            const std::size_t n {vertex.size()};
+            if (std::ranges::any_of(queries, [&](const auto& query) { return query.first >= n || query.second > depths[query.first]; })) {
+                return Result<std::vector<std::size_t>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+            }
+            std::vector<std::size_t> answers(queries.size());
+            parallel_for(queries.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                for (std::size_t i {begin}; i < end; ++i) {
+                    answers[i] = ancestor_index(queries[i].first, queries[i].second);
+                }
+            }, threads, 4096);
+            return Result<std::vector<std::size_t>, ErrorType>::success(std::move(answers));
+        }
+    };
+}
@@ -22,4 +22,31 @@ namespace cgrapht {
         { std::hash<T>{}(a) } -> std::convertible_to<std::size_t>;
     };
 
+    /**
+     * @brief Which incident edges a traversal follows.
+     */
+    enum class Direction {
+        OUTGOING,   ///< Follow edges from parent to child.
+        INCOMING,   ///< Follow edges from child to parent.
+        BOTH        ///< Ignore edge direction.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /**
+         * @brief Hint the CPU to pull the cache line holding `address` in for reading.
+         *
+         * Compiles to nothing on toolchains without a prefetch builtin.
+         */
+        inline void prefetch_read(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address, 0, 3);
+#else
+            (void) address;
+#endif
+        }
+    }
+    /// @endcond
+
 }
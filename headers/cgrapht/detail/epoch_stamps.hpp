@@ -0,0 +1,48 @@
+/**
+ * @file epoch_stamps.hpp
+ * @brief Reusable visited set over dense vertex indices.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/// @cond INTERNAL
+namespace cgrapht::detail {
+
+    /**
+     * @brief Visited set that is cleared in O(1).
+     *
+     * Every index carries the stamp of the last query that visited it. Starting a query bumps the current stamp, which
+     * implicitly unmarks everything. The array is only rewritten when the stamp wraps around.
+     */
+    class EpochStamps {
+    private:
+        std::vector<std::uint32_t> stamps{};
+        std::uint32_t epoch {0};
+
+    public:
+        /**
+         * @brief Start a new query over indices `[0, size)`.
+         */
+        void begin(const std::size_t size) {
+            if (stamps.size() < size) {
+                stamps.resize(size, 0);
+            }
+            if (++epoch == 0) {
+                std::ranges::fill(stamps, 0);
+                epoch = 1;
+            }
+        }
+
+        [[nodiscard]] bool visited(const std::size_t index) const {
+            return stamps[index] == epoch;
+        }
+
+        void visit(const std::size_t index) {
+            stamps[index] = epoch;
+        }
+    };
+}
+/// @endcond
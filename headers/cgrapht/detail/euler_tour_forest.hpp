@@ -0,0 +1,272 @@
+/**
+ * @file euler_tour_forest.hpp
+ * @brief Euler tour trees over randomized treaps, for dynamic forests with O(log V) link and cut.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+/// @cond INTERNAL
+namespace cgrapht::detail {
+
+    /**
+     * @brief A forest whose trees are stored as Euler tours.
+     *
+     * Every tree is the cyclic sequence of its vertices, each occurring once, and of its edges, each occurring twice as
+     * the two arcs `(u, v)` and `(v, u)`. The sequence is kept in a treap ordered by position, so the tree a node
+     * belongs to is identified by its treap root and rerooting the tour is a rotation of the sequence. Link, cut and
+     * root lookups are O(log V) expected.
+     *
+     * Nodes carry two marks that are OR-ed up the treap, so all marked nodes of a tree are found in time proportional to
+     * their number times O(log V). Nodes live in a pool and are referred to by index; `NONE` is the empty tree.
+     */
+    class EulerTourForest {
+    public:
+        static constexpr std::size_t NONE {std::numeric_limits<std::size_t>::max()};
+
+        enum Mark : std::uint8_t {
+            FIRST = 1,
+            SECOND = 2,
+        };
+
+    private:
+        struct Node {
+            std::size_t left;
+            std::size_t right;
+            std::size_t parent;
+            std::size_t size;
+            std::size_t vertices;
+            std::size_t key;
+            std::uint64_t priority;
+            bool vertex;
+            std::uint8_t own;
+            std::uint8_t below;
+        };
+
+        std::vector<Node> nodes{};
+        std::vector<std::size_t> free_nodes{};
+        std::mt19937_64 rng {0x70757273};
+
+        std::size_t make_node(const std::size_t key, const bool vertex) {
+            const Node node {NONE, NONE, NONE, 1, vertex ? std::size_t{1} : std::size_t{0}, key, rng(), vertex, 0, 0};
+            if (!free_nodes.empty()) {
+                const std::size_t x {free_nodes.back()};
+                free_nodes.pop_back();
+                nodes[x] = node;
+                return x;
+            }
+            nodes.push_back(node);
+            return nodes.size() - 1;
+        }
+
+        [[nodiscard]] std::size_t size_of(const std::size_t x) const {
+            return x == NONE ? 0 : nodes[x].size;
+        }
+
+        void update(const std::size_t x) {
+            Node& node {nodes[x]};
+            node.size = 1;
+            node.vertices = node.vertex ? 1 : 0;
+            node.below = node.own;
+            for (const std::size_t child : {node.left, node.right}) {
+                if (child != NONE) {
+                    node.size += nodes[child].size;
+                    node.vertices += nodes[child].vertices;
+                    node.below |= nodes[child].below;
+                }
+            }
+        }
+
+        void set_left(const std::size_t x, const std::size_t child) {
+            nodes[x].left = child;
+            if (child != NONE) {
+                nodes[child].parent = x;
+            }
+        }
+
+        void set_right(const std::size_t x, const std::size_t child) {
+            nodes[x].right = child;
+            if (child != NONE) {
+                nodes[child].parent = x;
+            }
+        }
+
+        std::size_t join(const std::size_t a, const std::size_t b) {
+            if (a == NONE) {
+                return b;
+            }
+            if (b == NONE) {
+                return a;
+            }
+            if (nodes[a].priority > nodes[b].priority) {
+                set_right(a, join(nodes[a].right, b));
+                update(a);
+                return a;
+            }
+            set_left(b, join(a, nodes[b].left));
+            update(b);
+            return b;
+        }
+
+        // The first `count` nodes of the sequence rooted at `x`, and the rest. Parents of the results are left dangling.
+        std::pair<std::size_t, std::size_t> divide(const std::size_t x, const std::size_t count) {
+            if (x == NONE) {
+                return {NONE, NONE};
+            }
+            const std::size_t left_size {size_of(nodes[x].left)};
+            if (count <= left_size) {
+                const auto [first, rest] {divide(nodes[x].left, count)};
+                set_left(x, rest);
+                update(x);
+                return {first, x};
+            }
+            const auto [first, rest] {divide(nodes[x].right, count - left_size - 1)};
+            set_right(x, first);
+            update(x);
+            return {x, rest};
+        }
+
+        std::size_t make_root(const std::size_t x) {
+            if (x != NONE) {
+                nodes[x].parent = NONE;
+            }
+            return x;
+        }
+
+        std::size_t concatenate(const std::size_t a, const std::size_t b) {
+            return make_root(join(a, b));
+        }
+
+        std::pair<std::size_t, std::size_t> split(const std::size_t x, const std::size_t count) {
+            const auto [first, rest] {divide(x, count)};
+            return {make_root(first), make_root(rest)};
+        }
+
+        // Zero-based position of `x` in its sequence.
+        [[nodiscard]] std::size_t position(std::size_t x) const {
+            std::size_t index {size_of(nodes[x].left)};
+            while (nodes[x].parent != NONE) {
+                const std::size_t up {nodes[x].parent};
+                if (nodes[up].right == x) {
+                    index += size_of(nodes[up].left) + 1;
+                }
+                x = up;
+            }
+            return index;
+        }
+
+        // Rotate the tour containing the vertex node `x` so that it starts at `x`.
+        std::size_t reroot(const std::size_t x) {
+            const auto [before, from] {split(root(x), position(x))};
+            return concatenate(from, before);
+        }
+
+    public:
+        /**
+         * @brief A new single-vertex tree.
+         */
+        std::size_t make_vertex(const std::size_t key) {
+            return make_node(key, true);
+        }
+
+        /**
+         * @brief Remove a vertex node, which must be a single-vertex tree.
+         */
+        void release(const std::size_t x) {
+            free_nodes.push_back(x);
+        }
+
+        /**
+         * @brief The treap root of the tree containing `x`. Two nodes are in the same tree iff their roots are equal.
+         */
+        [[nodiscard]] std::size_t root(std::size_t x) const {
+            while (nodes[x].parent != NONE) {
+                x = nodes[x].parent;
+            }
+            return x;
+        }
+
+        /**
+         * @brief Number of vertices in the tree rooted at `root`.
+         */
+        [[nodiscard]] std::size_t vertex_count(const std::size_t root) const {
+            return nodes[root].vertices;
+        }
+
+        /**
+         * @brief Join the trees of the vertex nodes `u` and `v` with an edge. Returns the two new arc nodes.
+         */
+        std::pair<std::size_t, std::size_t> link(const std::size_t u, const std::size_t v, const std::size_t edge_key) {
+            const std::size_t forward {make_node(edge_key, false)};
+            const std::size_t backward {make_node(edge_key, false)};
+            const std::size_t from_u {reroot(u)};
+            const std::size_t from_v {reroot(v)};
+            concatenate(concatenate(concatenate(from_u, forward), from_v), backward);
+            return {forward, backward};
+        }
+
+        /**
+         * @brief Remove the edge with the given arc nodes, splitting its tree in two. The arcs are released.
+         */
+        void cut(std::size_t forward, std::size_t backward) {
+            std::size_t first {position(forward)};
+            std::size_t second {position(backward)};
+            if (first > second) {
+                std::swap(first, second);
+                std::swap(forward, backward);
+            }
+            // The tour is `outer arc inner arc rest`; the tour between the two arcs is one side of the cut.
+            const auto [outer, from_first] {split(root(forward), first)};
+            const auto [arc, from_inner] {split(from_first, 1)};
+            const auto [inner, from_second] {split(from_inner, second - first - 1)};
+            const auto [other_arc, rest] {split(from_second, 1)};
+            concatenate(outer, rest);
+            free_nodes.push_back(arc);
+            free_nodes.push_back(other_arc);
+        }
+
+        /**
+         * @brief Set or clear a mark on a node.
+         */
+        void set_mark(std::size_t x, const Mark mark, const bool on) {
+            if (on) {
+                nodes[x].own |= mark;
+            } else {
+                nodes[x].own &= static_cast<std::uint8_t>(~mark);
+            }
+            for (; x != NONE; x = nodes[x].parent) {
+                update(x);
+            }
+        }
+
+        /**
+         * @brief Keys of all nodes in the tree rooted at `root` that carry `mark`.
+         */
+        [[nodiscard]] std::vector<std::size_t> marked(const std::size_t root, const Mark mark) const {
+            std::vector<std::size_t> keys {};
+            std::vector<std::size_t> stack {};
+            if ((nodes[root].below & mark) != 0) {
+                stack.push_back(root);
+            }
+            while (!stack.empty()) {
+                const Node& node {nodes[stack.back()]};
+                stack.pop_back();
+                if ((node.own & mark) != 0) {
+                    keys.push_back(node.key);
+                }
+                for (const std::size_t child : {node.left, node.right}) {
+                    if (child != NONE && (nodes[child].below & mark) != 0) {
+                        stack.push_back(child);
+                    }
+                }
+            }
+            return keys;
+        }
+    };
+}
+/// @endcond
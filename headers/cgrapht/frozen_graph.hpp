@@ -0,0 +1,237 @@
+/**
+ * @file frozen_graph.hpp
+ *
+ * @brief Immutable, densely indexed snapshot of a `DirectedGraph`.
+ *
+ * @Detail
+ * `DirectedGraph` is optimized for mutation: every vertex and edge lives in a hash map keyed by its id, and neighbour
+ * queries build a fresh set per call. Traversal heavy algorithms want the opposite trade-off. A `FrozenGraph` renumbers
+ * the vertices to dense indices `0 .. vertex_count() - 1` and stores the adjacency in compressed sparse row (CSR) form
+ * in both directions, so neighbourhoods are contiguous spans that can be scanned without hashing or allocation.
+ *
+ * The snapshot does not track later changes to the source graph. Freeze again after mutating it.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/models.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Compressed sparse row snapshot of a directed graph over dense vertex indices.
+     *
+     * Dense indices are assigned in ascending order of vertex id, so freezing the same graph twice yields the same
+     * numbering. Within every neighbourhood the entries are sorted by dense neighbour index, which makes the spans
+     * usable for merges and binary searches. Parallel edges appear once per edge.
+     */
+    class FrozenGraph {
+    private:
+        std::vector<std::size_t> vertex_ids{};
+        std::unordered_map<std::size_t, std::size_t> dense_index{};
+
+        std::vector<std::size_t> out_offsets{};
+        std::vector<std::size_t> out_targets{};
+        std::vector<std::size_t> out_edge_ids{};
+
+        std::vector<std::size_t> in_offsets{};
+        std::vector<std::size_t> in_sources{};
+        std::vector<std::size_t> in_edge_ids{};
+
+        static void build_direction(std::vector<std::pair<std::size_t, std::size_t>>& slots, std::vector<std::size_t>& offsets,
+                                    std::vector<std::size_t>& neighbours, std::vector<std::size_t>& edge_ids);
+
+    public:
+        /**
+         * @brief Snapshot a graph.
+         * @param graph Source graph. It is only read during construction.
+         */
+        template <Hashable V, Hashable E, typename Observer>
+        explicit FrozenGraph(const DirectedGraph<V, E, Observer>& graph);
+
+        /**
+         * @brief Number of vertices.
+         */
+        [[nodiscard]] std::size_t vertex_count() const {
+            return vertex_ids.size();
+        }
+
+        /**
+         * @brief Number of edges.
+         */
+        [[nodiscard]] std::size_t edge_count() const {
+            return out_targets.size();
+        }
+
+        /**
+         * @brief Map a dense index back to the vertex id of the source graph.
+         * @param index Dense index, must be below `vertex_count()`.
+         * @return Vertex id.
+         */
+        [[nodiscard]] std::size_t vertex_id(const std::size_t index) const {
+            return vertex_ids[index];
+        }
+
+        /**
+         * @brief All vertex ids, indexed by dense index.
+         */
+        [[nodiscard]] std::span<const std::size_t> get_vertex_ids() const {
+            return vertex_ids;
+        }
+
+        /**
+         * @brief Map a vertex id of the source graph to its dense index.
+         * @param vertex_id Vertex id.
+         * @return Result containing the dense index or an error.
+         */
+        [[nodiscard]] Result<std::size_t, ErrorType> index_of(const std::size_t vertex_id) const {
+            if (auto it = dense_index.find(vertex_id); it != dense_index.end()) {
+                return Result<std::size_t, ErrorType>::success(it->second);
+            }
+            return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+        }
+
+        /**
+         * @brief Dense indices of the children of a vertex, sorted ascending.
+         * @param index Dense index.
+         */
+        [[nodiscard]] std::span<const std::size_t> children(const std::size_t index) const {
+            return std::span{out_targets}.subspan(out_offsets[index], out_offsets[index + 1] - out_offsets[index]);
+        }
+
+        /**
+         * @brief Dense indices of the parents of a vertex, sorted ascending.
+         * @param index Dense index.
+         */
+        [[nodiscard]] std::span<const std::size_t> parents(const std::size_t index) const {
+            return std::span{in_sources}.subspan(in_offsets[index], in_offsets[index + 1] - in_offsets[index]);
+        }
+
+        /**
+         * @brief Ids of the outgoing edges of a vertex, positionally aligned with `children(index)`.
+         * @param index Dense index.
+         */
+        [[nodiscard]] std::span<const std::size_t> outgoing_edges(const std::size_t index) const {
+            return std::span{out_edge_ids}.subspan(out_offsets[index], out_offsets[index + 1] - out_offsets[index]);
+        }
+
+        /**
+         * @brief Ids of the incoming edges of a vertex, positionally aligned with `parents(index)`.
+         * @param index Dense index.
+         */
+        [[nodiscard]] std::span<const std::size_t> incoming_edges(const std::size_t index) const {
+            return std::span{in_edge_ids}.subspan(in_offsets[index], in_offsets[index + 1] - in_offsets[index]);
+        }
+
+        /**
+         * @brief Number of outgoing edges of a vertex.
+         * @param index Dense index.
+         */
+        [[nodiscard]] std::size_t out_degree(const std::size_t index) const {
+            return out_offsets[index + 1] - out_offsets[index];
+        }
+
+        /**
+         * @brief Number of incoming edges of a vertex.
+         * @param index Dense index.
+         */
+        [[nodiscard]] std::size_t in_degree(const std::size_t index) const {
+            return in_offsets[index + 1] - in_offsets[index];
+        }
+
+        /**
+         * @brief Row offsets of the outgoing CSR. Entry `i` is the position of the first out slot of vertex `i`.
+         */
+        [[nodiscard]] std::span<const std::size_t> outgoing_offsets() const {
+            return out_offsets;
+        }
+
+        /**
+         * @brief Row offsets of the incoming CSR (the CSC of the adjacency matrix).
+         */
+        [[nodiscard]] std::span<const std::size_t> incoming_offsets() const {
+            return in_offsets;
+        }
+
+        /**
+         * @brief Column indices of the outgoing CSR: the children of all vertices, row after row.
+         */
+        [[nodiscard]] std::span<const std::size_t> outgoing_targets() const {
+            return out_targets;
+        }
+
+        /**
+         * @brief Row indices of the CSC: the parents of all vertices, column after column.
+         */
+        [[nodiscard]] std::span<const std::size_t> incoming_sources() const {
+            return in_sources;
+        }
+    };
+
+    template <Hashable V, Hashable E, typename Observer>
+    FrozenGraph::FrozenGraph(const DirectedGraph<V, E, Observer>& graph) {
+        for (const std::size_t id : graph.get_vertex_ids()) {
+            vertex_ids.push_back(id);
+        }
+        std::ranges::sort(vertex_ids);
+
+        dense_index.reserve(vertex_ids.size());
+        for (std::size_t i {0}; i < vertex_ids.size(); ++i) {
+            dense_index.emplace(vertex_ids[i], i);
+        }
+
+        // Bucket every edge by its source (resp. target) with a counting sort, keyed on the dense neighbour.
+        out_offsets.assign(vertex_ids.size() + 1, 0);
+        in_offsets.assign(vertex_ids.size() + 1, 0);
+        std::vector<std::pair<std::size_t, std::size_t>> edges {};
+        for (const auto& [edge_id, edge] : graph.get_edge_entries()) {
+            const std::size_t from {dense_index.at(edge.from_id)};
+            const std::size_t to {dense_index.at(edge.to_id)};
+            ++out_offsets[from + 1];
+            ++in_offsets[to + 1];
+            edges.emplace_back(from, to);
+            out_edge_ids.push_back(edge_id);
+        }
+        for (std::size_t i {1}; i < out_offsets.size(); ++i) {
+            out_offsets[i] += out_offsets[i - 1];
+            in_offsets[i] += in_offsets[i - 1];
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> out_slots(edges.size());
+        std::vector<std::pair<std::size_t, std::size_t>> in_slots(edges.size());
+        {
+            std::vector<std::size_t> out_cursor(out_offsets.begin(), out_offsets.end() - 1);
+            std::vector<std::size_t> in_cursor(in_offsets.begin(), in_offsets.end() - 1);
+            for (std::size_t i {0}; i < edges.size(); ++i) {
+                const auto [from, to] = edges[i];
+                out_slots[out_cursor[from]++] = {to, out_edge_ids[i]};
+                in_slots[in_cursor[to]++] = {from, out_edge_ids[i]};
+            }
+        }
+
+        build_direction(out_slots, out_offsets, out_targets, out_edge_ids);
+        build_direction(in_slots, in_offsets, in_sources, in_edge_ids);
+    }
+
+    inline void FrozenGraph::build_direction(std::vector<std::pair<std::size_t, std::size_t>>& slots, std::vector<std::size_t>& offsets,
+                                             std::vector<std::size_t>& neighbours, std::vector<std::size_t>& edge_ids) {
+        neighbours.resize(slots.size());
+        edge_ids.resize(slots.size());
+        for (std::size_t v {0}; v + 1 < offsets.size(); ++v) {
+            std::sort(slots.begin() + static_cast<std::ptrdiff_t>(offsets[v]), slots.begin() + static_cast<std::ptrdiff_t>(offsets[v + 1]));
+        }
+        for (std::size_t i {0}; i < slots.size(); ++i) {
+            neighbours[i] = slots[i].first;
+            edge_ids[i] = slots[i].second;
+        }
+    }
+}
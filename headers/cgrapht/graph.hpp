@@ -16,12 +16,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <unordered_set>
 #include <functional>
 #include <ranges>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "cgrapht/commons.hpp"
+#include "cgrapht/graph_stats.hpp"
+#include "cgrapht/observers.hpp"
+#include "cgrapht/parallel.hpp"
 #include "models.hpp"
 
 namespace cgrapht {
@@ -56,17 +68,76 @@ namespace cgrapht {
      *
      * @tparam V Vertex payload type.
      * @tparam E Edge payload type.
+     * @tparam Observer Policy notified of every successful mutation, see `observers.hpp`. The default observes nothing
+     *         and adds neither storage nor code.
      *
      * @note Both `V` and `E` must be hashable types.
      */
-    template <Hashable V, Hashable E>
+    template <Hashable V, Hashable E, typename Observer = NoObserver>
     class DirectedGraph {
     private:
         std::unordered_map<std::size_t, V> vertex_index{};
         std::unordered_map<std::size_t, Edge<E>> edge_index{};
         std::unordered_map<std::size_t, EdgeSet> adjacency_list{};
+        [[no_unique_address]] Observer observer{};
+
+        /// Number of keys whose buckets are prefetched together before any of them is resolved.
+        static constexpr std::size_t PREFETCH_WINDOW {32};
+
+        /**
+         * Run an operation body, reporting its outcome and duration when the observer wants instrumentation. For any
+         * other observer this is just `body()`.
+         */
+        template <typename F>
+        decltype(auto) instrumented(const GraphOperation operation, F&& body) const {
+            if constexpr (OperationObserver<Observer>) {
+                const auto start {std::chrono::steady_clock::now()};
+                auto elapsed = [&start] {
+                    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+                };
+                if constexpr (std::is_void_v<decltype(body())>) {
+                    body();
+                    observer.on_operation(operation, std::nullopt, elapsed());
+                } else {
+                    auto result {body()};
+                    const std::uint64_t nanoseconds {elapsed()};
+                    observer.on_operation(operation, result.is_ok() ? std::nullopt : std::optional<ErrorType>{result.get_error()}, nanoseconds);
+                    return result;
+                }
+            } else {
+                return body();
+            }
+        }
+
+        template <typename Map, typename T>
+        static void batch_lookup(const Map& index, std::span<const std::size_t> ids, std::vector<Result<T, ErrorType>>& out, ErrorType absent);
 
     public:
+        /**
+         * @brief Construct an empty graph with a default constructed observer.
+         */
+        DirectedGraph() = default;
+
+        /**
+         * @brief Construct an empty graph with the given observer.
+         * @param observer Observer policy instance.
+         */
+        explicit DirectedGraph(Observer observer) : observer{std::move(observer)} {}
+
+        /**
+         * @brief Access the observer policy instance.
+         */
+        Observer& get_observer() {
+            return observer;
+        }
+
+        /**
+         * @brief Access the observer policy instance.
+         */
+        const Observer& get_observer() const {
+            return observer;
+        }
+
         /**
          * @brief Add a vertex to the graph.
          * @param v Vertex payload.
@@ -105,6 +176,26 @@ namespace cgrapht {
          * @return Result containing the edge or an error.
          */
         Result<Edge<E>, ErrorType> get_edge(std::size_t id) const;
+        /**
+         * @brief Fetch a batch of vertex payloads by id.
+         *
+         * The ids are processed in small windows: the hash bucket of every id in the window is located and prefetched
+         * before any lookup is resolved, so the cache misses of independent lookups overlap instead of being paid one
+         * after another. Prefer this over calling `get_vertex` in a loop when resolving many ids at once.
+         *
+         * @param ids Vertex ids.
+         * @param out Receives one result per id, in the order of `ids`. Any previous contents are discarded.
+         */
+        void get_vertices(std::span<const std::size_t> ids, std::vector<Result<V, ErrorType>>& out) const;
+        /**
+         * @brief Fetch a batch of edge records by id.
+         *
+         * Batched counterpart of `get_edge`, see `get_vertices(std::span<const std::size_t>, std::vector<Result<V, ErrorType>>&)`.
+         *
+         * @param ids Edge ids.
+         * @param out Receives one result per id, in the order of `ids`. Any previous contents are discarded.
+         */
+        void get_edges(std::span<const std::size_t> ids, std::vector<Result<Edge<E>, ErrorType>>& out) const;
         /**
          * @brief Get adjacent children (outgoing neighbors).
          * @param vertex_id Vertex id.
@@ -151,130 +242,262 @@ namespace cgrapht {
         std::ranges::forward_range auto get_edges() const & {
             return edge_index | std::views::values;
         }
-    };
 
-    template <Hashable V, Hashable E> Result<std::size_t, ErrorType> DirectedGraph<V, E>::add_vertex(const V& v) {
-        std::size_t vertex_id {std::hash<V>{}(v)};
-        if (!vertex_index.contains(vertex_id)) {
-            vertex_index.emplace(vertex_id, v);
-            adjacency_list.emplace(vertex_id, EdgeSet{});
+        /**
+         * @brief View of all vertex ids.
+         * @return Forward range of vertex ids.
+         */
+        std::ranges::forward_range auto get_vertex_ids() const & {
+            return vertex_index | std::views::keys;
         }
-        return Result<std::size_t, ErrorType>::success(vertex_id);
-    }
 
-    template <Hashable V, Hashable E> Result<std::size_t, ErrorType> DirectedGraph<V, E>::delete_vertex(std::size_t vertex_id) {
-        if (!vertex_index.contains(vertex_id)) {
-            return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+        /**
+         * @brief View of all edge ids.
+         * @return Forward range of edge ids.
+         */
+        std::ranges::forward_range auto get_edge_ids() const & {
+            return edge_index | std::views::keys;
         }
-        if (adjacency_list.contains(vertex_id) && adjacency_list[vertex_id].incoming_edges.empty() && adjacency_list[vertex_id].outgoing_edges.empty()) {
-            adjacency_list.erase(vertex_id);
-            vertex_index.erase(vertex_id);
-            return Result<std::size_t, ErrorType>::success(vertex_id);
+
+        /**
+         * @brief View of all edges as `(edge id, edge record)` pairs.
+         * @return Forward range of pairs.
+         */
+        std::ranges::forward_range auto get_edge_entries() const & {
+            return edge_index | std::views::all;
         }
-        return Result<std::size_t, ErrorType>::error(ErrorType::VERTEX_NOT_FREE);
+
+        /**
+         * @brief Hash table health and degree diagnostics.
+         *
+         * All buckets of the vertex, edge and adjacency tables are scanned in a single parallel pass; the degrees are
+         * read from the adjacency buckets during the same pass. Intended for troubleshooting, not for hot paths: the
+         * cost is linear in buckets plus vertices. Must not run concurrently with mutations.
+         *
+         * @param options Number of hubs to report and worker count.
+         * @return Diagnostics snapshot.
+         */
+        [[nodiscard]] GraphStats stats(const StatsOptions& options = {}) const;
+    };
+
+    template <Hashable V, Hashable E, typename Observer> Result<std::size_t, ErrorType> DirectedGraph<V, E, Observer>::add_vertex(const V& v) {
+        return instrumented(GraphOperation::ADD_VERTEX, [&] {
+            std::size_t vertex_id {std::hash<V>{}(v)};
+            if (!vertex_index.contains(vertex_id)) {
+                vertex_index.emplace(vertex_id, v);
+                adjacency_list.emplace(vertex_id, EdgeSet{});
+                detail::notify_vertex_added(observer, vertex_id);
+            }
+            return Result<std::size_t, ErrorType>::success(vertex_id);
+        });
     }
 
-    template <Hashable V, Hashable E> Result<std::size_t, ErrorType> DirectedGraph<V, E>::add_edge(std::size_t from_id, std::size_t to_id, const E& e) {
-        if (!vertex_index.contains(from_id) || !vertex_index.contains(to_id)) {
-            return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
-        }
+    template <Hashable V, Hashable E, typename Observer> Result<std::size_t, ErrorType> DirectedGraph<V, E, Observer>::delete_vertex(std::size_t vertex_id) {
+        return instrumented(GraphOperation::DELETE_VERTEX, [&] {
+            if (!vertex_index.contains(vertex_id)) {
+                return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            if (adjacency_list.contains(vertex_id) && adjacency_list[vertex_id].incoming_edges.empty() && adjacency_list[vertex_id].outgoing_edges.empty()) {
+                adjacency_list.erase(vertex_id);
+                vertex_index.erase(vertex_id);
+                detail::notify_vertex_deleted(observer, vertex_id);
+                return Result<std::size_t, ErrorType>::success(vertex_id);
+            }
+            return Result<std::size_t, ErrorType>::error(ErrorType::VERTEX_NOT_FREE);
+        });
+    }
 
-        if (std::size_t edge_id {std::hash<E>{}(e)}; edge_index.contains(edge_id)) {
-            if (Edge edge_info = edge_index.at(edge_id); edge_info.from_id != from_id || edge_info.to_id != to_id) {
-                return Result<std::size_t, ErrorType>::error(ErrorType::EDGE_ALREADY_EXISTS);
+    template <Hashable V, Hashable E, typename Observer> Result<std::size_t, ErrorType> DirectedGraph<V, E, Observer>::add_edge(std::size_t from_id, std::size_t to_id, const E& e) {
+        return instrumented(GraphOperation::ADD_EDGE, [&] {
+            if (!vertex_index.contains(from_id) || !vertex_index.contains(to_id)) {
+                return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_VERTEX);
             }
-            return Result<std::size_t, ErrorType>::success(edge_id);
-        } else {
-            edge_index.emplace(edge_id, Edge<E>{from_id, to_id, e});
-            adjacency_list[from_id].outgoing_edges.insert(edge_id);
-            adjacency_list[to_id].incoming_edges.insert(edge_id);
-            return Result<std::size_t, ErrorType>::success(edge_id);
-        }
+
+            if (std::size_t edge_id {std::hash<E>{}(e)}; edge_index.contains(edge_id)) {
+                if (Edge edge_info = edge_index.at(edge_id); edge_info.from_id != from_id || edge_info.to_id != to_id) {
+                    return Result<std::size_t, ErrorType>::error(ErrorType::EDGE_ALREADY_EXISTS);
+                }
+                return Result<std::size_t, ErrorType>::success(edge_id);
+            } else {
+                edge_index.emplace(edge_id, Edge<E>{from_id, to_id, e});
+                adjacency_list[from_id].outgoing_edges.insert(edge_id);
+                adjacency_list[to_id].incoming_edges.insert(edge_id);
+                detail::notify_edge_added(observer, edge_id, from_id, to_id);
+                return Result<std::size_t, ErrorType>::success(edge_id);
+            }
+        });
     }
 
-    template <Hashable V, Hashable E> Result<std::size_t, ErrorType> DirectedGraph<V, E>::delete_edge(std::size_t edge_id) {
-        if (auto it = edge_index.find(edge_id); it != edge_index.end()) {
-            const auto& [from_id, to_id, _] = it->second;
-            edge_index.erase(it);
-            adjacency_list[from_id].outgoing_edges.erase(edge_id);
-            adjacency_list[to_id].incoming_edges.erase(edge_id);
-            return Result<std::size_t, ErrorType>::success(edge_id);
-        }
-        return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_EDGE);
+    template <Hashable V, Hashable E, typename Observer> Result<std::size_t, ErrorType> DirectedGraph<V, E, Observer>::delete_edge(std::size_t edge_id) {
+        return instrumented(GraphOperation::DELETE_EDGE, [&] {
+            if (auto it = edge_index.find(edge_id); it != edge_index.end()) {
+                const std::size_t from_id {it->second.from_id};
+                const std::size_t to_id {it->second.to_id};
+                edge_index.erase(it);
+                adjacency_list[from_id].outgoing_edges.erase(edge_id);
+                adjacency_list[to_id].incoming_edges.erase(edge_id);
+                detail::notify_edge_deleted(observer, edge_id, from_id, to_id);
+                return Result<std::size_t, ErrorType>::success(edge_id);
+            }
+            return Result<std::size_t, ErrorType>::error(ErrorType::ABSENT_EDGE);
+        });
     }
 
-    template <Hashable V, Hashable E> Result<V, ErrorType> DirectedGraph<V, E>::get_vertex(std::size_t id) const {
-        if (vertex_index.contains(id)) {
-            return Result<V, ErrorType>::success(vertex_index.at(id));
-        }
-        return Result<V, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+    template <Hashable V, Hashable E, typename Observer> Result<V, ErrorType> DirectedGraph<V, E, Observer>::get_vertex(std::size_t id) const {
+        return instrumented(GraphOperation::GET_VERTEX, [&] {
+            if (vertex_index.contains(id)) {
+                return Result<V, ErrorType>::success(vertex_index.at(id));
+            }
+            return Result<V, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+        });
     }
 
-    template <Hashable V, Hashable E> Result<Edge<E>, ErrorType> DirectedGraph<V, E>::get_edge(std::size_t id) const {
-        if (edge_index.contains(id)) {
-            return Result<Edge<E>, ErrorType>::success(edge_index.at(id));
-        }
-        return Result<Edge<E>, ErrorType>::error(ErrorType::ABSENT_EDGE);
+    template <Hashable V, Hashable E, typename Observer> Result<Edge<E>, ErrorType> DirectedGraph<V, E, Observer>::get_edge(std::size_t id) const {
+        return instrumented(GraphOperation::GET_EDGE, [&] {
+            if (edge_index.contains(id)) {
+                return Result<Edge<E>, ErrorType>::success(edge_index.at(id));
+            }
+            return Result<Edge<E>, ErrorType>::error(ErrorType::ABSENT_EDGE);
+        });
     }
 
-    template <Hashable V, Hashable E> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E>::get_children(std::size_t vertex_id) const {
-        if (!adjacency_list.contains(vertex_id)) {
-            return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+    template <Hashable V, Hashable E, typename Observer>
+    template <typename Map, typename T>
+    void DirectedGraph<V, E, Observer>::batch_lookup(const Map& index, std::span<const std::size_t> ids, std::vector<Result<T, ErrorType>>& out, const ErrorType absent) {
+        out.clear();
+        out.reserve(ids.size());
+
+        std::array<std::size_t, PREFETCH_WINDOW> buckets {};
+        for (std::size_t start {0}; start < ids.size(); start += PREFETCH_WINDOW) {
+            const auto window {ids.subspan(start, std::min(PREFETCH_WINDOW, ids.size() - start))};
+
+            // Hash every key first, then touch the bucket heads. The loads are independent so they are in flight together.
+            for (std::size_t i {0}; i < window.size(); ++i) {
+                buckets[i] = index.bucket(window[i]);
+            }
+            for (std::size_t i {0}; i < window.size(); ++i) {
+                if (auto it = index.begin(buckets[i]); it != index.end(buckets[i])) {
+                    detail::prefetch_read(std::addressof(*it));
+                }
+            }
+
+            for (const std::size_t id : window) {
+                if (auto it = index.find(id); it != index.end()) {
+                    out.push_back(Result<T, ErrorType>::success(it->second));
+                } else {
+                    out.push_back(Result<T, ErrorType>::error(absent));
+                }
+            }
         }
-        auto children = adjacency_list.at(vertex_id).outgoing_edges
-        | std::views::transform([this](const auto& edge_id) {
-            return edge_index.at(edge_id).to_id;
-          });
-        std::unordered_set<std::size_t> children_set(children.begin(), children.end());
-        return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(children_set));
     }
 
-    template <Hashable V, Hashable E> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E>::get_parents(std::size_t vertex_id) const {
-        if (!adjacency_list.contains(vertex_id)) {
-            return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
-        }
-        auto parents = adjacency_list.at(vertex_id).incoming_edges
-        | std::views::transform([this](const auto& edge_id) {
-            return edge_index.at(edge_id).from_id;
-          });
-        std::unordered_set<std::size_t> parent_set(parents.begin(), parents.end());
-        return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(parent_set));
+    template <Hashable V, Hashable E, typename Observer> void DirectedGraph<V, E, Observer>::get_vertices(std::span<const std::size_t> ids, std::vector<Result<V, ErrorType>>& out) const {
+        return instrumented(GraphOperation::GET_VERTICES, [&] {
+            batch_lookup(vertex_index, ids, out, ErrorType::ABSENT_VERTEX);
+        });
     }
 
-    template <Hashable V, Hashable E> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E>::get_neighbours(std::size_t vertex_id) const {
-        if (!adjacency_list.contains(vertex_id)) {
-            return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
-        }
+    template <Hashable V, Hashable E, typename Observer> void DirectedGraph<V, E, Observer>::get_edges(std::span<const std::size_t> ids, std::vector<Result<Edge<E>, ErrorType>>& out) const {
+        return instrumented(GraphOperation::GET_EDGES, [&] {
+            batch_lookup(edge_index, ids, out, ErrorType::ABSENT_EDGE);
+        });
+    }
+
+    template <Hashable V, Hashable E, typename Observer> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E, Observer>::get_children(std::size_t vertex_id) const {
+        return instrumented(GraphOperation::GET_CHILDREN, [&] {
+            if (!adjacency_list.contains(vertex_id)) {
+                return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            auto children = adjacency_list.at(vertex_id).outgoing_edges
+            | std::views::transform([this](const auto& edge_id) {
+                return edge_index.at(edge_id).to_id;
+              });
+            std::unordered_set<std::size_t> children_set(children.begin(), children.end());
+            return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(children_set));
+        });
+    }
+
+    template <Hashable V, Hashable E, typename Observer> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E, Observer>::get_parents(std::size_t vertex_id) const {
+        return instrumented(GraphOperation::GET_PARENTS, [&] {
+            if (!adjacency_list.contains(vertex_id)) {
+                return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            auto parents = adjacency_list.at(vertex_id).incoming_edges
+            | std::views::transform([this](const auto& edge_id) {
+                return edge_index.at(edge_id).from_id;
+              });
+            std::unordered_set<std::size_t> parent_set(parents.begin(), parents.end());
+            return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(parent_set));
+        });
+    }
+
+    template <Hashable V, Hashable E, typename Observer> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E, Observer>::get_neighbours(std::size_t vertex_id) const {
+        return instrumented(GraphOperation::GET_NEIGHBOURS, [&] {
+            if (!adjacency_list.contains(vertex_id)) {
+                return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
 
-        auto children = adjacency_list.at(vertex_id).outgoing_edges
-        | std::views::transform([this](const auto& edge_id) {
-            return edge_index.at(edge_id).to_id;
-          });
+            auto children = adjacency_list.at(vertex_id).outgoing_edges
+            | std::views::transform([this](const auto& edge_id) {
+                return edge_index.at(edge_id).to_id;
+              });
 
-        auto parents = adjacency_list.at(vertex_id).incoming_edges
-        | std::views::transform([this](const auto& edge_id) {
-            return edge_index.at(edge_id).from_id;
-          });
+            auto parents = adjacency_list.at(vertex_id).incoming_edges
+            | std::views::transform([this](const auto& edge_id) {
+                return edge_index.at(edge_id).from_id;
+              });
 
-        std::unordered_set<std::size_t> neighbours {children.begin(), children.end()};
-        neighbours.insert(parents.begin(), parents.end());
+            std::unordered_set<std::size_t> neighbours {children.begin(), children.end()};
+            neighbours.insert(parents.begin(), parents.end());
 
-        return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(neighbours));
+            return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(neighbours));
+        });
     }
 
-    template <Hashable V, Hashable E> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E>::get_outgoing_edges(std::size_t vertex_id) const {
-        if (!adjacency_list.contains(vertex_id)) {
-            return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
-        }
-        auto children {adjacency_list.at(vertex_id).outgoing_edges};
-        return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(children));
+    template <Hashable V, Hashable E, typename Observer> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E, Observer>::get_outgoing_edges(std::size_t vertex_id) const {
+        return instrumented(GraphOperation::GET_OUTGOING_EDGES, [&] {
+            if (!adjacency_list.contains(vertex_id)) {
+                return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            auto children {adjacency_list.at(vertex_id).outgoing_edges};
+            return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(children));
+        });
     }
 
-    template <Hashable V, Hashable E> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E>::get_incoming_edges(std::size_t vertex_id) const {
-        if (!adjacency_list.contains(vertex_id)) {
-            return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
-        }
-        auto children {adjacency_list.at(vertex_id).incoming_edges};
-        return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(children));
+    template <Hashable V, Hashable E, typename Observer> Result<std::unordered_set<std::size_t>, ErrorType> DirectedGraph<V, E, Observer>::get_incoming_edges(std::size_t vertex_id) const {
+        return instrumented(GraphOperation::GET_INCOMING_EDGES, [&] {
+            if (!adjacency_list.contains(vertex_id)) {
+                return Result<std::unordered_set<std::size_t>, ErrorType>::error(ErrorType::ABSENT_VERTEX);
+            }
+            auto children {adjacency_list.at(vertex_id).incoming_edges};
+            return Result<std::unordered_set<std::size_t>, ErrorType>::success(std::move(children));
+        });
+    }
+
+    template <Hashable V, Hashable E, typename Observer> GraphStats DirectedGraph<V, E, Observer>::stats(const StatsOptions& options) const {
+        const std::size_t vertex_buckets {vertex_index.bucket_count()};
+        const std::size_t edge_buckets {edge_index.bucket_count()};
+        const std::size_t adjacency_buckets {adjacency_list.bucket_count()};
+        std::vector<detail::StatsAccumulator> partial(worker_count(options.threads));
+
+        // One index space over the buckets of all three tables, so a single pass balances them across workers.
+        parallel_for(vertex_buckets + edge_buckets + adjacency_buckets, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+            detail::StatsAccumulator& accumulator {partial[worker]};
+            for (std::size_t i {begin}; i < end; ++i) {
+                if (i < vertex_buckets) {
+                    accumulator.vertex_table.add(vertex_index.bucket_size(i));
+                } else if (i < vertex_buckets + edge_buckets) {
+                    accumulator.edge_table.add(edge_index.bucket_size(i - vertex_buckets));
+                } else {
+                    const std::size_t bucket {i - vertex_buckets - edge_buckets};
+                    accumulator.adjacency_table.add(adjacency_list.bucket_size(bucket));
+                    for (auto it {adjacency_list.begin(bucket)}; it != adjacency_list.end(bucket); ++it) {
+                        accumulator.add_vertex(Hub{it->first, it->second.outgoing_edges.size(), it->second.incoming_edges.size()}, options.top_hubs);
+                    }
+                }
+            }
+        }, options.threads);
+
+        return detail::merge_stats(partial, vertex_index, edge_index, adjacency_list, options.top_hubs);
     }
 }
@@ -0,0 +1,225 @@
+/**
+ * @file graph_stats.hpp
+ *
+ * @brief Hash table health and degree diagnostics reported by `DirectedGraph::stats()`.
+ *
+ * @Detail
+ * A `DirectedGraph` keeps its vertices, edges and adjacency in separately chained hash tables keyed by id, and ids are
+ * the hashes of the payloads. A weak `std::hash` (such as the identity hash of `DefaultEdge` fed with strided ids)
+ * piles keys into a few buckets, and a handful of hub vertices can own most of the edges. Both show up as latency
+ * spikes with no obvious cause. `GraphStats` makes them visible:
+ *
+ * - `HashTableStats` describes one table: load, occupied buckets, colliding keys and chain lengths. Chain length is
+ *   the probe length of a chained table, so `mean_probe_length` is the expected number of nodes a successful lookup
+ *   visits and `max_chain_length` bounds the worst lookup.
+ * - `DegreeDistribution` summarizes the out or in degrees of all vertices, and `hubs` lists the highest degree vertices.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace cgrapht {
+
+    /**
+     * @brief Options for `DirectedGraph::stats()`.
+     */
+    struct StatsOptions {
+        std::size_t top_hubs {10};  ///< Number of highest degree vertices to report.
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Occupancy and chain lengths of one hash table.
+     */
+    struct HashTableStats {
+        /// Chain lengths above this are counted in the last histogram slot.
+        static constexpr std::size_t HISTOGRAM_LIMIT {8};
+
+        std::size_t size {0};               ///< Stored keys.
+        std::size_t bucket_count {0};       ///< Allocated buckets.
+        double load_factor {0};             ///< Keys per bucket.
+        double max_load_factor {0};         ///< Load factor that triggers a rehash.
+        std::size_t occupied_buckets {0};   ///< Buckets holding at least one key.
+        std::size_t colliding_keys {0};     ///< Keys that share their bucket with an earlier key of the chain.
+        std::size_t max_chain_length {0};   ///< Longest chain.
+        double mean_chain_length {0};       ///< Mean chain length over occupied buckets.
+        double mean_probe_length {0};       ///< Mean nodes visited by a successful lookup.
+        /// Entry `i` counts buckets with a chain of length `i`, the last entry those longer than `HISTOGRAM_LIMIT - 1`.
+        std::array<std::size_t, HISTOGRAM_LIMIT + 1> chain_length_histogram {};
+    };
+
+    /**
+     * @brief Summary of a degree distribution. Percentiles use the nearest rank method.
+     */
+    struct DegreeDistribution {
+        double mean {0};
+        std::size_t max {0};
+        std::size_t p50 {0};
+        std::size_t p90 {0};
+        std::size_t p99 {0};
+    };
+
+    /**
+     * @brief A high degree vertex.
+     */
+    struct Hub {
+        std::size_t vertex_id;
+        std::size_t out_degree;
+        std::size_t in_degree;
+
+        bool operator==(const Hub& other) const = default;
+    };
+
+    /**
+     * @brief Diagnostics of a `DirectedGraph`.
+     */
+    struct GraphStats {
+        HashTableStats vertex_table {};     ///< Vertex id to payload.
+        HashTableStats edge_table {};       ///< Edge id to edge record.
+        HashTableStats adjacency_table {};  ///< Vertex id to incident edge sets.
+        DegreeDistribution out_degree {};
+        DegreeDistribution in_degree {};
+        std::vector<Hub> hubs {};           ///< Highest total degree first, ties by ascending vertex id.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        struct ChainAccumulator {
+            std::size_t occupied {0};
+            std::size_t max_chain {0};
+            std::size_t probe_sum {0};
+            std::array<std::size_t, HashTableStats::HISTOGRAM_LIMIT + 1> histogram {};
+
+            void add(const std::size_t length) {
+                ++histogram[std::min(length, HashTableStats::HISTOGRAM_LIMIT)];
+                if (length != 0) {
+                    ++occupied;
+                    max_chain = std::max(max_chain, length);
+                    // The k-th key of a chain takes k steps to find.
+                    probe_sum += length * (length + 1) / 2;
+                }
+            }
+
+            void merge(const ChainAccumulator& other) {
+                occupied += other.occupied;
+                max_chain = std::max(max_chain, other.max_chain);
+                probe_sum += other.probe_sum;
+                for (std::size_t i {0}; i < histogram.size(); ++i) {
+                    histogram[i] += other.histogram[i];
+                }
+            }
+
+            template <typename Map>
+            [[nodiscard]] HashTableStats finish(const Map& map) const {
+                HashTableStats stats {};
+                stats.size = map.size();
+                stats.bucket_count = map.bucket_count();
+                stats.load_factor = map.load_factor();
+                stats.max_load_factor = map.max_load_factor();
+                stats.occupied_buckets = occupied;
+                stats.colliding_keys = map.size() - occupied;
+                stats.max_chain_length = max_chain;
+                stats.mean_chain_length = occupied == 0 ? 0 : static_cast<double>(map.size()) / static_cast<double>(occupied);
+                stats.mean_probe_length = map.empty() ? 0 : static_cast<double>(probe_sum) / static_cast<double>(map.size());
+                stats.chain_length_histogram = histogram;
+                return stats;
+            }
+        };
+
+        inline bool heavier(const Hub& a, const Hub& b) {
+            const std::size_t degree_a {a.out_degree + a.in_degree};
+            const std::size_t degree_b {b.out_degree + b.in_degree};
+            return degree_a != degree_b ? degree_a > degree_b : a.vertex_id < b.vertex_id;
+        }
+
+        /**
+         * Per worker state of the stats pass. Hubs are kept as a heap whose top is the lightest retained hub.
+         */
+        struct StatsAccumulator {
+            ChainAccumulator vertex_table {};
+            ChainAccumulator edge_table {};
+            ChainAccumulator adjacency_table {};
+            std::vector<std::size_t> out_degrees {};
+            std::vector<std::size_t> in_degrees {};
+            std::vector<Hub> hubs {};
+
+            void add_vertex(const Hub& hub, const std::size_t top_hubs) {
+                out_degrees.push_back(hub.out_degree);
+                in_degrees.push_back(hub.in_degree);
+                if (top_hubs == 0) {
+                    return;
+                }
+                if (hubs.size() < top_hubs) {
+                    hubs.push_back(hub);
+                    std::ranges::push_heap(hubs, heavier);
+                } else if (heavier(hub, hubs.front())) {
+                    std::ranges::pop_heap(hubs, heavier);
+                    hubs.back() = hub;
+                    std::ranges::push_heap(hubs, heavier);
+                }
+            }
+        };
+
+        inline DegreeDistribution summarize_degrees(std::vector<std::size_t>& degrees) {
+            DegreeDistribution distribution {};
+            if (degrees.empty()) {
+                return distribution;
+            }
+            std::ranges::sort(degrees);
+            std::size_t total {0};
+            for (const std::size_t degree : degrees) {
+                total += degree;
+            }
+            auto percentile = [&degrees](const std::size_t per_mille) {
+                const std::size_t rank {(degrees.size() * per_mille + 999) / 1000};
+                return degrees[std::max<std::size_t>(rank, 1) - 1];
+            };
+            distribution.mean = static_cast<double>(total) / static_cast<double>(degrees.size());
+            distribution.max = degrees.back();
+            distribution.p50 = percentile(500);
+            distribution.p90 = percentile(900);
+            distribution.p99 = percentile(990);
+            return distribution;
+        }
+
+        template <typename VertexMap, typename EdgeMap, typename AdjacencyMap>
+        GraphStats merge_stats(std::span<const StatsAccumulator> partial, const VertexMap& vertex_index, const EdgeMap& edge_index,
+                               const AdjacencyMap& adjacency_list, const std::size_t top_hubs) {
+            ChainAccumulator vertex_table {};
+            ChainAccumulator edge_table {};
+            ChainAccumulator adjacency_table {};
+            std::vector<std::size_t> out_degrees {};
+            std::vector<std::size_t> in_degrees {};
+            std::vector<Hub> hubs {};
+            out_degrees.reserve(adjacency_list.size());
+            in_degrees.reserve(adjacency_list.size());
+            for (const StatsAccumulator& worker : partial) {
+                vertex_table.merge(worker.vertex_table);
+                edge_table.merge(worker.edge_table);
+                adjacency_table.merge(worker.adjacency_table);
+                out_degrees.insert(out_degrees.end(), worker.out_degrees.begin(), worker.out_degrees.end());
+                in_degrees.insert(in_degrees.end(), worker.in_degrees.begin(), worker.in_degrees.end());
+                hubs.insert(hubs.end(), worker.hubs.begin(), worker.hubs.end());
+            }
+
+            GraphStats stats {};
+            stats.vertex_table = vertex_table.finish(vertex_index);
+            stats.edge_table = edge_table.finish(edge_index);
+            stats.adjacency_table = adjacency_table.finish(adjacency_list);
+            stats.out_degree = summarize_degrees(out_degrees);
+            stats.in_degree = summarize_degrees(in_degrees);
+            std::ranges::sort(hubs, heavier);
+            hubs.resize(std::min(hubs.size(), top_hubs));
+            stats.hubs = std::move(hubs);
+            return stats;
+        }
+    }
+    /// @endcond
+}
@@ -0,0 +1,320 @@
+/**
+ * @file metrics.hpp
+ *
+ * @brief Operation counters and latency histograms for `DirectedGraph`.
+ *
+ * @Detail
+ * `OperationMetrics` is an instrumentation observer policy (see `observers.hpp`). Use it as the third template argument
+ * of `DirectedGraph`, alone or inside an `ObserverChain`, and every public graph operation is counted, its errors are
+ * broken down by `ErrorType`, and its latency is recorded in a log-linear histogram. Graphs without it are not
+ * instrumented at all.
+ *
+ * Recording rarely contends: each thread writes to its own shard of counters, and the shards are only summed when a
+ * snapshot is taken. A thread only takes the registry lock, to look up its shard, when it records into a different graph
+ * than last time. The histogram keeps 8 linear sub-buckets per power of two, so any recorded latency is known to
+ * within 12.5%.
+ *
+ * ```cpp
+ * DirectedGraph<int, DefaultEdge, OperationMetrics> graph;
+ * ...
+ * MetricsSnapshot snapshot {graph.get_observer().snapshot()};
+ * std::cout << to_prometheus(snapshot);
+ * ```
+ *
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "cgrapht/models.hpp"
+#include "cgrapht/observers.hpp"
+
+namespace cgrapht {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        inline constexpr std::size_t OPERATION_KINDS {static_cast<std::size_t>(GraphOperation::GET_INCOMING_EDGES) + 1};
+        inline constexpr std::size_t ERROR_KINDS {static_cast<std::size_t>(ErrorType::UNKNOWN) + 1};
+
+        inline constexpr unsigned SUB_BUCKET_BITS {3};
+        inline constexpr std::uint64_t EXACT_LIMIT {std::uint64_t{1} << (SUB_BUCKET_BITS + 1)};
+        inline constexpr std::size_t LATENCY_BUCKETS {EXACT_LIMIT + (64 - SUB_BUCKET_BITS - 1) * (std::size_t{1} << SUB_BUCKET_BITS)};
+
+        constexpr std::size_t latency_bucket(const std::uint64_t nanoseconds) {
+            if (nanoseconds < EXACT_LIMIT) {
+                return static_cast<std::size_t>(nanoseconds);
+            }
+            const unsigned exponent {static_cast<unsigned>(std::bit_width(nanoseconds)) - 1};
+            const std::uint64_t mantissa {(nanoseconds >> (exponent - SUB_BUCKET_BITS)) & ((std::uint64_t{1} << SUB_BUCKET_BITS) - 1)};
+            return EXACT_LIMIT + (exponent - SUB_BUCKET_BITS - 1) * (std::size_t{1} << SUB_BUCKET_BITS) + static_cast<std::size_t>(mantissa);
+        }
+
+        constexpr std::uint64_t latency_bucket_lower_bound(const std::size_t bucket) {
+            if (bucket < EXACT_LIMIT) {
+                return bucket;
+            }
+            const std::size_t offset {bucket - EXACT_LIMIT};
+            const unsigned exponent {static_cast<unsigned>(offset >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS + 1};
+            const std::uint64_t mantissa {offset & ((std::size_t{1} << SUB_BUCKET_BITS) - 1)};
+            return ((std::uint64_t{1} << SUB_BUCKET_BITS) | mantissa) << (exponent - SUB_BUCKET_BITS);
+        }
+
+        /**
+         * Shortest decimal form that reads back as the same double. `std::to_string` prints six fixed decimals, which
+         * collapses every sub-microsecond bound to "0.000000".
+         */
+        inline std::string format_double(const double value) {
+            std::array<char, 32> buffer {};
+            const auto result {std::to_chars(buffer.data(), buffer.data() + buffer.size(), value)};
+            return std::string{buffer.data(), result.ptr};
+        }
+
+        struct OperationShard {
+            std::atomic<std::uint64_t> count {0};
+            std::atomic<std::uint64_t> total_nanoseconds {0};
+            std::array<std::atomic<std::uint64_t>, ERROR_KINDS> errors {};
+            std::array<std::atomic<std::uint64_t>, LATENCY_BUCKETS> latency {};
+        };
+
+        // Only the owning thread writes a shard, so plain load + store is enough and avoids locked instructions.
+        inline void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t by = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        struct MetricsShard {
+            std::array<OperationShard, OPERATION_KINDS> operations {};
+        };
+
+        struct MetricsRegistry {
+            std::uint64_t id;
+            std::mutex mutex {};
+            std::deque<MetricsShard> shards {};
+            std::unordered_map<std::thread::id, MetricsShard*> shard_of_thread {};  // guarded by `mutex`
+
+            static std::uint64_t next_id() {
+                static std::atomic<std::uint64_t> counter {0};
+                return counter.fetch_add(1) + 1;
+            }
+
+            MetricsRegistry() : id{next_id()} {}
+
+            MetricsShard& local_shard() {
+                // The thread remembers only the registry it recorded into last. Registries get unique ids that are
+                // never reused, so the cached pointer is only followed while its registry is alive.
+                thread_local std::uint64_t cached_id {0};
+                thread_local MetricsShard* cached_shard {nullptr};
+                if (cached_id == id) {
+                    return *cached_shard;
+                }
+                std::scoped_lock lock {mutex};
+                MetricsShard*& shard {shard_of_thread[std::this_thread::get_id()]};
+                if (shard == nullptr) {
+                    shard = &shards.emplace_back();
+                }
+                cached_id = id;
+                cached_shard = shard;
+                return *shard;
+            }
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Aggregated statistics of one operation kind.
+     */
+    struct OperationStats {
+        std::uint64_t count {0};                                    ///< Calls, successful or not.
+        std::uint64_t total_nanoseconds {0};                        ///< Summed latency.
+        std::array<std::uint64_t, detail::ERROR_KINDS> errors {};   ///< Failed calls, indexed by `ErrorType`.
+        std::array<std::uint64_t, detail::LATENCY_BUCKETS> latency {};  ///< Latency histogram, see `bucket_lower_bound`.
+
+        /**
+         * @brief Failed calls with the given error.
+         */
+        [[nodiscard]] std::uint64_t error_count(const ErrorType error) const {
+            return errors[static_cast<std::size_t>(error)];
+        }
+
+        /**
+         * @brief Smallest latency, in nanoseconds, that falls into histogram bucket `bucket`.
+         */
+        [[nodiscard]] static constexpr std::uint64_t bucket_lower_bound(const std::size_t bucket) {
+            return detail::latency_bucket_lower_bound(bucket);
+        }
+
+        /**
+         * @brief Latency below which a fraction `quantile` of the calls completed, rounded up to a bucket boundary.
+         * @param quantile Value in `[0, 1]`.
+         * @return Nanoseconds, or 0 if nothing was recorded.
+         */
+        [[nodiscard]] std::uint64_t latency_quantile(const double quantile) const {
+            const auto target {static_cast<std::uint64_t>(quantile * static_cast<double>(count))};
+            std::uint64_t seen {0};
+            for (std::size_t bucket {0}; bucket < latency.size(); ++bucket) {
+                seen += latency[bucket];
+                if (seen > target || (seen == count && seen != 0)) {
+                    return bucket + 1 < latency.size() ? bucket_lower_bound(bucket + 1) : bucket_lower_bound(bucket);
+                }
+            }
+            return 0;
+        }
+    };
+
+    /**
+     * @brief Point in time copy of all counters, indexed by `GraphOperation`.
+     */
+    struct MetricsSnapshot {
+        std::array<OperationStats, detail::OPERATION_KINDS> operations {};
+
+        /**
+         * @brief Statistics of one operation kind.
+         */
+        [[nodiscard]] const OperationStats& operator[](const GraphOperation operation) const {
+            return operations[static_cast<std::size_t>(operation)];
+        }
+    };
+
+    /**
+     * @brief Instrumentation observer policy recording per-operation counters and latency histograms.
+     *
+     * Copies share the same counters, so a copied graph keeps reporting into the original metrics.
+     */
+    class OperationMetrics {
+    private:
+        std::shared_ptr<detail::MetricsRegistry> registry {std::make_shared<detail::MetricsRegistry>()};
+
+    public:
+        void on_operation(const GraphOperation operation, const std::optional<ErrorType> error, const std::uint64_t nanoseconds) const {
+            detail::OperationShard& shard {registry->local_shard().operations[static_cast<std::size_t>(operation)]};
+            detail::bump(shard.count);
+            detail::bump(shard.total_nanoseconds, nanoseconds);
+            detail::bump(shard.latency[detail::latency_bucket(nanoseconds)]);
+            if (error) {
+                detail::bump(shard.errors[static_cast<std::size_t>(*error)]);
+            }
+        }
+
+        /**
+         * @brief Sum the per-thread counters. Safe to call while other threads keep recording.
+         */
+        [[nodiscard]] MetricsSnapshot snapshot() const {
+            MetricsSnapshot result {};
+            std::scoped_lock lock {registry->mutex};
+            for (const detail::MetricsShard& shard : registry->shards) {
+                for (std::size_t op {0}; op < detail::OPERATION_KINDS; ++op) {
+                    const detail::OperationShard& source {shard.operations[op]};
+                    OperationStats& target {result.operations[op]};
+                    target.count += source.count.load(std::memory_order_relaxed);
+                    target.total_nanoseconds += source.total_nanoseconds.load(std::memory_order_relaxed);
+                    for (std::size_t e {0}; e < detail::ERROR_KINDS; ++e) {
+                        target.errors[e] += source.errors[e].load(std::memory_order_relaxed);
+                    }
+                    for (std::size_t b {0}; b < detail::LATENCY_BUCKETS; ++b) {
+                        target.latency[b] += source.latency[b].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief Lower case name of an operation, as used in exported metrics.
+     */
+    constexpr std::string_view to_string(const GraphOperation operation) {
+        constexpr std::array<std::string_view, detail::OPERATION_KINDS> names {
+            "add_vertex", "delete_vertex", "add_edge", "delete_edge", "get_vertex", "get_edge", "get_vertices", "get_edges",
+            "get_children", "get_parents", "get_neighbours", "get_outgoing_edges", "get_incoming_edges"
+        };
+        return names[static_cast<std::size_t>(operation)];
+    }
+
+    /**
+     * @brief Name of an error, matching the enumerator.
+     */
+    constexpr std::string_view to_string(const ErrorType error) {
+        constexpr std::array<std::string_view, detail::ERROR_KINDS> names {
+            "INVALID_ARGUMENT", "ABSENT_VERTEX", "ABSENT_EDGE", "EDGE_ALREADY_EXISTS", "VERTEX_NOT_FREE", "CYCLE_DETECTED", "UNKNOWN"
+        };
+        return names[static_cast<std::size_t>(error)];
+    }
+
+    /**
+     * @brief Render a snapshot in the Prometheus text exposition format.
+     *
+     * Emits `<prefix>_operations_total` and `<prefix>_operation_errors_total` counters and a
+     * `<prefix>_operation_latency_seconds` histogram. Operations that were never called are omitted.
+     *
+     * Every histogram has the same fixed bounds, `2^e - 1` nanoseconds for `e` in `4 .. 40`, plus `+Inf`. Latencies are
+     * whole nanoseconds and powers of two are bucket boundaries, so each `le` count is exact.
+     *
+     * @param snapshot Metrics to render.
+     * @param prefix Metric name prefix.
+     */
+    inline std::string to_prometheus(const MetricsSnapshot& snapshot, const std::string_view prefix = "cgrapht") {
+        const std::string name {prefix};
+        std::string out {};
+        auto line = [&out](const std::string& text) {
+            out += text;
+            out += '\n';
+        };
+        auto label = [](const GraphOperation operation) {
+            return std::string{"operation=\""} + std::string{to_string(operation)} + "\"";
+        };
+
+        line("# TYPE " + name + "_operations_total counter");
+        for (std::size_t op {0}; op < detail::OPERATION_KINDS; ++op) {
+            if (snapshot.operations[op].count != 0) {
+                line(name + "_operations_total{" + label(static_cast<GraphOperation>(op)) + "} " + std::to_string(snapshot.operations[op].count));
+            }
+        }
+
+        line("# TYPE " + name + "_operation_errors_total counter");
+        for (std::size_t op {0}; op < detail::OPERATION_KINDS; ++op) {
+            for (std::size_t e {0}; e < detail::ERROR_KINDS; ++e) {
+                if (snapshot.operations[op].errors[e] != 0) {
+                    line(name + "_operation_errors_total{" + label(static_cast<GraphOperation>(op)) + ",error=\"" +
+                         std::string{to_string(static_cast<ErrorType>(e))} + "\"} " + std::to_string(snapshot.operations[op].errors[e]));
+                }
+            }
+        }
+
+        line("# TYPE " + name + "_operation_latency_seconds histogram");
+        for (std::size_t op {0}; op < detail::OPERATION_KINDS; ++op) {
+            const OperationStats& stats {snapshot.operations[op]};
+            if (stats.count == 0) {
+                continue;
+            }
+            const std::string series {name + "_operation_latency_seconds"};
+            const std::string operation {label(static_cast<GraphOperation>(op))};
+
+            // The buckets below `2^e` hold exactly the latencies of at most `2^e - 1` nanoseconds.
+            std::uint64_t cumulative {0};
+            std::size_t bucket {0};
+            for (unsigned exponent {4}; exponent <= 40; ++exponent) {
+                const std::uint64_t bound {std::uint64_t{1} << exponent};
+                while (bucket < stats.latency.size() && detail::latency_bucket_lower_bound(bucket) < bound) {
+                    cumulative += stats.latency[bucket++];
+                }
+                line(series + "_bucket{" + operation + ",le=\"" + detail::format_double(static_cast<double>(bound - 1) / 1e9) + "\"} " + std::to_string(cumulative));
+            }
+            line(series + "_bucket{" + operation + ",le=\"+Inf\"} " + std::to_string(stats.count));
+            line(series + "_sum{" + operation + "} " + detail::format_double(static_cast<double>(stats.total_nanoseconds) / 1e9));
+            line(series + "_count{" + operation + "} " + std::to_string(stats.count));
+        }
+        return out;
+    }
+}
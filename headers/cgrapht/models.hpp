@@ -150,6 +150,7 @@ namespace cgrapht {
         ABSENT_EDGE,        ///< The referenced edge ID does not exist in the graph.
         EDGE_ALREADY_EXISTS,///< An edge between the two vertices already exists.
         VERTEX_NOT_FREE,    ///< The vertex cannot be removed because it still has incident edges.
+        CYCLE_DETECTED,     ///< The graph contains, or the operation would create, a directed cycle.
         UNKNOWN             ///< An unexpected internal error occurred.
     };
 
@@ -0,0 +1,339 @@
+/**
+ * @file observers.hpp
+ *
+ * @brief Mutation observers for `DirectedGraph`.
+ *
+ * @Detail
+ * A `DirectedGraph` takes an observer policy as its third template parameter and reports every successful mutation
+ * to it, after the graph has been updated. A policy opts into an event simply by declaring the matching member:
+ *
+ * ```cpp
+ * void on_vertex_added(std::size_t vertex_id);
+ * void on_vertex_deleted(std::size_t vertex_id);
+ * void on_edge_added(std::size_t edge_id, std::size_t from_id, std::size_t to_id);
+ * void on_edge_deleted(std::size_t edge_id, std::size_t from_id, std::size_t to_id);
+ * ```
+ *
+ * Hooks that a policy does not declare are never called, and the default `NoObserver` declares none, so an
+ * unobserved graph compiles to exactly the same mutation code as before observers existed. Operations that change
+ * nothing, such as re-adding an existing vertex, raise no event.
+ *
+ * A policy may additionally declare a const instrumentation hook, which the graph then calls after every public
+ * operation, reads included, with the outcome and the wall clock time it took:
+ *
+ * ```cpp
+ * void on_operation(GraphOperation operation, std::optional<ErrorType> error, std::uint64_t nanoseconds) const;
+ * ```
+ *
+ * The clock is only read for policies that declare this hook.
+ *
+ * Besides writing a custom policy, the following ready made observers are provided:
+ * - `ListenerRegistry` registers `GraphListener` objects at runtime.
+ * - `BatchingObserver` buffers events and hands them to a sink in batches.
+ * - `ObserverChain` fans every event out to several policies.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/models.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Observer policy that observes nothing. The default for `DirectedGraph`.
+     */
+    struct NoObserver {};
+
+    /**
+     * @brief Kinds of graph mutation.
+     */
+    enum class GraphEventType {
+        VERTEX_ADDED,   ///< A new vertex was inserted.
+        VERTEX_DELETED, ///< A vertex was removed.
+        EDGE_ADDED,     ///< A new edge was inserted.
+        EDGE_DELETED    ///< An edge was removed.
+    };
+
+    /**
+     * @brief A single recorded mutation.
+     *
+     * For vertex events `id` is the vertex id and `from_id` and `to_id` are equal to it. For edge events `id` is the
+     * edge id and `from_id` and `to_id` are its endpoints.
+     */
+    struct GraphEvent {
+        GraphEventType type;
+        std::size_t id;
+        std::size_t from_id;
+        std::size_t to_id;
+
+        bool operator==(const GraphEvent& other) const = default;
+    };
+
+    /**
+     * @brief Public `DirectedGraph` operations, as reported to instrumentation hooks.
+     */
+    enum class GraphOperation {
+        ADD_VERTEX,
+        DELETE_VERTEX,
+        ADD_EDGE,
+        DELETE_EDGE,
+        GET_VERTEX,
+        GET_EDGE,
+        GET_VERTICES,       ///< Batched vertex lookup.
+        GET_EDGES,          ///< Batched edge lookup.
+        GET_CHILDREN,
+        GET_PARENTS,
+        GET_NEIGHBOURS,
+        GET_OUTGOING_EDGES,
+        GET_INCOMING_EDGES
+    };
+
+    /**
+     * @brief Observer policies that want per-operation instrumentation.
+     */
+    template <typename O>
+    concept OperationObserver = requires(const O& observer, GraphOperation operation, std::optional<ErrorType> error, std::uint64_t nanoseconds) {
+        observer.on_operation(operation, error, nanoseconds);
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename Observer>
+        void notify_vertex_added(Observer& observer, const std::size_t vertex_id) {
+            if constexpr (requires { observer.on_vertex_added(vertex_id); }) {
+                observer.on_vertex_added(vertex_id);
+            }
+        }
+
+        template <typename Observer>
+        void notify_vertex_deleted(Observer& observer, const std::size_t vertex_id) {
+            if constexpr (requires { observer.on_vertex_deleted(vertex_id); }) {
+                observer.on_vertex_deleted(vertex_id);
+            }
+        }
+
+        template <typename Observer>
+        void notify_edge_added(Observer& observer, const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            if constexpr (requires { observer.on_edge_added(edge_id, from_id, to_id); }) {
+                observer.on_edge_added(edge_id, from_id, to_id);
+            }
+        }
+
+        template <typename Observer>
+        void notify_edge_deleted(Observer& observer, const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            if constexpr (requires { observer.on_edge_deleted(edge_id, from_id, to_id); }) {
+                observer.on_edge_deleted(edge_id, from_id, to_id);
+            }
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Runtime listener interface for `ListenerRegistry`. Override the events of interest.
+     */
+    class GraphListener {
+    public:
+        virtual ~GraphListener() = default;
+        virtual void on_vertex_added(std::size_t) {}
+        virtual void on_vertex_deleted(std::size_t) {}
+        virtual void on_edge_added(std::size_t, std::size_t, std::size_t) {}
+        virtual void on_edge_deleted(std::size_t, std::size_t, std::size_t) {}
+    };
+
+    /**
+     * @brief Observer policy that forwards events to listeners registered at runtime.
+     *
+     * Listeners are not owned and must be removed before they are destroyed. Listeners are called in registration
+     * order.
+     */
+    class ListenerRegistry {
+    private:
+        std::vector<GraphListener*> listeners{};
+
+    public:
+        /**
+         * @brief Register a listener. Registering the same listener twice has no effect.
+         */
+        void add_listener(GraphListener& listener) {
+            if (std::ranges::find(listeners, &listener) == listeners.end()) {
+                listeners.push_back(&listener);
+            }
+        }
+
+        /**
+         * @brief Unregister a listener.
+         */
+        void remove_listener(GraphListener& listener) {
+            std::erase(listeners, &listener);
+        }
+
+        void on_vertex_added(const std::size_t vertex_id) {
+            for (GraphListener* listener : listeners) {
+                listener->on_vertex_added(vertex_id);
+            }
+        }
+
+        void on_vertex_deleted(const std::size_t vertex_id) {
+            for (GraphListener* listener : listeners) {
+                listener->on_vertex_deleted(vertex_id);
+            }
+        }
+
+        void on_edge_added(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            for (GraphListener* listener : listeners) {
+                listener->on_edge_added(edge_id, from_id, to_id);
+            }
+        }
+
+        void on_edge_deleted(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            for (GraphListener* listener : listeners) {
+                listener->on_edge_deleted(edge_id, from_id, to_id);
+            }
+        }
+    };
+
+    /**
+     * @brief Observer policy that records events and delivers them to a sink in batches.
+     *
+     * A batch is delivered whenever `capacity` events are pending, and on `flush()`. Pending events are not delivered
+     * automatically on destruction.
+     */
+    class BatchingObserver {
+    private:
+        std::function<void(std::span<const GraphEvent>)> sink{};
+        std::size_t capacity {1024};
+        std::vector<GraphEvent> pending{};
+
+        void record(const GraphEvent& event) {
+            pending.push_back(event);
+            if (pending.size() >= capacity) {
+                flush();
+            }
+        }
+
+    public:
+        /**
+         * @brief Observer without a sink. Events accumulate until a sink is set.
+         */
+        BatchingObserver() = default;
+
+        /**
+         * @brief Observer delivering to `sink`.
+         * @param sink Called with each batch, in mutation order.
+         * @param capacity Deliver as soon as this many events are pending.
+         */
+        explicit BatchingObserver(std::function<void(std::span<const GraphEvent>)> sink, const std::size_t capacity = 1024)
+            : sink{std::move(sink)}, capacity{std::max<std::size_t>(1, capacity)} {
+            pending.reserve(this->capacity);
+        }
+
+        /**
+         * @brief Deliver all pending events now. Does nothing if there is no sink or nothing is pending.
+         */
+        void flush() {
+            if (sink && !pending.empty()) {
+                sink(pending);
+                pending.clear();
+            }
+        }
+
+        /**
+         * @brief Events recorded but not yet delivered.
+         */
+        [[nodiscard]] std::span<const GraphEvent> pending_events() const {
+            return pending;
+        }
+
+        void on_vertex_added(const std::size_t vertex_id) {
+            record({GraphEventType::VERTEX_ADDED, vertex_id, vertex_id, vertex_id});
+        }
+
+        void on_vertex_deleted(const std::size_t vertex_id) {
+            record({GraphEventType::VERTEX_DELETED, vertex_id, vertex_id, vertex_id});
+        }
+
+        void on_edge_added(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            record({GraphEventType::EDGE_ADDED, edge_id, from_id, to_id});
+        }
+
+        void on_edge_deleted(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            record({GraphEventType::EDGE_DELETED, edge_id, from_id, to_id});
+        }
+    };
+
+    /**
+     * @brief Observer policy that forwards every event to each of `Observers`, in order.
+     *
+     * Each member only receives the events it declares hooks for.
+     *
+     * @tparam Observers Observer policies.
+     */
+    template <typename... Observers>
+    class ObserverChain {
+    private:
+        std::tuple<Observers...> observers{};
+
+    public:
+        ObserverChain() = default;
+
+        /**
+         * @brief Chain the given observers.
+         */
+        explicit ObserverChain(Observers... observers) : observers{std::move(observers)...} {}
+
+        /**
+         * @brief Access the `I`-th observer.
+         */
+        template <std::size_t I>
+        auto& get() {
+            return std::get<I>(observers);
+        }
+
+        /**
+         * @brief Access the `I`-th observer.
+         */
+        template <std::size_t I>
+        const auto& get() const {
+            return std::get<I>(observers);
+        }
+
+        void on_vertex_added(const std::size_t vertex_id) {
+            std::apply([&](auto&... each) { (detail::notify_vertex_added(each, vertex_id), ...); }, observers);
+        }
+
+        void on_vertex_deleted(const std::size_t vertex_id) {
+            std::apply([&](auto&... each) { (detail::notify_vertex_deleted(each, vertex_id), ...); }, observers);
+        }
+
+        void on_edge_added(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            std::apply([&](auto&... each) { (detail::notify_edge_added(each, edge_id, from_id, to_id), ...); }, observers);
+        }
+
+        void on_edge_deleted(const std::size_t edge_id, const std::size_t from_id, const std::size_t to_id) {
+            std::apply([&](auto&... each) { (detail::notify_edge_deleted(each, edge_id, from_id, to_id), ...); }, observers);
+        }
+
+        void on_operation(const GraphOperation operation, const std::optional<ErrorType> error, const std::uint64_t nanoseconds) const
+            requires (OperationObserver<Observers> || ...)
+        {
+            auto forward = [&](const auto& each) {
+                if constexpr (OperationObserver<std::remove_cvref_t<decltype(each)>>) {
+                    each.on_operation(operation, error, nanoseconds);
+                }
+            };
+            std::apply([&](const auto&... each) { (forward(each), ...); }, observers);
+        }
+    };
+}
@@ -0,0 +1,85 @@
+/**
+ * @file parallel.hpp
+ * @brief Minimal fork-join helpers used by the parallel algorithms.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cgrapht {
+
+    /**
+     * @brief Number of workers a parallel algorithm will use.
+     *
+     * @param requested Desired worker count, or 0 for one worker per hardware thread.
+     * @return The effective worker count, at least 1.
+     */
+    inline std::size_t worker_count(const std::size_t requested = 0) {
+        if (requested != 0) {
+            return requested;
+        }
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Run `body` over `[0, count)` split into chunks, on up to `threads` workers.
+     *
+     * Chunks of `grain` indices are handed out dynamically, so uneven work per index is balanced across workers. The
+     * calling thread participates as worker 0. The first exception thrown by `body` is rethrown once all workers have
+     * stopped.
+     *
+     * @param count Number of indices.
+     * @param body Callable as `body(chunk_begin, chunk_end, worker)` where `worker` is in `[0, worker_count(threads))`
+     *        and identifies the calling worker, e.g. to select per-worker scratch space.
+     * @param threads Worker count, or 0 for one per hardware thread.
+     * @param grain Indices per chunk.
+     */
+    template <typename F>
+    void parallel_for(const std::size_t count, F&& body, const std::size_t threads = 0, const std::size_t grain = 1024) {
+        const std::size_t chunk {std::max<std::size_t>(1, grain)};
+        const std::size_t workers {std::min(worker_count(threads), (count + chunk - 1) / chunk)};
+        if (workers <= 1) {
+            if (count != 0) {
+                body(std::size_t{0}, count, std::size_t{0});
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next {0};
+        std::exception_ptr failure {};
+        std::mutex failure_mutex {};
+
+        auto run = [&](const std::size_t worker) {
+            try {
+                for (std::size_t begin {next.fetch_add(chunk)}; begin < count; begin = next.fetch_add(chunk)) {
+                    body(begin, std::min(count, begin + chunk), worker);
+                }
+            } catch (...) {
+                std::scoped_lock lock {failure_mutex};
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next.store(count);
+            }
+        };
+
+        {
+            std::vector<std::jthread> pool {};
+            pool.reserve(workers - 1);
+            for (std::size_t worker {1}; worker < workers; ++worker) {
+                pool.emplace_back(run, worker);
+            }
+            run(0);
+        }
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+}
@@ -0,0 +1,551 @@
+/**
+ * @file semiring.hpp
+ *
+ * @brief GraphBLAS style sparse matrix-vector products over the adjacency of a `FrozenGraph`.
+ *
+ * @Detail
+ * Many graph algorithms are sparse linear algebra in disguise: one BFS level is a boolean matrix-vector product, one
+ * Bellman-Ford round is a min-plus product and one PageRank iteration is an ordinary one. This header provides the
+ * shared kernel:
+ *
+ * - A semiring is a type with a `value_type` and static `zero()`, `add(a, b)` and `multiply(a, b)`, fixed at compile
+ *   time so the kernel inlines them. `zero()` is the identity of `add` and marks absent entries. A semiring may also
+ *   declare a static `terminal()`, a value `add` cannot change, which lets pull kernels stop scanning early.
+ * - `AdjacencyMatrix<T>` attaches values to the edges of a `FrozenGraph`, so that A(i, j) is the value of the edge from
+ *   dense index i to j, available both row wise (CSR) and column wise (CSC).
+ * - `GraphVector<S>` is indexed by dense vertex index and stored either dense (all values) or sparse (non zero entries
+ *   only).
+ * - `vxm` computes w = u A (propagate along edges) and `mxv` computes w = A u (gather from children).
+ *
+ * Either product can run push style, scattering each non zero input entry over its matrix row, or pull style,
+ * reducing every output entry over its matrix column. Push costs time proportional to the edges of the non zero
+ * inputs and returns a sparse vector, pull costs time proportional to all edges (minus masked outputs) and returns a
+ * dense vector. `SpmvStrategy::AUTO` picks push while the active inputs cover a small fraction of the edges. Both run
+ * on `parallel_for`, and the results do not depend on the worker count.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cgrapht/commons.hpp"
+#include "cgrapht/detail/epoch_stamps.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/models.hpp"
+#include "cgrapht/parallel.hpp"
+
+namespace cgrapht {
+
+    /**
+     * @brief Compile time semiring over `S::value_type`.
+     */
+    template <typename S>
+    concept Semiring = requires(const typename S::value_type a, const typename S::value_type b) {
+        { S::zero() } -> std::convertible_to<typename S::value_type>;
+        { S::add(a, b) } -> std::convertible_to<typename S::value_type>;
+        { S::multiply(a, b) } -> std::convertible_to<typename S::value_type>;
+        { a == b } -> std::convertible_to<bool>;
+    };
+
+    /**
+     * @brief Boolean (or, and) semiring for reachability. Values are 0 or 1.
+     */
+    struct OrAnd {
+        using value_type = std::uint8_t;
+
+        static constexpr value_type zero() {
+            return 0;
+        }
+
+        static constexpr value_type terminal() {
+            return 1;
+        }
+
+        static constexpr value_type add(const value_type a, const value_type b) {
+            return a | b;
+        }
+
+        static constexpr value_type multiply(const value_type a, const value_type b) {
+            return a & b;
+        }
+    };
+
+    /**
+     * @brief Tropical (min, +) semiring for shortest paths. `zero()` is infinity, or the maximum for integral `T`.
+     */
+    template <typename T>
+    struct MinPlus {
+        using value_type = T;
+
+        static constexpr value_type zero() {
+            if constexpr (std::numeric_limits<T>::has_infinity) {
+                return std::numeric_limits<T>::infinity();
+            } else {
+                return std::numeric_limits<T>::max();
+            }
+        }
+
+        static constexpr value_type add(const value_type a, const value_type b) {
+            return std::min(a, b);
+        }
+
+        static constexpr value_type multiply(const value_type a, const value_type b) {
+            if constexpr (!std::numeric_limits<T>::has_infinity) {
+                if (a == zero() || b == zero()) {
+                    return zero();
+                }
+            }
+            return a + b;
+        }
+    };
+
+    /**
+     * @brief Arithmetic (+, *) semiring.
+     */
+    template <typename T>
+    struct PlusTimes {
+        using value_type = T;
+
+        static constexpr value_type zero() {
+            return T{0};
+        }
+
+        static constexpr value_type add(const value_type a, const value_type b) {
+            return a + b;
+        }
+
+        static constexpr value_type multiply(const value_type a, const value_type b) {
+            return a * b;
+        }
+    };
+
+    /**
+     * @brief How `vxm` and `mxv` traverse the matrix.
+     */
+    enum class SpmvStrategy {
+        AUTO,   ///< Push while the active inputs touch few edges, pull otherwise.
+        PUSH,   ///< Scatter every non zero input over its row. Returns a sparse vector.
+        PULL    ///< Reduce every output over its column. Returns a dense vector.
+    };
+
+    /**
+     * @brief Options for `vxm` and `mxv`.
+     */
+    struct SpmvOptions {
+        SpmvStrategy strategy {SpmvStrategy::AUTO};
+        /// When non empty, one entry per output: only outputs with a non zero entry are computed, the rest stay zero.
+        std::span<const std::uint8_t> mask {};
+        /// Invert `mask`: compute only the outputs whose entry is zero.
+        bool complement_mask {false};
+        std::size_t threads {0};    ///< Workers, 0 for one per hardware thread.
+    };
+
+    /**
+     * @brief Vector indexed by dense vertex index, stored dense or sparse.
+     *
+     * Entries equal to `S::zero()` are absent. Sparse vectors keep their entries sorted by index.
+     *
+     * @tparam S Semiring giving the value type and zero.
+     */
+    template <Semiring S>
+    class GraphVector {
+    public:
+        using value_type = typename S::value_type;
+        using Entry = std::pair<std::size_t, value_type>;
+
+    private:
+        std::size_t length {0};
+        bool dense_storage {false};
+        std::vector<value_type> dense_values{};
+        std::vector<Entry> sparse_entries{};
+
+    public:
+        /**
+         * @brief Empty sparse vector of the given size.
+         */
+        static GraphVector sparse(const std::size_t size) {
+            GraphVector vector {};
+            vector.length = size;
+            return vector;
+        }
+
+        /**
+         * @brief Sparse vector from entries. Entries are sorted by index; zero entries are dropped.
+         * @param size Vector size. Every index must be below it.
+         * @param entries Distinct indices with their values.
+         */
+        static GraphVector sparse(const std::size_t size, std::vector<Entry> entries) {
+            GraphVector vector {sparse(size)};
+            std::erase_if(entries, [](const Entry& entry) { return entry.second == S::zero(); });
+            std::ranges::sort(entries, {}, &Entry::first);
+            vector.sparse_entries = std::move(entries);
+            return vector;
+        }
+
+        /**
+         * @brief Dense vector with every entry set to `fill`.
+         */
+        static GraphVector dense(const std::size_t size, const value_type fill = S::zero()) {
+            return dense(std::vector<value_type>(size, fill));
+        }
+
+        /**
+         * @brief Dense vector taking over `values`.
+         */
+        static GraphVector dense(std::vector<value_type> values) {
+            GraphVector vector {};
+            vector.length = values.size();
+            vector.dense_storage = true;
+            vector.dense_values = std::move(values);
+            return vector;
+        }
+
+        /**
+         * @brief Number of entries, present or not.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return length;
+        }
+
+        /**
+         * @brief Whether the vector is stored dense.
+         */
+        [[nodiscard]] bool is_dense() const {
+            return dense_storage;
+        }
+
+        /**
+         * @brief Number of present (non zero) entries. Linear in `size()` for dense vectors.
+         */
+        [[nodiscard]] std::size_t nnz() const {
+            if (!dense_storage) {
+                return sparse_entries.size();
+            }
+            return static_cast<std::size_t>(std::ranges::count_if(dense_values, [](const value_type& v) { return !(v == S::zero()); }));
+        }
+
+        /**
+         * @brief Value at an index, `S::zero()` if absent. Logarithmic for sparse vectors.
+         */
+        [[nodiscard]] value_type get(const std::size_t index) const {
+            if (dense_storage) {
+                return dense_values[index];
+            }
+            const auto it {std::ranges::lower_bound(sparse_entries, index, {}, &Entry::first)};
+            return it != sparse_entries.end() && it->first == index ? it->second : S::zero();
+        }
+
+        /**
+         * @brief Values of a dense vector.
+         */
+        [[nodiscard]] std::span<const value_type> values() const {
+            return dense_values;
+        }
+
+        /**
+         * @brief Entries of a sparse vector, sorted by index.
+         */
+        [[nodiscard]] std::span<const Entry> entries() const {
+            return sparse_entries;
+        }
+
+        /**
+         * @brief Switch to dense storage. No-op if already dense.
+         */
+        void make_dense() {
+            if (dense_storage) {
+                return;
+            }
+            dense_values.assign(length, S::zero());
+            for (const auto& [index, value] : sparse_entries) {
+                dense_values[index] = value;
+            }
+            sparse_entries = {};
+            dense_storage = true;
+        }
+
+        /**
+         * @brief Switch to sparse storage. No-op if already sparse.
+         */
+        void make_sparse() {
+            if (!dense_storage) {
+                return;
+            }
+            sparse_entries.clear();
+            for (std::size_t i {0}; i < length; ++i) {
+                if (!(dense_values[i] == S::zero())) {
+                    sparse_entries.emplace_back(i, dense_values[i]);
+                }
+            }
+            dense_values = {};
+            dense_storage = false;
+        }
+    };
+
+    /**
+     * @brief Values attached to the edges of a `FrozenGraph`, viewed as a square sparse matrix.
+     *
+     * A(i, j) is the value of the edge from dense index `i` to dense index `j`. Parallel edges are separate entries, so
+     * products combine them with the semiring addition. The matrix refers to the frozen graph, which must outlive it.
+     *
+     * @tparam T Value type.
+     */
+    template <typename T>
+    class AdjacencyMatrix {
+    private:
+        const FrozenGraph* graph;
+        std::vector<T> out_values{};    // aligned with the CSR slots
+        std::vector<T> in_values{};     // aligned with the CSC slots
+
+        explicit AdjacencyMatrix(const FrozenGraph& graph) : graph{&graph} {}
+
+    public:
+        /**
+         * @brief Matrix with the same value on every edge.
+         * @param graph Frozen graph giving the structure.
+         * @param value Value of every edge, typically the semiring's multiplicative identity.
+         */
+        static AdjacencyMatrix pattern(const FrozenGraph& graph, const T value) {
+            AdjacencyMatrix matrix {graph};
+            matrix.out_values.assign(graph.edge_count(), value);
+            matrix.in_values.assign(graph.edge_count(), value);
+            return matrix;
+        }
+
+        /**
+         * @brief Matrix whose values are projected from the edge payloads.
+         * @param frozen Snapshot of `graph` giving the structure.
+         * @param graph Graph holding the payloads.
+         * @param projection Callable as `projection(const E&)`, returning the value of an edge.
+         * @return Result containing the matrix, or `ABSENT_EDGE` if `frozen` holds an edge `graph` does not.
+         */
+        template <Hashable V, Hashable E, typename Observer, typename Projection>
+        static Result<AdjacencyMatrix, ErrorType> weighted(const FrozenGraph& frozen, const DirectedGraph<V, E, Observer>& graph, Projection&& projection) {
+            AdjacencyMatrix matrix {frozen};
+            matrix.out_values.reserve(frozen.edge_count());
+            matrix.in_values.reserve(frozen.edge_count());
+            std::vector<Result<Edge<E>, ErrorType>> edges {};
+            for (std::size_t i {0}; i < frozen.vertex_count(); ++i) {
+                for (const bool outgoing : {true, false}) {
+                    graph.get_edges(outgoing ? frozen.outgoing_edges(i) : frozen.incoming_edges(i), edges);
+                    for (const auto& edge : edges) {
+                        if (!edge.is_ok()) {
+                            return Result<AdjacencyMatrix, ErrorType>::error(ErrorType::ABSENT_EDGE);
+                        }
+                        (outgoing ? matrix.out_values : matrix.in_values).push_back(static_cast<T>(projection(edge.get_ok().edge)));
+                    }
+                }
+            }
+            return Result<AdjacencyMatrix, ErrorType>::success(std::move(matrix));
+        }
+
+        /**
+         * @brief The frozen graph giving the structure.
+         */
+        [[nodiscard]] const FrozenGraph& frozen_graph() const {
+            return *graph;
+        }
+
+        /**
+         * @brief Number of rows, equal to the number of columns.
+         */
+        [[nodiscard]] std::size_t dimension() const {
+            return graph->vertex_count();
+        }
+
+        /**
+         * @brief Values aligned with `frozen_graph().outgoing_targets()` (row major).
+         */
+        [[nodiscard]] std::span<const T> row_values() const {
+            return out_values;
+        }
+
+        /**
+         * @brief Values aligned with `frozen_graph().incoming_sources()` (column major).
+         */
+        [[nodiscard]] std::span<const T> column_values() const {
+            return in_values;
+        }
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        /// Push is chosen while the edges it would touch are below `edge_count / PUSH_PULL_RATIO`.
+        inline constexpr std::size_t PUSH_PULL_RATIO {16};
+
+        template <typename T>
+        struct MatrixSide {
+            std::span<const std::size_t> offsets;
+            std::span<const std::size_t> indices;
+            std::span<const T> values;
+        };
+
+        template <typename T>
+        struct PushWorkspace {
+            EpochStamps stamps{};
+            std::vector<std::size_t> position{};
+        };
+
+        template <typename T>
+        PushWorkspace<T>& push_workspace() {
+            thread_local PushWorkspace<T> workspace {};
+            return workspace;
+        }
+
+        inline bool computes(const SpmvOptions& options, const std::size_t index) {
+            return options.mask.empty() || ((options.mask[index] != 0) != options.complement_mask);
+        }
+
+        /**
+         * w[j] = add over k in row i of scatter, of u[i] * A(i, j) (or A(i, j) * u[i] when `INPUT_LEFT` is false).
+         * `scatter` is the side whose rows start at the input index, `gather` the side whose rows start at the output.
+         */
+        template <Semiring S, bool INPUT_LEFT>
+        GraphVector<S> spmv(GraphVector<S> u, const MatrixSide<typename S::value_type>& scatter, const MatrixSide<typename S::value_type>& gather,
+                            const SpmvOptions& options) {
+            using T = typename S::value_type;
+            const std::size_t n {u.size()};
+            auto product = [](const T input, const T value) {
+                return INPUT_LEFT ? S::multiply(input, value) : S::multiply(value, input);
+            };
+            auto row_length = [&scatter](const std::size_t i) {
+                return scatter.offsets[i + 1] - scatter.offsets[i];
+            };
+
+            bool push {options.strategy == SpmvStrategy::PUSH};
+            if (options.strategy == SpmvStrategy::AUTO) {
+                std::size_t push_work {0};
+                if (u.is_dense()) {
+                    const auto values {u.values()};
+                    for (std::size_t i {0}; i < n; ++i) {
+                        push_work += values[i] == S::zero() ? 0 : row_length(i);
+                    }
+                } else {
+                    for (const auto& entry : u.entries()) {
+                        push_work += row_length(entry.first);
+                    }
+                }
+                push = push_work * PUSH_PULL_RATIO < scatter.indices.size();
+            }
+
+            if (push) {
+                u.make_sparse();
+                const auto active {u.entries()};
+                constexpr std::size_t GRAIN {64};
+                // One buffer per chunk, merged in chunk order, so the result does not depend on scheduling.
+                std::vector<std::vector<std::pair<std::size_t, T>>> contributions((active.size() + GRAIN - 1) / GRAIN);
+                parallel_for(active.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                    auto& out {contributions[begin / GRAIN]};
+                    for (std::size_t a {begin}; a < end; ++a) {
+                        const auto [i, input] = active[a];
+                        for (std::size_t k {scatter.offsets[i]}; k < scatter.offsets[i + 1]; ++k) {
+                            if (computes(options, scatter.indices[k])) {
+                                out.emplace_back(scatter.indices[k], product(input, scatter.values[k]));
+                            }
+                        }
+                    }
+                }, options.threads, GRAIN);
+
+                auto& workspace {push_workspace<T>()};
+                workspace.stamps.begin(n);
+                workspace.position.resize(n);
+                std::vector<std::pair<std::size_t, T>> entries {};
+                for (const auto& chunk : contributions) {
+                    for (const auto& [j, value] : chunk) {
+                        if (!workspace.stamps.visited(j)) {
+                            workspace.stamps.visit(j);
+                            workspace.position[j] = entries.size();
+                            entries.emplace_back(j, value);
+                        } else {
+                            T& slot {entries[workspace.position[j]].second};
+                            slot = S::add(slot, value);
+                        }
+                    }
+                }
+                return GraphVector<S>::sparse(n, std::move(entries));
+            }
+
+            u.make_dense();
+            const auto input {u.values()};
+            std::vector<T> output(n, S::zero());
+            parallel_for(n, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+                for (std::size_t j {begin}; j < end; ++j) {
+                    if (!computes(options, j)) {
+                        continue;
+                    }
+                    T accumulator {S::zero()};
+                    for (std::size_t k {gather.offsets[j]}; k < gather.offsets[j + 1]; ++k) {
+                        const T x {input[gather.indices[k]]};
+                        if (x == S::zero()) {
+                            continue;
+                        }
+                        accumulator = S::add(accumulator, product(x, gather.values[k]));
+                        if constexpr (requires { S::terminal(); }) {
+                            if (accumulator == S::terminal()) {
+                                break;
+                            }
+                        }
+                    }
+                    output[j] = accumulator;
+                }
+            }, options.threads);
+            return GraphVector<S>::dense(std::move(output));
+        }
+
+        template <typename S>
+        bool spmv_arguments_valid(const GraphVector<S>& u, const AdjacencyMatrix<typename S::value_type>& a, const SpmvOptions& options) {
+            return u.size() == a.dimension() && (options.mask.empty() || options.mask.size() == a.dimension());
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Vector-matrix product w = u A under semiring `S`: w[j] = add over edges i -> j of u[i] * A(i, j).
+     *
+     * With the boolean semiring this advances a BFS frontier by one level, with min-plus it relaxes every edge leaving
+     * the input once.
+     *
+     * @param u Input vector, consumed.
+     * @param a Matrix.
+     * @param options Strategy, output mask and workers.
+     * @return Result containing w (sparse if pushed, dense if pulled), or `INVALID_ARGUMENT` on a size mismatch.
+     */
+    template <Semiring S>
+    Result<GraphVector<S>, ErrorType> vxm(GraphVector<S> u, const AdjacencyMatrix<typename S::value_type>& a, const SpmvOptions& options = {}) {
+        if (!detail::spmv_arguments_valid(u, a, options)) {
+            return Result<GraphVector<S>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const FrozenGraph& graph {a.frozen_graph()};
+        const detail::MatrixSide<typename S::value_type> rows {graph.outgoing_offsets(), graph.outgoing_targets(), a.row_values()};
+        const detail::MatrixSide<typename S::value_type> columns {graph.incoming_offsets(), graph.incoming_sources(), a.column_values()};
+        return Result<GraphVector<S>, ErrorType>::success(detail::spmv<S, true>(std::move(u), rows, columns, options));
+    }
+
+    /**
+     * @brief Matrix-vector product w = A u under semiring `S`: w[i] = add over edges i -> j of A(i, j) * u[j].
+     *
+     * @param a Matrix.
+     * @param u Input vector, consumed.
+     * @param options Strategy, output mask and workers.
+     * @return Result containing w (sparse if pushed, dense if pulled), or `INVALID_ARGUMENT` on a size mismatch.
+     */
+    template <Semiring S>
+    Result<GraphVector<S>, ErrorType> mxv(const AdjacencyMatrix<typename S::value_type>& a, GraphVector<S> u, const SpmvOptions& options = {}) {
+        if (!detail::spmv_arguments_valid(u, a, options)) {
+            return Result<GraphVector<S>, ErrorType>::error(ErrorType::INVALID_ARGUMENT);
+        }
+        const FrozenGraph& graph {a.frozen_graph()};
+        const detail::MatrixSide<typename S::value_type> rows {graph.outgoing_offsets(), graph.outgoing_targets(), a.row_values()};
+        const detail::MatrixSide<typename S::value_type> columns {graph.incoming_offsets(), graph.incoming_sources(), a.column_values()};
+        return Result<GraphVector<S>, ErrorType>::success(detail::spmv<S, false>(std::move(u), columns, rows, options));
+    }
+}
@@ -0,0 +1,342 @@
+/**
+ * @file tracing.hpp
+ *
+ * @brief Tracing hooks that algorithms emit phase spans and counters into.
+ *
+ * @Detail
+ * Long running algorithms accept an optional tracer as their last argument and report their phases to it, e.g. one
+ * span per BFS level together with the size of the frontier. Like observer policies, a tracer opts into events by
+ * declaring the matching members:
+ *
+ * ```cpp
+ * void begin_span(std::string_view name);
+ * void end_span(std::string_view name);
+ * void counter(std::string_view name, double value);
+ * ```
+ *
+ * Spans nest and are always closed in reverse order on the thread that opened them. The default `NoTracer` declares
+ * nothing, so untraced calls compile to the same code as before. Provided tracers:
+ * - `ChromeTraceWriter` records events in memory and writes them as Chrome trace event JSON, which can be loaded in
+ *   `chrome://tracing` or Perfetto.
+ * - `PerfCounterTracer` samples hardware counters (cycles, cache misses) around every span with Linux
+ *   `perf_event_open`, and optionally forwards everything, counters included, to another tracer.
+ *
+ * ```cpp
+ * ChromeTraceWriter trace {};
+ * auto distances = multi_source_bfs(frozen, sources, 10, trace);
+ * std::ofstream{"bfs.json"} << trace.to_json();
+ * ```
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cgrapht {
+
+    /**
+     * @brief Tracer that records nothing. The default for all traced algorithms.
+     */
+    struct NoTracer {};
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename Tracer>
+        void trace_begin(Tracer& tracer, const std::string_view name) {
+            if constexpr (requires { tracer.begin_span(name); }) {
+                tracer.begin_span(name);
+            }
+        }
+
+        template <typename Tracer>
+        void trace_end(Tracer& tracer, const std::string_view name) {
+            if constexpr (requires { tracer.end_span(name); }) {
+                tracer.end_span(name);
+            }
+        }
+
+        /**
+         * Scoped span: opens on construction and closes on destruction, including on early returns.
+         */
+        template <typename Tracer>
+        class TraceSpan {
+        private:
+            Tracer& tracer;
+            std::string_view name;
+
+        public:
+            TraceSpan(Tracer& tracer, const std::string_view name) : tracer{tracer}, name{name} {
+                trace_begin(tracer, name);
+            }
+
+            ~TraceSpan() {
+                trace_end(tracer, name);
+            }
+
+            TraceSpan(const TraceSpan&) = delete;
+            TraceSpan& operator=(const TraceSpan&) = delete;
+        };
+
+        template <typename Tracer>
+        void trace_counter(Tracer& tracer, const std::string_view name, const double value) {
+            if constexpr (requires { tracer.counter(name, value); }) {
+                tracer.counter(name, value);
+            }
+        }
+
+        inline void append_json_string(std::string& out, const std::string_view text) {
+            out += '"';
+            for (const char c : text) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+            }
+            out += '"';
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Tracer recording Chrome trace events in memory.
+     *
+     * Spans become duration events (`"ph": "B"` / `"E"`) and counters become counter events (`"ph": "C"`), stamped
+     * in microseconds since the writer was created. Events from different threads get distinct `tid`s. Recording is
+     * thread safe.
+     */
+    class ChromeTraceWriter {
+    public:
+        /**
+         * @brief One recorded event.
+         */
+        struct Event {
+            std::string name;
+            char phase;             ///< `'B'`, `'E'` or `'C'`.
+            double timestamp_us;
+            std::uint32_t thread;
+            double value;           ///< Counter value, 0 for spans.
+        };
+
+    private:
+        std::chrono::steady_clock::time_point origin {std::chrono::steady_clock::now()};
+        mutable std::mutex mutex {};
+        std::vector<Event> events {};
+        std::unordered_map<std::thread::id, std::uint32_t> threads {};
+
+        void record(const std::string_view name, const char phase, const double value) {
+            const double timestamp {std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count()};
+            std::scoped_lock lock {mutex};
+            const auto [it, _] = threads.try_emplace(std::this_thread::get_id(), static_cast<std::uint32_t>(threads.size()));
+            events.push_back(Event{std::string{name}, phase, timestamp, it->second, value});
+        }
+
+    public:
+        void begin_span(const std::string_view name) {
+            record(name, 'B', 0);
+        }
+
+        void end_span(const std::string_view name) {
+            record(name, 'E', 0);
+        }
+
+        void counter(const std::string_view name, const double value) {
+            record(name, 'C', value);
+        }
+
+        /**
+         * @brief Copy of the events recorded so far, in recording order.
+         */
+        [[nodiscard]] std::vector<Event> get_events() const {
+            std::scoped_lock lock {mutex};
+            return events;
+        }
+
+        /**
+         * @brief Render the recorded events as a Chrome trace JSON object.
+         */
+        [[nodiscard]] std::string to_json() const {
+            std::scoped_lock lock {mutex};
+            std::string out {"{\"traceEvents\":["};
+            char number[64];
+            for (std::size_t i {0}; i < events.size(); ++i) {
+                const Event& event {events[i]};
+                out += i == 0 ? "\n" : ",\n";
+                out += "{\"name\":";
+                detail::append_json_string(out, event.name);
+                std::snprintf(number, sizeof(number), ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u", event.phase, event.timestamp_us, event.thread);
+                out += number;
+                if (event.phase == 'C') {
+                    std::snprintf(number, sizeof(number), ",\"args\":{\"value\":%.17g}", event.value);
+                    out += number;
+                }
+                out += '}';
+            }
+            out += "\n],\"displayTimeUnit\":\"ns\"}\n";
+            return out;
+        }
+    };
+
+    /**
+     * @brief Hardware counter deltas and wall time of one completed span.
+     */
+    struct PhaseSample {
+        std::string name;
+        std::uint64_t nanoseconds;
+        std::uint64_t cycles;       ///< 0 when counters are unavailable.
+        std::uint64_t cache_misses; ///< 0 when counters are unavailable.
+    };
+
+    /**
+     * @brief Tracer sampling CPU cycles and cache misses around every span with Linux `perf_event_open`.
+     *
+     * Counters are opened for the constructing thread, user space only, so spans must be emitted from that thread.
+     * Where the counters cannot be opened (other platforms, `perf_event_paranoid` restrictions, containers), the tracer
+     * still records wall time and `available()` is false.
+     *
+     * Every event is also forwarded to `downstream`, and at the end of each span its deltas are emitted to it as the
+     * counters `<span>.cycles` and `<span>.cache_misses`, so for example a `PerfCounterTracer<ChromeTraceWriter&>`
+     * places them on the same timeline as the spans.
+     *
+     * @tparam Downstream Tracer to forward to, possibly a reference type.
+     */
+    template <typename Downstream = NoTracer>
+    class PerfCounterTracer {
+    private:
+        struct OpenSpan {
+            std::chrono::steady_clock::time_point start;
+            std::uint64_t cycles;
+            std::uint64_t cache_misses;
+        };
+
+        Downstream downstream;
+        int cycles_fd {-1};
+        int cache_misses_fd {-1};
+        std::vector<OpenSpan> open{};
+        std::vector<PhaseSample> samples{};
+
+        static int open_counter([[maybe_unused]] const std::uint64_t config) {
+#if defined(__linux__)
+            perf_event_attr attributes {};
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.size = sizeof(attributes);
+            attributes.config = config;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+            return -1;
+#endif
+        }
+
+        static std::uint64_t read_counter([[maybe_unused]] const int fd) {
+            std::uint64_t value {0};
+#if defined(__linux__)
+            if (fd >= 0 && ::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+                value = 0;
+            }
+#endif
+            return value;
+        }
+
+        void close_counters() {
+#if defined(__linux__)
+            for (const int fd : {cycles_fd, cache_misses_fd}) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+#endif
+            cycles_fd = -1;
+            cache_misses_fd = -1;
+        }
+
+    public:
+        /**
+         * @brief Open the counters for the calling thread.
+         * @param downstream Tracer receiving all events.
+         */
+        explicit PerfCounterTracer(Downstream downstream = Downstream{}) : downstream{std::forward<Downstream>(downstream)} {
+#if defined(__linux__)
+            cycles_fd = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+            cache_misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+            if (cycles_fd < 0 || cache_misses_fd < 0) {
+                close_counters();
+            }
+#endif
+        }
+
+        PerfCounterTracer(const PerfCounterTracer&) = delete;
+        PerfCounterTracer& operator=(const PerfCounterTracer&) = delete;
+
+        ~PerfCounterTracer() {
+            close_counters();
+        }
+
+        /**
+         * @brief Whether hardware counters are being sampled.
+         */
+        [[nodiscard]] bool available() const {
+            return cycles_fd >= 0;
+        }
+
+        /**
+         * @brief Completed spans, in the order they ended.
+         */
+        [[nodiscard]] const std::vector<PhaseSample>& get_samples() const {
+            return samples;
+        }
+
+        void begin_span(const std::string_view name) {
+            if constexpr (requires { downstream.begin_span(name); }) {
+                downstream.begin_span(name);
+            }
+            open.push_back(OpenSpan{std::chrono::steady_clock::now(), read_counter(cycles_fd), read_counter(cache_misses_fd)});
+        }
+
+        void end_span(const std::string_view name) {
+            const std::uint64_t cycles {read_counter(cycles_fd)};
+            const std::uint64_t cache_misses {read_counter(cache_misses_fd)};
+            const auto end {std::chrono::steady_clock::now()};
+            const OpenSpan span {open.back()};
+            open.pop_back();
+
+            PhaseSample sample {std::string{name}, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - span.start).count()),
+                                cycles - span.cycles, cache_misses - span.cache_misses};
+            if (available()) {
+                detail::trace_counter(downstream, sample.name + ".cycles", static_cast<double>(sample.cycles));
+                detail::trace_counter(downstream, sample.name + ".cache_misses", static_cast<double>(sample.cache_misses));
+            }
+            samples.push_back(std::move(sample));
+            if constexpr (requires { downstream.end_span(name); }) {
+                downstream.end_span(name);
+            }
+        }
+
+        void counter(const std::string_view name, const double value) {
+            detail::trace_counter(downstream, name, value);
+        }
+    };
+}
@@ -0,0 +1,111 @@
+/**
+ * @file random_graphs.hpp
+ * @brief Random graphs shared by the unit tests.
+ */
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace cgrapht::testing {
+
+    using RandomGraph = DirectedGraph<int, DefaultEdge>;
+
+    /**
+     * @brief Vertices `0 .. vertices - 1` and `edges` uniformly random edges with ids `0 .. edges - 1`. Parallel edges are
+     * kept; self loops are kept unless `self_loops` is false, in which case they are dropped and leave gaps in the edge
+     * ids. Vertex and edge ids equal their payloads.
+     */
+    inline RandomGraph make_random(const std::size_t vertices, const std::size_t edges, const unsigned seed,
+                                   const bool self_loops = true) {
+        RandomGraph graph {};
+        for (std::size_t v {0}; v < vertices; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        std::mt19937 rng {seed};
+        std::uniform_int_distribution<std::size_t> pick {0, vertices - 1};
+        for (std::size_t e {0}; e < edges; ++e) {
+            const std::size_t from {pick(rng)};
+            const std::size_t to {pick(rng)};
+            if (self_loops || from != to) {
+                graph.add_edge(from, to, DefaultEdge{e});
+            }
+        }
+        return graph;
+    }
+
+    /**
+     * @brief An edge payload with a cost. The id makes parallel edges of equal cost distinct and is the hash.
+     */
+    template <typename Cost>
+    struct WeightedEdge {
+        std::size_t id;
+        Cost cost;
+
+        bool operator==(const WeightedEdge&) const = default;
+    };
+}
+
+template <typename Cost>
+struct std::hash<cgrapht::testing::WeightedEdge<Cost>> {
+    std::size_t operator()(const cgrapht::testing::WeightedEdge<Cost>& edge) const noexcept {
+        return edge.id;
+    }
+};
+
+namespace cgrapht::testing {
+
+    template <typename Cost>
+    using WeightedRandomGraph = DirectedGraph<int, WeightedEdge<Cost>>;
+
+    /**
+     * @brief Like `make_random`, with costs `b + p(from) - p(to)` where `b` and every vertex potential `p` are uniform in
+     * `0 .. max_base`. Costs can be negative but every cycle weighs at least 0.
+     */
+    template <typename Cost>
+    WeightedRandomGraph<Cost> make_random_weighted(const std::size_t vertices, const std::size_t edges,
+                                                   const int max_base, const unsigned seed) {
+        WeightedRandomGraph<Cost> graph {};
+        for (std::size_t v {0}; v < vertices; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        std::mt19937 rng {seed};
+        std::uniform_int_distribution<std::size_t> pick {0, vertices - 1};
+        std::uniform_int_distribution<int> base {0, max_base};
+        std::vector<int> potential(vertices);
+        for (int& p : potential) {
+            p = base(rng);
+        }
+        for (std::size_t e {0}; e < edges; ++e) {
+            const std::size_t from {pick(rng)};
+            const std::size_t to {pick(rng)};
+            graph.add_edge(from, to, WeightedEdge<Cost>{e, static_cast<Cost>(base(rng) + potential[from] - potential[to])});
+        }
+        return graph;
+    }
+
+    /**
+     * @brief Left vertices `0 .. left - 1`, right vertices `left .. left + right - 1` and `edges` uniformly random left to
+     * right edges with ids `0 .. edges - 1`, parallel edges included. Costs are uniform in `min_cost .. max_cost`.
+     */
+    inline WeightedRandomGraph<int> make_random_bipartite(const int left, const int right, const std::size_t edges,
+                                                          const int min_cost, const int max_cost, const unsigned seed) {
+        WeightedRandomGraph<int> graph {};
+        for (int v {0}; v < left + right; ++v) {
+            graph.add_vertex(v);
+        }
+        std::mt19937 rng {seed};
+        std::uniform_int_distribution<int> pick_left {0, left - 1};
+        std::uniform_int_distribution<int> pick_right {left, left + right - 1};
+        std::uniform_int_distribution<int> cost {min_cost, max_cost};
+        for (std::size_t e {0}; e < edges; ++e) {
+            const int from {pick_left(rng)};
+            const int to {pick_right(rng)};
+            graph.add_edge(from, to, WeightedEdge<int>{e, cost(rng)});
+        }
+        return graph;
+    }
+}
@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/all_pairs_shortest_paths.hpp"
+#include "cgrapht/algorithms/linear_algebra.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    using Graph = cgrapht::testing::WeightedRandomGraph<int>;
+    using Edge = cgrapht::testing::WeightedEdge<int>;
+
+    int cost(const Edge& edge) {
+        return edge.cost;
+    }
+}
+
+SCENARIO("Floyd-Warshall and Johnson agree with single source shortest paths") {
+    GIVEN("A random graph with negative weights but no negative cycle") {
+        Graph graph {cgrapht::testing::make_random_weighted<int>(70, 350, 20, 11)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, cost).consume_ok()};
+
+        WHEN("All distances are computed") {
+            const auto blocked {cgrapht::floyd_warshall(weights, {.tile_size = 8, .threads = 4}).consume_ok()};
+            const auto single_tile {cgrapht::floyd_warshall(weights, {.tile_size = 128, .threads = 1}).consume_ok()};
+            const auto reweighted {cgrapht::johnson(weights, {.threads = 4}).consume_ok()};
+
+            THEN("Every row matches a single source run") {
+                REQUIRE(blocked.dimension() == 70);
+                bool some_negative {false};
+                bool some_unreachable {false};
+                for (std::size_t s {0}; s < 70; ++s) {
+                    const std::vector<int> expected {cgrapht::sssp(weights, frozen.vertex_id(s)).consume_ok()};
+                    for (std::size_t t {0}; t < 70; ++t) {
+                        const int want {s == t ? std::min(0, expected[t]) : expected[t]};
+                        REQUIRE(blocked.at(s, t) == want);
+                        some_negative = some_negative || want < 0;
+                        some_unreachable = some_unreachable || want == cgrapht::DistanceMatrix<int>::unreachable();
+                    }
+                }
+                REQUIRE(some_negative);
+                REQUIRE(std::ranges::equal(blocked.values(), single_tile.values()));
+                REQUIRE(std::ranges::equal(blocked.values(), reweighted.values()));
+            }
+        }
+    }
+
+    GIVEN("Floating point weights on a chain with a parallel shortcut") {
+        Graph graph {};
+        for (int v {0}; v < 4; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 1, Edge{0, 4});
+        graph.add_edge(0, 1, Edge{1, 1});
+        graph.add_edge(1, 2, Edge{2, 2});
+        graph.add_edge(2, 3, Edge{3, -1});
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, graph, cost).consume_ok()};
+
+        WHEN("All distances are computed") {
+            const auto blocked {cgrapht::floyd_warshall(weights, {.tile_size = 3}).consume_ok()};
+            const auto reweighted {cgrapht::johnson(weights).consume_ok()};
+
+            THEN("The lighter parallel edge is used and unreachable pairs are infinite") {
+                for (const auto* matrix : {&blocked, &reweighted}) {
+                    REQUIRE(matrix->at(0, 3) == 2.0);
+                    REQUIRE(matrix->at(1, 3) == 1.0);
+                    REQUIRE(matrix->at(3, 0) == cgrapht::DistanceMatrix<double>::unreachable());
+                    REQUIRE(matrix->row(2)[3] == -1.0);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Negative cycles are reported") {
+    GIVEN("A graph with a negative cycle unreachable from vertex 0") {
+        Graph graph {};
+        for (int v {0}; v < 5; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 1, Edge{0, 1});
+        graph.add_edge(2, 3, Edge{1, 1});
+        graph.add_edge(3, 4, Edge{2, -3});
+        graph.add_edge(4, 2, Edge{3, 1});
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, cost).consume_ok()};
+
+        WHEN("All distances are requested") {
+            THEN("Both algorithms refuse") {
+                REQUIRE(cgrapht::floyd_warshall(weights, {.tile_size = 2}).get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+                REQUIRE(cgrapht::johnson(weights).get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+                REQUIRE(cgrapht::floyd_warshall(weights, {.tile_size = 0}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+    }
+}
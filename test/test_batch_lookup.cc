@@ -0,0 +1,92 @@
+#define CATCH_CONFIG_MAIN
+
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+
+SCENARIO("Batched vertex and edge lookups") {
+
+    GIVEN("I have a graph with a chain of vertices") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        std::vector<std::size_t> vertex_ids {};
+        std::vector<std::size_t> edge_ids {};
+
+        for (int i {0}; i < 100; ++i) {
+            vertex_ids.push_back(my_graph.add_vertex(i).get_ok());
+        }
+        for (std::size_t i {1}; i < vertex_ids.size(); ++i) {
+            edge_ids.push_back(my_graph.add_edge(vertex_ids[i - 1], vertex_ids[i], cgrapht::DefaultEdge{1000 + i}).get_ok());
+        }
+
+        WHEN("I look up all vertices in one batch") {
+
+            std::vector<cgrapht::Result<int, cgrapht::ErrorType>> out {};
+            my_graph.get_vertices(vertex_ids, out);
+
+            THEN("I should get the same answers as single lookups, in order") {
+
+                REQUIRE(out.size() == vertex_ids.size());
+                for (std::size_t i {0}; i < vertex_ids.size(); ++i) {
+                    REQUIRE(out[i] == my_graph.get_vertex(vertex_ids[i]));
+                }
+            }
+        }
+
+        WHEN("I look up a batch containing unknown vertex ids") {
+
+            const std::vector<std::size_t> ids {vertex_ids[3], 5000, vertex_ids[7], 6000};
+            std::vector<cgrapht::Result<int, cgrapht::ErrorType>> out {};
+            my_graph.get_vertices(ids, out);
+
+            THEN("Only the unknown ids should be errors") {
+
+                REQUIRE(out.size() == 4);
+                REQUIRE(out[0].get_ok() == 3);
+                REQUIRE(out[1].get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+                REQUIRE(out[2].get_ok() == 7);
+                REQUIRE(out[3].get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+
+        WHEN("I look up edges in one batch, reusing an output vector") {
+
+            std::vector<cgrapht::Result<cgrapht::Edge<cgrapht::DefaultEdge>, cgrapht::ErrorType>> out {};
+            my_graph.get_edges(std::vector<std::size_t>{42}, out);
+            my_graph.get_edges(edge_ids, out);
+
+            THEN("The previous contents should be replaced") {
+
+                REQUIRE(out.size() == edge_ids.size());
+                for (std::size_t i {0}; i < edge_ids.size(); ++i) {
+                    REQUIRE(out[i].get_ok().from_id == vertex_ids[i]);
+                    REQUIRE(out[i].get_ok().to_id == vertex_ids[i + 1]);
+                }
+            }
+
+            AND_WHEN("I look up an edge that does not exist") {
+
+                my_graph.get_edges(std::vector<std::size_t>{42}, out);
+
+                THEN("I should get an absent edge error") {
+
+                    REQUIRE(out.size() == 1);
+                    REQUIRE(out[0].get_error() == cgrapht::ErrorType::ABSENT_EDGE);
+                }
+            }
+        }
+
+        WHEN("I look up an empty batch") {
+
+            std::vector<cgrapht::Result<int, cgrapht::ErrorType>> out {};
+            my_graph.get_vertices({}, out);
+
+            THEN("I should get back nothing") {
+
+                REQUIRE(out.empty());
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/bellman_ford.hpp"
+#include "cgrapht/algorithms/linear_algebra.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    using Graph = cgrapht::testing::WeightedRandomGraph<double>;
+    using Edge = cgrapht::testing::WeightedEdge<double>;
+
+    double cost(const Edge& edge) {
+        return edge.cost;
+    }
+
+    // Lightest weight of an edge between two dense indices, or infinity.
+    double lightest(const cgrapht::AdjacencyMatrix<double>& weights, const std::size_t from, const std::size_t to) {
+        const cgrapht::FrozenGraph& frozen {weights.frozen_graph()};
+        double best {std::numeric_limits<double>::infinity()};
+        for (std::size_t slot {frozen.outgoing_offsets()[from]}; slot < frozen.outgoing_offsets()[from + 1]; ++slot) {
+            if (frozen.outgoing_targets()[slot] == to) {
+                best = std::min(best, weights.row_values()[slot]);
+            }
+        }
+        return best;
+    }
+}
+
+SCENARIO("Bellman-Ford finds shortest paths with negative weights") {
+    GIVEN("A random graph with negative weights and no negative cycle") {
+        Graph graph {cgrapht::testing::make_random_weighted<double>(300, 1500, 30, 3)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, graph, cost).consume_ok()};
+        const std::vector<double> expected {cgrapht::sssp(weights, 0).consume_ok()};
+
+        WHEN("Both strategies run") {
+            const auto queue {cgrapht::bellman_ford(weights, 0).consume_ok()};
+            const auto parallel {cgrapht::bellman_ford(weights, 0, {.strategy = cgrapht::RelaxationStrategy::PARALLEL_EDGES, .threads = 4}).consume_ok()};
+
+            THEN("Distances match and parents form a tight tree") {
+                const std::size_t source {frozen.index_of(0).get_ok()};
+                bool some_negative {false};
+                for (const auto* tree : {&queue, &parallel}) {
+                    REQUIRE(tree->distances == expected);
+                    for (std::size_t v {0}; v < frozen.vertex_count(); ++v) {
+                        some_negative = some_negative || expected[v] < 0;
+                        if (v == source || expected[v] == std::numeric_limits<double>::infinity()) {
+                            REQUIRE(tree->parents[v] == cgrapht::NO_PARENT);
+                            continue;
+                        }
+                        const std::size_t parent {tree->parents[v]};
+                        REQUIRE(parent != cgrapht::NO_PARENT);
+                        REQUIRE(tree->distances[parent] + lightest(weights, parent, v) == tree->distances[v]);
+                    }
+                }
+                REQUIRE(some_negative);
+            }
+        }
+    }
+}
+
+SCENARIO("Bellman-Ford reports negative cycles") {
+    GIVEN("Currencies with an arbitrage loop behind the source") {
+        // Edge costs are -log(rate): a cycle whose rates multiply to more than 1 has negative cost.
+        Graph graph {};
+        for (int v {0}; v < 5; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 1, Edge{0, -std::log(1.0)});
+        graph.add_edge(1, 2, Edge{1, -std::log(0.9)});
+        graph.add_edge(2, 3, Edge{2, -std::log(1.2)});
+        graph.add_edge(3, 1, Edge{3, -std::log(1.0)});
+        graph.add_edge(3, 4, Edge{4, -std::log(0.5)});
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, graph, cost).consume_ok()};
+
+        WHEN("Paths from the source are requested") {
+            THEN("The error lists the cycle in edge order") {
+                for (const auto strategy : {cgrapht::RelaxationStrategy::QUEUE, cgrapht::RelaxationStrategy::PARALLEL_EDGES}) {
+                    auto result = cgrapht::bellman_ford(weights, 0, {.strategy = strategy});
+                    REQUIRE(!result.is_ok());
+                    const cgrapht::ShortestPathError error {std::move(result).consume_error()};
+                    REQUIRE(error.error == cgrapht::ErrorType::CYCLE_DETECTED);
+                    REQUIRE(error.cycle.size() == 3);
+                    double total {0};
+                    for (std::size_t i {0}; i < error.cycle.size(); ++i) {
+                        const std::size_t from {frozen.index_of(error.cycle[i]).get_ok()};
+                        const std::size_t to {frozen.index_of(error.cycle[(i + 1) % error.cycle.size()]).get_ok()};
+                        total += lightest(weights, from, to);
+                    }
+                    REQUIRE(total < 0);
+                }
+            }
+        }
+
+        WHEN("The source cannot reach the cycle") {
+            auto result = cgrapht::bellman_ford(weights, 4, {.strategy = cgrapht::RelaxationStrategy::PARALLEL_EDGES});
+
+            THEN("Paths are returned") {
+                REQUIRE(result.is_ok());
+                REQUIRE(result.get_ok().distances[frozen.index_of(4).get_ok()] == 0);
+                REQUIRE(result.get_ok().distances[frozen.index_of(0).get_ok()] == std::numeric_limits<double>::infinity());
+            }
+        }
+
+        WHEN("The source is absent") {
+            THEN("The error says so") {
+                REQUIRE(cgrapht::bellman_ford(weights, 42).get_error() == cgrapht::ShortestPathError{cgrapht::ErrorType::ABSENT_VERTEX});
+            }
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/bipartite_matching.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    using Graph = cgrapht::testing::WeightedRandomGraph<int>;
+    using Shift = cgrapht::testing::WeightedEdge<int>;
+
+    // Jobs 0..jobs-1 on the left, workers jobs..jobs+workers-1 on the right.
+    Graph make_random(const int jobs, const int workers, const std::size_t edges, const unsigned seed) {
+        return cgrapht::testing::make_random_bipartite(jobs, workers, edges, -5, 40, seed);
+    }
+
+    int pay(const Shift& shift) {
+        return shift.cost;
+    }
+
+    // Best total pay over subsets of matched workers, by dynamic programming over the jobs.
+    int best_total(const cgrapht::AdjacencyMatrix<int>& weights, const int jobs, const int workers) {
+        const cgrapht::FrozenGraph& frozen {weights.frozen_graph()};
+        std::vector<int> best(std::size_t{1} << workers, 0);
+        for (int j {0}; j < jobs; ++j) {
+            const std::size_t u {frozen.index_of(static_cast<std::size_t>(j)).get_ok()};
+            std::vector<int> next {best};
+            for (std::size_t mask {0}; mask < best.size(); ++mask) {
+                for (std::size_t slot {frozen.outgoing_offsets()[u]}; slot < frozen.outgoing_offsets()[u + 1]; ++slot) {
+                    const std::size_t w {frozen.vertex_id(frozen.outgoing_targets()[slot]) - static_cast<std::size_t>(jobs)};
+                    if (!(mask & (std::size_t{1} << w))) {
+                        const std::size_t with {mask | (std::size_t{1} << w)};
+                        next[with] = std::max(next[with], best[mask] + weights.row_values()[slot]);
+                    }
+                }
+            }
+            best = std::move(next);
+        }
+        return *std::ranges::max_element(best);
+    }
+
+    bool is_valid(const cgrapht::FrozenGraph& frozen, const std::vector<std::size_t>& mates, const std::size_t size) {
+        std::size_t matched {0};
+        for (std::size_t u {0}; u < frozen.vertex_count(); ++u) {
+            if (mates[u] == cgrapht::UNMATCHED) {
+                continue;
+            }
+            if (mates[mates[u]] != u) {
+                return false;
+            }
+            if (frozen.out_degree(u) != 0) {
+                const auto children {frozen.children(u)};
+                if (!std::ranges::binary_search(children, mates[u])) {
+                    return false;
+                }
+                ++matched;
+            }
+        }
+        return matched == size;
+    }
+}
+
+SCENARIO("Hopcroft-Karp finds maximum matchings") {
+    GIVEN("Random bipartite graphs") {
+        const int jobs {10};
+        const int workers {8};
+
+        WHEN("A maximum matching is requested") {
+            THEN("It is valid and as large as the exhaustive optimum") {
+                for (const unsigned seed : {1u, 2u, 3u}) {
+                    Graph graph {make_random(jobs, workers, 30, seed)};
+                    const cgrapht::FrozenGraph frozen {graph};
+                    auto ones = [](const Shift&) { return 1; };
+                    const auto unit {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, ones).consume_ok()};
+                    const cgrapht::Matching matching {cgrapht::hopcroft_karp(frozen).consume_ok()};
+                    REQUIRE(is_valid(frozen, matching.mates, matching.size));
+                    REQUIRE(static_cast<int>(matching.size) == best_total(unit, jobs, workers));
+                }
+            }
+        }
+    }
+
+    GIVEN("A chain where the greedy matching needs an augmenting path") {
+        // Jobs 0 and 1, workers 2 and 3: greedy takes 0-2 and leaves 1 stuck unless 0 moves to 3.
+        Graph graph {};
+        for (int v {0}; v < 4; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 2, Shift{0, 1});
+        graph.add_edge(0, 3, Shift{1, 1});
+        graph.add_edge(1, 2, Shift{2, 1});
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("A maximum matching is requested") {
+            const cgrapht::Matching matching {cgrapht::hopcroft_karp(frozen).consume_ok()};
+
+            THEN("Both jobs are matched") {
+                REQUIRE(matching.size == 2);
+                REQUIRE(frozen.vertex_id(matching.mates[frozen.index_of(1).get_ok()]) == 2);
+                REQUIRE(frozen.vertex_id(matching.mates[frozen.index_of(0).get_ok()]) == 3);
+            }
+        }
+    }
+
+    GIVEN("A graph that is not left to right") {
+        Graph graph {};
+        for (int v {0}; v < 3; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 1, Shift{0, 1});
+        graph.add_edge(1, 2, Shift{1, 1});
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("Matching is rejected") {
+            REQUIRE(cgrapht::hopcroft_karp(frozen).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+}
+
+SCENARIO("The auction algorithm finds maximum weight assignments") {
+    GIVEN("Random bipartite graphs with integer pay") {
+        const int jobs {12};
+        const int workers {9};
+
+        WHEN("An assignment is requested sequentially and in parallel") {
+            THEN("Both are valid and reach the exhaustive optimum") {
+                for (const unsigned seed : {4u, 5u, 6u, 7u}) {
+                    Graph graph {make_random(jobs, workers, 50, seed)};
+                    const cgrapht::FrozenGraph frozen {graph};
+                    const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, pay).consume_ok()};
+                    const int expected {best_total(weights, jobs, workers)};
+                    for (const std::size_t threads : {1, 4}) {
+                        const auto assignment {cgrapht::auction_assignment(weights, {.threads = threads}).consume_ok()};
+                        REQUIRE(is_valid(frozen, assignment.mates, assignment.size));
+                        REQUIRE(assignment.weight == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("Invalid options") {
+        Graph graph {make_random(3, 3, 5, 8)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, pay).consume_ok()};
+
+        THEN("They are rejected") {
+            REQUIRE(cgrapht::auction_assignment(weights, {.scaling = 1}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::auction_assignment(weights, {.epsilon = -1}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+}
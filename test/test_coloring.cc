@@ -0,0 +1,96 @@
+#define CATCH_CONFIG_MAIN
+
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/coloring.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    using Graph = cgrapht::testing::RandomGraph;
+    using cgrapht::testing::make_random;
+
+    bool is_proper(const cgrapht::FrozenGraph& frozen, const cgrapht::Coloring& coloring) {
+        for (std::size_t v {0}; v < frozen.vertex_count(); ++v) {
+            if (coloring.colors[v] >= coloring.count) {
+                return false;
+            }
+            for (const std::size_t u : frozen.children(v)) {
+                if (u != v && coloring.colors[u] == coloring.colors[v]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+SCENARIO("Greedy coloring separates adjacent vertices") {
+    GIVEN("A random graph with self loops and parallel edges") {
+        Graph graph {make_random(500, 3000, 1)};
+        graph.add_edge(3, 3, cgrapht::DefaultEdge{3000});
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("It is colored in every order") {
+            THEN("The coloring is proper") {
+                for (const auto order : {cgrapht::ColoringOrder::NATURAL, cgrapht::ColoringOrder::LARGEST_FIRST, cgrapht::ColoringOrder::SMALLEST_LAST}) {
+                    const cgrapht::Coloring coloring {cgrapht::greedy_coloring(frozen, order)};
+                    REQUIRE(is_proper(frozen, coloring));
+                    REQUIRE(coloring.count > 1);
+                }
+            }
+        }
+    }
+
+    GIVEN("A tree and a complete graph") {
+        Graph tree {};
+        for (int v {0}; v < 63; ++v) {
+            tree.add_vertex(v);
+            if (v != 0) {
+                tree.add_edge((v - 1) / 2, v, cgrapht::DefaultEdge{static_cast<std::size_t>(v)});
+            }
+        }
+        Graph complete {};
+        std::size_t edge {0};
+        for (int v {0}; v < 5; ++v) {
+            complete.add_vertex(v);
+            for (int u {0}; u < v; ++u) {
+                complete.add_edge(u, v, cgrapht::DefaultEdge{edge++});
+            }
+        }
+        const cgrapht::FrozenGraph frozen_tree {tree};
+        const cgrapht::FrozenGraph frozen_complete {complete};
+
+        THEN("Smallest-last uses degeneracy + 1 colors") {
+            REQUIRE(cgrapht::greedy_coloring(frozen_tree, cgrapht::ColoringOrder::SMALLEST_LAST).count == 2);
+            REQUIRE(cgrapht::greedy_coloring(frozen_complete, cgrapht::ColoringOrder::SMALLEST_LAST).count == 5);
+        }
+    }
+}
+
+SCENARIO("Speculative coloring resolves conflicts in parallel") {
+    GIVEN("A random graph") {
+        Graph graph {make_random(3000, 20000, 2)};
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("It is colored with one worker") {
+            THEN("It matches the greedy coloring in the same order") {
+                for (const auto order : {cgrapht::ColoringOrder::NATURAL, cgrapht::ColoringOrder::LARGEST_FIRST, cgrapht::ColoringOrder::SMALLEST_LAST}) {
+                    const cgrapht::Coloring coloring {cgrapht::speculative_coloring(frozen, {.order = order, .threads = 1})};
+                    REQUIRE(coloring.colors == cgrapht::greedy_coloring(frozen, order).colors);
+                }
+            }
+        }
+
+        WHEN("It is colored with several workers") {
+            const cgrapht::Coloring coloring {cgrapht::speculative_coloring(frozen, {.threads = 4})};
+
+            THEN("The coloring is proper") {
+                REQUIRE(is_proper(frozen, coloring));
+            }
+        }
+    }
+}
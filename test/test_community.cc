@@ -0,0 +1,158 @@
+#define CATCH_CONFIG_MAIN
+
+#include <set>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/community.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+namespace {
+    struct Tie {
+        std::size_t id;
+        double strength;
+
+        bool operator==(const Tie&) const = default;
+    };
+}
+
+template <>
+struct std::hash<Tie> {
+    std::size_t operator()(const Tie& tie) const noexcept {
+        return tie.id;
+    }
+};
+
+namespace {
+    // `cliques` cliques of `size` vertices each, consecutive cliques joined by one weak edge.
+    cgrapht::DirectedGraph<int, Tie> make_cliques(const std::size_t cliques, const std::size_t size) {
+        cgrapht::DirectedGraph<int, Tie> graph {};
+        std::size_t edge {0};
+        for (std::size_t v {0}; v < cliques * size; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        for (std::size_t c {0}; c < cliques; ++c) {
+            for (std::size_t a {0}; a < size; ++a) {
+                for (std::size_t b {a + 1}; b < size; ++b) {
+                    graph.add_edge(c * size + a, c * size + b, Tie{edge++, 1.0});
+                }
+            }
+            if (c + 1 < cliques) {
+                graph.add_edge(c * size, (c + 1) * size, Tie{edge++, 0.1});
+            }
+        }
+        return graph;
+    }
+
+    bool recovers_cliques(const cgrapht::Communities& communities, const std::size_t cliques, const std::size_t size) {
+        if (communities.count != cliques) {
+            return false;
+        }
+        std::set<std::size_t> seen {};
+        for (std::size_t c {0}; c < cliques; ++c) {
+            for (std::size_t v {0}; v < size; ++v) {
+                if (communities.labels[c * size + v] != communities.labels[c * size]) {
+                    return false;
+                }
+            }
+            seen.insert(communities.labels[c * size]);
+        }
+        return seen.size() == cliques;
+    }
+}
+
+SCENARIO("Detecting communities") {
+
+    GIVEN("I have a chain of weakly joined cliques") {
+
+        const auto graph {make_cliques(8, 6)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, graph, [](const Tie& tie) { return tie.strength; }).consume_ok()};
+
+        WHEN("I run Louvain") {
+
+            THEN("Every clique should be one community, on one or several workers") {
+
+                for (const std::size_t threads : {1, 4}) {
+                    auto communities = cgrapht::louvain(weights, {.threads = threads});
+                    REQUIRE(communities.is_ok());
+                    REQUIRE(recovers_cliques(communities.get_ok(), 8, 6));
+                    REQUIRE(communities.get_ok().modularity > 0.8);
+                    REQUIRE(std::abs(communities.get_ok().modularity - cgrapht::modularity(weights, communities.get_ok().labels).get_ok()) < 1e-12);
+                }
+            }
+        }
+
+        WHEN("I run label propagation") {
+
+            auto communities = cgrapht::label_propagation(weights, {.threads = 1});
+
+            THEN("Every clique should be one community") {
+
+                REQUIRE(communities.is_ok());
+                REQUIRE(recovers_cliques(communities.get_ok(), 8, 6));
+                REQUIRE(communities.get_ok().labels[0] == 0);
+            }
+        }
+
+        WHEN("I run Louvain at a high resolution") {
+
+            auto coarse = cgrapht::louvain(weights);
+            auto fine = cgrapht::louvain(weights, {.resolution = 20.0});
+
+            THEN("It should find more, smaller communities") {
+
+                REQUIRE(fine.get_ok().count > coarse.get_ok().count);
+            }
+        }
+    }
+
+    GIVEN("I have a large graph of cliques") {
+
+        const auto graph {make_cliques(400, 8)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<double>::pattern(frozen, 1.0)};
+
+        THEN("Parallel Louvain should coarsen down to the cliques") {
+
+            auto communities = cgrapht::louvain(weights, {.threads = 4});
+            REQUIRE(communities.is_ok());
+            REQUIRE(communities.get_ok().count <= 400);
+            REQUIRE(communities.get_ok().modularity > 0.9);
+        }
+
+        THEN("Parallel label propagation should find dense communities") {
+
+            auto communities = cgrapht::label_propagation(weights, {.threads = 4});
+            REQUIRE(communities.is_ok());
+            REQUIRE(communities.get_ok().modularity > 0.9);
+        }
+    }
+
+    GIVEN("I have edge cases") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> graph {};
+        graph.add_vertex(1);
+        graph.add_vertex(2);
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("Isolated vertices should stay alone") {
+
+            const auto weights {cgrapht::AdjacencyMatrix<double>::pattern(frozen, 1.0)};
+            REQUIRE(cgrapht::louvain(weights).get_ok().count == 2);
+            REQUIRE(cgrapht::label_propagation(weights).get_ok().count == 2);
+        }
+
+        THEN("Negative weights should be rejected") {
+
+            graph.add_edge(1, 2, cgrapht::DefaultEdge{1});
+            const cgrapht::FrozenGraph with_edge {graph};
+            const auto weights {cgrapht::AdjacencyMatrix<double>::pattern(with_edge, -1.0)};
+            REQUIRE(cgrapht::louvain(weights).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::label_propagation(weights).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+}
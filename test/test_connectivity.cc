@@ -0,0 +1,209 @@
+#define CATCH_CONFIG_MAIN
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/connectivity.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace {
+    template <typename Graph>
+    std::unordered_map<std::size_t, std::size_t> reference_components(const Graph& graph) {
+        std::unordered_map<std::size_t, std::size_t> component {};
+        std::size_t next {0};
+        for (const std::size_t start : graph.get_vertex_ids()) {
+            if (component.contains(start)) {
+                continue;
+            }
+            std::vector<std::size_t> stack {start};
+            component[start] = next;
+            while (!stack.empty()) {
+                const std::size_t v {stack.back()};
+                stack.pop_back();
+                for (const std::size_t w : graph.get_neighbours(v).consume_ok()) {
+                    if (component.emplace(w, next).second) {
+                        stack.push_back(w);
+                    }
+                }
+            }
+            ++next;
+        }
+        return component;
+    }
+}
+
+SCENARIO("Dynamic connectivity under edge updates") {
+
+    GIVEN("I have a graph observed by both connectivity structures") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge,
+                               cgrapht::ObserverChain<cgrapht::DynamicConnectivity, cgrapht::IncrementalConnectivity>> my_graph;
+        auto& dynamic {my_graph.get_observer().get<0>()};
+        auto& incremental {my_graph.get_observer().get<1>()};
+
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        const std::size_t v3 {my_graph.add_vertex(3).get_ok()};
+
+        WHEN("I connect them in a triangle") {
+
+            my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+            my_graph.add_edge(v3, v2, cgrapht::DefaultEdge{32});
+            my_graph.add_edge(v3, v1, cgrapht::DefaultEdge{31});
+
+            THEN("They should be connected regardless of direction") {
+
+                REQUIRE(dynamic.connected(v1, v3).get_ok());
+                REQUIRE(incremental.connected(v1, v3).get_ok());
+                REQUIRE(dynamic.component_count() == 1);
+                REQUIRE(dynamic.component_size(v2).get_ok() == 3);
+            }
+
+            AND_WHEN("I remove a tree edge that has a replacement") {
+
+                my_graph.delete_edge(12);
+
+                THEN("They should still be connected") {
+
+                    REQUIRE(dynamic.connected(v1, v2).get_ok());
+                    REQUIRE(incremental.connected(v1, v2).get_ok());
+                    REQUIRE(dynamic.component_count() == 1);
+
+                    AND_WHEN("I remove another edge") {
+
+                        my_graph.delete_edge(31);
+
+                        THEN("Vertex 1 should be split off") {
+
+                            REQUIRE(!dynamic.connected(v1, v2).get_ok());
+                            REQUIRE(!incremental.connected(v1, v3).get_ok());
+                            REQUIRE(dynamic.component_count() == 2);
+                            REQUIRE(incremental.component_count() == 2);
+                        }
+                    }
+                }
+            }
+        }
+
+        WHEN("I query an unknown vertex") {
+
+            THEN("I should get an error") {
+
+                REQUIRE(dynamic.connected(v1, 1000).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+                REQUIRE(incremental.connected(1000, v1).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+    }
+
+    GIVEN("I apply a random stream of inserts and deletes") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge,
+                               cgrapht::ObserverChain<cgrapht::DynamicConnectivity, cgrapht::IncrementalConnectivity>> my_graph;
+        std::vector<std::size_t> ids {};
+        for (int i {0}; i < 60; ++i) {
+            ids.push_back(my_graph.add_vertex(i).get_ok());
+        }
+
+        std::mt19937 rng {5};
+        std::uniform_int_distribution<std::size_t> pick {0, ids.size() - 1};
+        std::vector<std::size_t> live {};
+        for (std::size_t step {0}; step < 1500; ++step) {
+            if (live.size() < 40 || rng() % 3 != 0) {
+                const std::size_t id {1000 + step};
+                if (my_graph.add_edge(ids[pick(rng)], ids[pick(rng)], cgrapht::DefaultEdge{id}).is_ok()) {
+                    live.push_back(id);
+                }
+            } else {
+                const std::size_t victim {rng() % live.size()};
+                my_graph.delete_edge(live[victim]);
+                live[victim] = live.back();
+                live.pop_back();
+            }
+            if (step == 700) {
+                my_graph.delete_vertex(ids.back());
+                my_graph.add_vertex(1000);
+            }
+
+            if (step % 25 == 0) {
+                const auto expected {reference_components(my_graph)};
+                auto& dynamic {my_graph.get_observer().get<0>()};
+                auto& incremental {my_graph.get_observer().get<1>()};
+                for (std::size_t q {0}; q < 50; ++q) {
+                    const std::size_t a {*std::next(my_graph.get_vertex_ids().begin(), static_cast<std::ptrdiff_t>(rng() % expected.size()))};
+                    const std::size_t b {*std::next(my_graph.get_vertex_ids().begin(), static_cast<std::ptrdiff_t>(rng() % expected.size()))};
+                    const bool same {expected.at(a) == expected.at(b)};
+                    REQUIRE(dynamic.connected(a, b).get_ok() == same);
+                    REQUIRE(incremental.connected(a, b).get_ok() == same);
+                }
+            }
+        }
+
+        THEN("The component counts should match a recomputation") {
+
+            std::size_t expected_components {0};
+            const auto expected {reference_components(my_graph)};
+            for (const auto& [_, c] : expected) {
+                expected_components = std::max(expected_components, c + 1);
+            }
+            REQUIRE(my_graph.get_observer().get<0>().component_count() == expected_components);
+            REQUIRE(my_graph.get_observer().get<1>().component_count() == expected_components);
+        }
+    }
+
+    GIVEN("A sparse graph whose edges keep being cut and restored") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge, cgrapht::DynamicConnectivity> my_graph;
+        constexpr int vertices {400};
+        for (int i {0}; i < vertices; ++i) {
+            my_graph.add_vertex(i);
+        }
+        // A path plus a few chords, so tree deletions sometimes find a replacement and sometimes split the path.
+        std::vector<std::size_t> live {};
+        for (std::size_t i {0}; i + 1 < vertices; ++i) {
+            my_graph.add_edge(i, i + 1, cgrapht::DefaultEdge{i});
+            live.push_back(i);
+        }
+
+        std::mt19937 rng {9};
+        std::uniform_int_distribution<std::size_t> pick {0, vertices - 1};
+        for (std::size_t step {0}; step < 6000; ++step) {
+            if (live.size() < vertices || rng() % 2 == 0) {
+                const std::size_t id {vertices + step};
+                const std::size_t a {pick(rng)};
+                const std::size_t b {rng() % 4 == 0 ? pick(rng) : std::min<std::size_t>(a + 1, vertices - 1)};
+                my_graph.add_edge(a, b, cgrapht::DefaultEdge{id});
+                live.push_back(id);
+            } else {
+                const std::size_t victim {rng() % live.size()};
+                my_graph.delete_edge(live[victim]);
+                live[victim] = live.back();
+                live.pop_back();
+            }
+
+            if (step % 200 == 0) {
+                const auto expected {reference_components(my_graph)};
+                std::vector<std::size_t> sizes(vertices, 0);
+                for (const auto& [_, c] : expected) {
+                    ++sizes[c];
+                }
+                const auto& dynamic {my_graph.get_observer()};
+                for (std::size_t v {0}; v < vertices; ++v) {
+                    REQUIRE(dynamic.component_size(v).get_ok() == sizes[expected.at(v)]);
+                    REQUIRE(dynamic.connected(v, (v * 7) % vertices).get_ok() == (expected.at(v) == expected.at((v * 7) % vertices)));
+                }
+            }
+        }
+
+        THEN("The component count should match a recomputation") {
+
+            std::size_t expected_components {0};
+            for (const auto& [_, c] : reference_components(my_graph)) {
+                expected_components = std::max(expected_components, c + 1);
+            }
+            REQUIRE(my_graph.get_observer().component_count() == expected_components);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#define CATCH_CONFIG_MAIN
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/all_pairs_shortest_paths.hpp"
+#include "cgrapht/algorithms/contraction_hierarchy.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+namespace {
+    struct Street {
+        std::size_t id;
+        int minutes;
+
+        bool operator==(const Street&) const = default;
+    };
+}
+
+template <>
+struct std::hash<Street> {
+    std::size_t operator()(const Street& street) const noexcept {
+        return street.id;
+    }
+};
+
+namespace {
+    using Graph = cgrapht::DirectedGraph<int, Street>;
+
+    // A `side` x `side` grid of two way streets with random travel times, plus a few one way streets.
+    Graph make_grid(const std::size_t side, const unsigned seed) {
+        Graph graph {};
+        for (std::size_t v {0}; v < side * side; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        std::mt19937 rng {seed};
+        std::uniform_int_distribution<int> minutes {1, 9};
+        std::uniform_int_distribution<std::size_t> pick {0, side * side - 1};
+        std::size_t edge {0};
+        for (std::size_t r {0}; r < side; ++r) {
+            for (std::size_t c {0}; c < side; ++c) {
+                const std::size_t v {r * side + c};
+                if (c + 1 < side) {
+                    graph.add_edge(v, v + 1, Street{edge++, minutes(rng)});
+                    graph.add_edge(v + 1, v, Street{edge++, minutes(rng)});
+                }
+                if (r + 1 < side) {
+                    graph.add_edge(v, v + side, Street{edge++, minutes(rng)});
+                    graph.add_edge(v + side, v, Street{edge++, minutes(rng)});
+                }
+            }
+        }
+        for (std::size_t i {0}; i < side; ++i) {
+            graph.add_edge(pick(rng), pick(rng), Street{edge++, 5 * minutes(rng)});
+        }
+        return graph;
+    }
+
+    int minutes(const Street& street) {
+        return street.minutes;
+    }
+}
+
+SCENARIO("Contraction hierarchy queries match Dijkstra") {
+    GIVEN("A random grid road network and its hierarchy") {
+        Graph graph {make_grid(20, 5)};
+        graph.add_vertex(-1);
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, minutes).consume_ok()};
+        const auto expected {cgrapht::johnson(weights).consume_ok()};
+
+        WHEN("The hierarchy is built with one and several workers") {
+            std::vector<cgrapht::ContractionHierarchy<int>> hierarchies {};
+            for (const std::size_t threads : {1, 4}) {
+                hierarchies.push_back(cgrapht::ContractionHierarchy<int>::build(weights, {.threads = threads}).consume_ok());
+            }
+            // The crudest importance estimates only change the contraction order, never the distances.
+            hierarchies.push_back(cgrapht::ContractionHierarchy<int>::build(weights, {.priority_settle_limit = 1, .priority_hop_limit = 1}).consume_ok());
+
+            THEN("Every distance is the Dijkstra distance") {
+                for (const auto& hierarchy : hierarchies) {
+                    REQUIRE(hierarchy.shortcut_count() > 0);
+                    for (std::size_t s {0}; s < frozen.vertex_count(); s += 7) {
+                        for (std::size_t t {0}; t < frozen.vertex_count(); ++t) {
+                            REQUIRE(hierarchy.distance(frozen.vertex_id(s), frozen.vertex_id(t)).get_ok() == expected.at(s, t));
+                        }
+                    }
+                }
+            }
+
+            THEN("Unpacked paths use original edges and have the shortest length") {
+                for (const auto& hierarchy : hierarchies) {
+                    for (std::size_t s {0}; s < frozen.vertex_count(); s += 13) {
+                        for (std::size_t t {1}; t < frozen.vertex_count(); t += 5) {
+                            auto path = hierarchy.shortest_path(frozen.vertex_id(s), frozen.vertex_id(t)).consume_ok();
+                            if (expected.at(s, t) == cgrapht::DistanceMatrix<int>::unreachable()) {
+                                REQUIRE(path.empty());
+                                continue;
+                            }
+                            REQUIRE(path.front() == frozen.vertex_id(s));
+                            REQUIRE(path.back() == frozen.vertex_id(t));
+                            int length {0};
+                            for (std::size_t i {1}; i < path.size(); ++i) {
+                                int lightest {std::numeric_limits<int>::max()};
+                                for (const std::size_t id : graph.get_outgoing_edges(path[i - 1]).consume_ok()) {
+                                    const auto edge {graph.get_edge(id).consume_ok()};
+                                    if (edge.to_id == path[i]) {
+                                        lightest = std::min(lightest, edge.edge.minutes);
+                                    }
+                                }
+                                REQUIRE(lightest != std::numeric_limits<int>::max());
+                                length += lightest;
+                            }
+                            REQUIRE(length == expected.at(s, t));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Contraction hierarchy edge cases") {
+    GIVEN("A small graph with a self loop and parallel edges") {
+        Graph graph {};
+        for (int v {0}; v < 3; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 0, Street{0, 1});
+        graph.add_edge(0, 1, Street{1, 7});
+        graph.add_edge(0, 1, Street{2, 3});
+        graph.add_edge(1, 2, Street{3, 2});
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, graph, minutes).consume_ok()};
+        const auto hierarchy {cgrapht::ContractionHierarchy<int>::build(weights).consume_ok()};
+
+        WHEN("Queries are answered") {
+            THEN("The lighter parallel edge is used and missing routes are unreachable") {
+                REQUIRE(hierarchy.distance(0, 2).get_ok() == 5);
+                REQUIRE(hierarchy.distance(1, 1).get_ok() == 0);
+                REQUIRE(hierarchy.shortest_path(0, 2).get_ok() == std::vector<std::size_t>{0, 1, 2});
+                REQUIRE(hierarchy.shortest_path(1, 1).get_ok() == std::vector<std::size_t>{1});
+                REQUIRE(hierarchy.distance(2, 0).get_ok() == std::numeric_limits<int>::max());
+                REQUIRE(hierarchy.shortest_path(2, 0).get_ok().empty());
+                REQUIRE(hierarchy.distance(0, 42).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+
+        WHEN("A weight is negative") {
+            graph.add_edge(2, 0, Street{4, -1});
+            const cgrapht::FrozenGraph negative {graph};
+            const auto bad {cgrapht::AdjacencyMatrix<int>::weighted(negative, graph, minutes).consume_ok()};
+
+            THEN("Preprocessing refuses") {
+                REQUIRE(cgrapht::ContractionHierarchy<int>::build(bad).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/cycles.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    using Graph = cgrapht::testing::RandomGraph;
+    using cgrapht::testing::make_random;
+    using Cycles = std::vector<std::vector<std::size_t>>;
+
+    // Every simple path from each start over larger vertices that closes back at the start.
+    Cycles brute_force(const cgrapht::FrozenGraph& frozen, const std::size_t max_length) {
+        Cycles cycles {};
+        std::vector<std::size_t> path {};
+        std::vector<bool> on_path(frozen.vertex_count(), false);
+        auto extend = [&](auto& self, const std::size_t start) -> void {
+            const auto children {frozen.children(path.back())};
+            for (std::size_t i {0}; i < children.size(); ++i) {
+                const std::size_t w {children[i]};
+                if (i != 0 && children[i - 1] == w) {
+                    continue;
+                }
+                if (w == start && (max_length == 0 || path.size() <= max_length)) {
+                    cycles.emplace_back();
+                    for (const std::size_t v : path) {
+                        cycles.back().push_back(frozen.vertex_id(v));
+                    }
+                } else if (w > start && !on_path[w] && (max_length == 0 || path.size() < max_length)) {
+                    on_path[w] = true;
+                    path.push_back(w);
+                    self(self, start);
+                    path.pop_back();
+                    on_path[w] = false;
+                }
+            }
+        };
+        for (std::size_t start {0}; start < frozen.vertex_count(); ++start) {
+            path.assign(1, start);
+            extend(extend, start);
+        }
+        std::ranges::sort(cycles);
+        return cycles;
+    }
+
+    Cycles collect(const cgrapht::FrozenGraph& frozen, const cgrapht::CycleOptions& options) {
+        Cycles cycles {};
+        std::mutex lock {};
+        const std::size_t count {cgrapht::enumerate_cycles(frozen, [&](std::span<const std::size_t> ids) {
+            const std::scoped_lock guard {lock};
+            cycles.emplace_back(ids.begin(), ids.end());
+        }, options)};
+        REQUIRE(count == cycles.size());
+        std::ranges::sort(cycles);
+        return cycles;
+    }
+}
+
+SCENARIO("Johnson's algorithm enumerates every elementary cycle") {
+    GIVEN("Random graphs with self loops and parallel edges") {
+        WHEN("All cycles are enumerated with one and several workers") {
+            THEN("They are exactly the simple closed paths") {
+                for (const unsigned seed : {1u, 2u, 3u}) {
+                    Graph graph {make_random(12, 30, seed)};
+                    graph.add_edge(4, 4, cgrapht::DefaultEdge{30});
+                    const cgrapht::FrozenGraph frozen {graph};
+                    const Cycles expected {brute_force(frozen, 0)};
+                    REQUIRE(expected.size() > 10);
+                    for (const std::size_t threads : {1, 4}) {
+                        REQUIRE(collect(frozen, {.threads = threads}) == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("A dense random graph") {
+        Graph graph {make_random(40, 150, 4)};
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("Cycles up to a length bound are enumerated") {
+            THEN("They are exactly the short simple closed paths") {
+                for (const std::size_t max_length : {1, 3, 5}) {
+                    REQUIRE(collect(frozen, {.max_length = max_length, .threads = 4}) == brute_force(frozen, max_length));
+                }
+            }
+        }
+
+        WHEN("Cycles up to longer bounds are enumerated on sparser graphs") {
+            THEN("Lock levels never hide a cycle") {
+                for (const unsigned seed : {5u, 6u, 7u, 8u, 9u, 10u}) {
+                    Graph sparse {make_random(16, 40, seed)};
+                    const cgrapht::FrozenGraph sparse_frozen {sparse};
+                    for (const std::size_t max_length : {4, 6, 8, 12}) {
+                        REQUIRE(collect(sparse_frozen, {.max_length = max_length, .threads = 1}) == brute_force(sparse_frozen, max_length));
+                    }
+                }
+            }
+        }
+
+        WHEN("The callback asks to stop") {
+            std::size_t seen {0};
+            const std::size_t count {cgrapht::enumerate_cycles(frozen, [&](std::span<const std::size_t>) {
+                return ++seen < 5;
+            }, {.threads = 1})};
+
+            THEN("The search ends early") {
+                REQUIRE(count == 5);
+                REQUIRE(seen == 5);
+            }
+        }
+    }
+}
+
+SCENARIO("Bounded search revisits a vertex when a shorter way back opens up") {
+    GIVEN("A vertex that first closes a cycle the long way round, while the short way is still on the path") {
+        // 2 first closes 0 1 2 3 4 through 3 and 4, as 1 is on the path. Reached again by 0 7 8, only 2 1 0 fits.
+        Graph graph {};
+        for (int v {0}; v < 9; ++v) {
+            graph.add_vertex(v);
+        }
+        std::size_t id {0};
+        for (const auto& [from, to] : std::vector<std::pair<std::size_t, std::size_t>>{{0, 1}, {1, 0}, {1, 2}, {2, 1}, {2, 3}, {3, 4}, {4, 0}, {0, 7}, {7, 8}, {8, 2}}) {
+            graph.add_edge(from, to, cgrapht::DefaultEdge{id++});
+        }
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("Cycles of up to 5 edges are enumerated") {
+            THEN("The cycle through the second way in is found") {
+                const Cycles cycles {collect(frozen, {.max_length = 5, .threads = 1})};
+                REQUIRE(cycles == brute_force(frozen, 5));
+                REQUIRE(std::ranges::binary_search(cycles, std::vector<std::size_t>{0, 7, 8, 2, 1}));
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#define CATCH_CONFIG_MAIN
+
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/dominators.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    using Graph = cgrapht::testing::RandomGraph;
+    using cgrapht::testing::make_random;
+
+    // Vertices reached from the root without passing through `removed`.
+    std::vector<bool> reached(const cgrapht::FrozenGraph& frozen, const std::size_t root, const std::size_t removed, const bool forward) {
+        std::vector<bool> seen(frozen.vertex_count(), false);
+        if (root == removed) {
+            return seen;
+        }
+        std::vector<std::size_t> stack {root};
+        seen[root] = true;
+        while (!stack.empty()) {
+            const std::size_t v {stack.back()};
+            stack.pop_back();
+            for (const std::size_t w : forward ? frozen.children(v) : frozen.parents(v)) {
+                if (w != removed && !seen[w]) {
+                    seen[w] = true;
+                    stack.push_back(w);
+                }
+            }
+        }
+        return seen;
+    }
+
+    // Immediate dominators from the definition: d dominates v if removing d cuts v off from the root.
+    std::vector<std::size_t> brute_force(const cgrapht::FrozenGraph& frozen, const std::size_t root, const bool forward) {
+        const std::size_t n {frozen.vertex_count()};
+        const std::vector<bool> reachable {reached(frozen, root, n, forward)};
+        std::vector<std::vector<bool>> dominated_by(n, std::vector<bool>(n, false));
+        std::vector<std::size_t> dominator_count(n, 0);
+        for (std::size_t d {0}; d < n; ++d) {
+            const std::vector<bool> without {reached(frozen, root, d, forward)};
+            for (std::size_t v {0}; v < n; ++v) {
+                if (reachable[v] && reachable[d] && (v == d || !without[v])) {
+                    dominated_by[v][d] = true;
+                    ++dominator_count[v];
+                }
+            }
+        }
+        std::vector<std::size_t> idom(n, cgrapht::NO_DOMINATOR);
+        for (std::size_t v {0}; v < n; ++v) {
+            if (!reachable[v]) {
+                continue;
+            }
+            idom[v] = v;
+            // The closest strict dominator is the one with the most dominators of its own.
+            for (std::size_t d {0}; d < n; ++d) {
+                if (d != v && dominated_by[v][d] && (idom[v] == v || dominator_count[d] > dominator_count[idom[v]])) {
+                    idom[v] = d;
+                }
+            }
+        }
+        return idom;
+    }
+
+    std::vector<std::size_t> copy(const std::span<const std::size_t> idom) {
+        return {idom.begin(), idom.end()};
+    }
+}
+
+SCENARIO("Dominators match their definition") {
+    GIVEN("A control-flow graph with a branch and a loop") {
+        // 0 -> 1 -> {2, 3} -> 4 -> 1 (back edge), 4 -> 5
+        Graph graph {};
+        for (int v {0}; v < 6; ++v) {
+            graph.add_vertex(v);
+        }
+        const std::vector<std::pair<int, int>> edges {{0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 1}, {4, 5}};
+        for (std::size_t e {0}; e < edges.size(); ++e) {
+            graph.add_edge(edges[e].first, edges[e].second, cgrapht::DefaultEdge{e});
+        }
+        const cgrapht::FrozenGraph frozen {graph};
+        auto id_of = [&](const std::size_t index) { return frozen.vertex_id(index); };
+
+        THEN("The join is dominated by the branch and post-dominates it") {
+            for (const auto algorithm : {cgrapht::DominatorAlgorithm::LENGAUER_TARJAN, cgrapht::DominatorAlgorithm::ITERATIVE}) {
+                const auto idom {copy(cgrapht::immediate_dominators(frozen, 0, cgrapht::Direction::OUTGOING, algorithm).consume_ok())};
+                REQUIRE(id_of(idom[frozen.index_of(0).get_ok()]) == 0);
+                REQUIRE(id_of(idom[frozen.index_of(4).get_ok()]) == 1);
+                REQUIRE(id_of(idom[frozen.index_of(5).get_ok()]) == 4);
+
+                const auto ipdom {copy(cgrapht::immediate_post_dominators(frozen, 5, algorithm).consume_ok())};
+                REQUIRE(id_of(ipdom[frozen.index_of(1).get_ok()]) == 4);
+                REQUIRE(id_of(ipdom[frozen.index_of(0).get_ok()]) == 1);
+            }
+        }
+    }
+
+    GIVEN("Random graphs") {
+        THEN("Both algorithms agree with the definition in both directions") {
+            for (const unsigned seed : {1u, 2u, 3u, 4u, 5u}) {
+                Graph graph {make_random(40, 70, seed)};
+                const cgrapht::FrozenGraph frozen {graph};
+                for (const bool forward : {true, false}) {
+                    const auto expected {brute_force(frozen, frozen.index_of(0).get_ok(), forward)};
+                    const auto direction {forward ? cgrapht::Direction::OUTGOING : cgrapht::Direction::INCOMING};
+                    for (const auto algorithm : {cgrapht::DominatorAlgorithm::LENGAUER_TARJAN, cgrapht::DominatorAlgorithm::ITERATIVE}) {
+                        REQUIRE(copy(cgrapht::immediate_dominators(frozen, 0, direction, algorithm).consume_ok()) == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("Invalid arguments") {
+        Graph graph {make_random(3, 3, 6)};
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("They are rejected") {
+            REQUIRE(cgrapht::immediate_dominators(frozen, 42).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            REQUIRE(cgrapht::immediate_dominators(frozen, 0, cgrapht::Direction::BOTH).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#define CATCH_CONFIG_MAIN
+
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/eulerian.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace {
+    using Graph = cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>;
+
+    // Overlapping random closed walks through vertex 0, so every vertex is balanced and every edge is reachable.
+    Graph make_balanced(const std::size_t vertices, const std::size_t walks, const unsigned seed) {
+        Graph graph {};
+        for (std::size_t v {0}; v < vertices; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        std::mt19937 rng {seed};
+        std::uniform_int_distribution<std::size_t> pick {0, vertices - 1};
+        std::uniform_int_distribution<std::size_t> length {1, 12};
+        std::size_t id {0};
+        for (std::size_t w {0}; w < walks; ++w) {
+            std::size_t at {0};
+            for (std::size_t step {length(rng)}; step > 0; --step) {
+                const std::size_t next {pick(rng)};
+                graph.add_edge(at, next, cgrapht::DefaultEdge{id++});
+                at = next;
+            }
+            graph.add_edge(at, 0, cgrapht::DefaultEdge{id++});
+        }
+        return graph;
+    }
+
+    // The edges chain up head to tail and each edge is used exactly once.
+    bool is_trail(const Graph& graph, const std::vector<std::size_t>& walk) {
+        if (walk.size() != graph.get_edge_entries().size() || std::set<std::size_t>(walk.begin(), walk.end()).size() != walk.size()) {
+            return false;
+        }
+        for (std::size_t i {1}; i < walk.size(); ++i) {
+            if (graph.get_edge(walk[i - 1]).get_ok().to_id != graph.get_edge(walk[i]).get_ok().from_id) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+SCENARIO("Hierholzer's algorithm walks every edge once") {
+    GIVEN("Random balanced graphs with self loops and parallel edges") {
+        THEN("The circuit is a closed trail over all edges") {
+            for (const unsigned seed : {1u, 2u, 3u}) {
+                const Graph graph {make_balanced(30, 40, seed)};
+                const cgrapht::FrozenGraph frozen {graph};
+                REQUIRE(cgrapht::degree_imbalance(frozen).total == 0);
+                const auto circuit {cgrapht::eulerian_circuit(frozen).consume_ok()};
+                REQUIRE(is_trail(graph, circuit));
+                REQUIRE(graph.get_edge(circuit.back()).get_ok().to_id == graph.get_edge(circuit.front()).get_ok().from_id);
+                REQUIRE(cgrapht::eulerian_path(frozen).consume_ok() == circuit);
+            }
+        }
+
+        THEN("Without one edge, the path runs from its head to its tail") {
+            for (const unsigned seed : {4u, 5u, 6u}) {
+                Graph graph {make_balanced(30, 40, seed)};
+                const auto removed {graph.get_edge(7).get_ok()};
+                if (removed.from_id == removed.to_id) {
+                    continue;
+                }
+                graph.delete_edge(7);
+                const cgrapht::FrozenGraph frozen {graph};
+                const auto imbalance {cgrapht::degree_imbalance(frozen)};
+                REQUIRE(imbalance.total == 1);
+                REQUIRE(imbalance.starts == std::vector<cgrapht::Imbalance>{{removed.from_id, 1}});
+                REQUIRE(imbalance.ends == std::vector<cgrapht::Imbalance>{{removed.to_id, 1}});
+
+                REQUIRE(cgrapht::eulerian_circuit(frozen).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+                const auto path {cgrapht::eulerian_path(frozen).consume_ok()};
+                REQUIRE(is_trail(graph, path));
+                REQUIRE(graph.get_edge(path.front()).get_ok().from_id == removed.to_id);
+                REQUIRE(graph.get_edge(path.back()).get_ok().to_id == removed.from_id);
+            }
+        }
+    }
+
+    GIVEN("A single cycle of a million edges") {
+        Graph graph {};
+        constexpr std::size_t length {1'000'000};
+        for (std::size_t v {0}; v < length; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        for (std::size_t v {0}; v < length; ++v) {
+            graph.add_edge(v, (v + 1) % length, cgrapht::DefaultEdge{v});
+        }
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("The walk neither recurses nor loses an edge") {
+            const auto circuit {cgrapht::eulerian_circuit(frozen).consume_ok()};
+            std::vector<std::size_t> expected(length);
+            std::iota(expected.begin(), expected.end(), 0);
+            REQUIRE(circuit == expected);
+        }
+    }
+
+    GIVEN("Graphs without an Eulerian walk") {
+        Graph two_cycles {};
+        for (int v {0}; v < 4; ++v) {
+            two_cycles.add_vertex(v);
+        }
+        two_cycles.add_edge(0, 1, cgrapht::DefaultEdge{0});
+        two_cycles.add_edge(1, 0, cgrapht::DefaultEdge{1});
+        two_cycles.add_edge(2, 3, cgrapht::DefaultEdge{2});
+        two_cycles.add_edge(3, 2, cgrapht::DefaultEdge{3});
+        Graph star {};
+        for (int v {0}; v < 4; ++v) {
+            star.add_vertex(v);
+        }
+        star.add_edge(0, 1, cgrapht::DefaultEdge{0});
+        star.add_edge(0, 2, cgrapht::DefaultEdge{1});
+        star.add_edge(0, 3, cgrapht::DefaultEdge{2});
+        const cgrapht::FrozenGraph frozen_two_cycles {two_cycles};
+        const cgrapht::FrozenGraph frozen_star {star};
+        const Graph empty {};
+        const cgrapht::FrozenGraph frozen_empty {empty};
+
+        THEN("Disconnected and unbalanced graphs are rejected and the postman imbalance is reported") {
+            REQUIRE(cgrapht::eulerian_circuit(frozen_two_cycles).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::eulerian_path(frozen_two_cycles).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::eulerian_path(frozen_star).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+
+            const auto imbalance {cgrapht::degree_imbalance(frozen_star)};
+            REQUIRE(imbalance.total == 3);
+            REQUIRE(imbalance.starts == std::vector<cgrapht::Imbalance>{{1, 1}, {2, 1}, {3, 1}});
+            REQUIRE(imbalance.ends == std::vector<cgrapht::Imbalance>{{0, 3}});
+
+            REQUIRE(cgrapht::eulerian_circuit(frozen_empty).consume_ok().empty());
+        }
+    }
+}
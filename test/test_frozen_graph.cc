@@ -0,0 +1,95 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+
+SCENARIO("Freezing a graph into CSR form") {
+
+    GIVEN("I have a small graph with a parallel edge") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        const std::size_t v3 {my_graph.add_vertex(3).get_ok()};
+        const std::size_t v4 {my_graph.add_vertex(4).get_ok()};
+
+        const std::size_t e12 {my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12}).get_ok()};
+        const std::size_t e13 {my_graph.add_edge(v1, v3, cgrapht::DefaultEdge{13}).get_ok()};
+        const std::size_t e13b {my_graph.add_edge(v1, v3, cgrapht::DefaultEdge{113}).get_ok()};
+        const std::size_t e32 {my_graph.add_edge(v3, v2, cgrapht::DefaultEdge{32}).get_ok()};
+
+        WHEN("I freeze it") {
+
+            const cgrapht::FrozenGraph frozen {my_graph};
+
+            THEN("The counts should match the source graph") {
+
+                REQUIRE(frozen.vertex_count() == 4);
+                REQUIRE(frozen.edge_count() == 4);
+            }
+
+            THEN("Dense indices should round trip to vertex ids") {
+
+                for (const std::size_t id : {v1, v2, v3, v4}) {
+                    const std::size_t index {frozen.index_of(id).get_ok()};
+                    REQUIRE(index < frozen.vertex_count());
+                    REQUIRE(frozen.vertex_id(index) == id);
+                }
+                REQUIRE(frozen.index_of(1000).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+
+            THEN("Neighbourhoods should be sorted and aligned with their edge ids") {
+
+                const std::size_t i1 {frozen.index_of(v1).get_ok()};
+                const std::size_t i2 {frozen.index_of(v2).get_ok()};
+                const std::size_t i3 {frozen.index_of(v3).get_ok()};
+                const std::size_t i4 {frozen.index_of(v4).get_ok()};
+
+                const auto children {frozen.children(i1)};
+                REQUIRE(children.size() == 3);
+                REQUIRE(std::ranges::is_sorted(children));
+                REQUIRE(frozen.out_degree(i1) == 3);
+
+                const auto edges {frozen.outgoing_edges(i1)};
+                for (std::size_t k {0}; k < children.size(); ++k) {
+                    const auto edge {my_graph.get_edge(edges[k]).get_ok()};
+                    REQUIRE(frozen.index_of(edge.to_id).get_ok() == children[k]);
+                }
+                std::vector<std::size_t> edge_ids(edges.begin(), edges.end());
+                std::ranges::sort(edge_ids);
+                std::vector<std::size_t> expected {e12, e13, e13b};
+                std::ranges::sort(expected);
+                REQUIRE(edge_ids == expected);
+
+                REQUIRE(frozen.in_degree(i2) == 2);
+                REQUIRE(std::ranges::is_sorted(frozen.parents(i2)));
+                REQUIRE(frozen.parents(i3).size() == 2);
+                REQUIRE(frozen.incoming_edges(i2).size() == 2);
+                REQUIRE(std::ranges::find(frozen.incoming_edges(i2), e32) != frozen.incoming_edges(i2).end());
+
+                REQUIRE(frozen.children(i4).empty());
+                REQUIRE(frozen.parents(i4).empty());
+            }
+        }
+    }
+
+    GIVEN("I have an empty graph") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+
+        WHEN("I freeze it") {
+
+            const cgrapht::FrozenGraph frozen {my_graph};
+
+            THEN("It should be empty") {
+
+                REQUIRE(frozen.vertex_count() == 0);
+                REQUIRE(frozen.edge_count() == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#define CATCH_CONFIG_MAIN
+
+#include <numeric>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+
+SCENARIO("Graph diagnostics") {
+
+    GIVEN("I have a star graph with a hub and a few extra edges") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph {};
+        const std::size_t hub {my_graph.add_vertex(0).get_ok()};
+        std::size_t next_edge {1};
+        for (int i {1}; i <= 100; ++i) {
+            const std::size_t leaf {my_graph.add_vertex(i).get_ok()};
+            my_graph.add_edge(hub, leaf, cgrapht::DefaultEdge{next_edge++});
+        }
+        const std::size_t second {my_graph.add_vertex(1000).get_ok()};
+        for (int i {1}; i <= 5; ++i) {
+            my_graph.add_edge(static_cast<std::size_t>(i), second, cgrapht::DefaultEdge{next_edge++});
+        }
+
+        WHEN("I compute the stats on several workers") {
+
+            const cgrapht::GraphStats stats {my_graph.stats({.top_hubs = 2, .threads = 4})};
+
+            THEN("The table stats should be consistent with the tables") {
+
+                for (const cgrapht::HashTableStats& table : {stats.vertex_table, stats.edge_table, stats.adjacency_table}) {
+                    REQUIRE(table.occupied_buckets + table.colliding_keys == table.size);
+                    REQUIRE(std::accumulate(table.chain_length_histogram.begin(), table.chain_length_histogram.end(), std::size_t{0}) == table.bucket_count);
+                    REQUIRE(table.max_chain_length >= 1);
+                    REQUIRE(table.mean_probe_length >= 1.0);
+                    REQUIRE(table.mean_probe_length <= static_cast<double>(table.max_chain_length));
+                }
+                REQUIRE(stats.vertex_table.size == 102);
+                REQUIRE(stats.edge_table.size == 105);
+                REQUIRE(stats.adjacency_table.size == 102);
+            }
+
+            THEN("The degree distribution should reflect the skew") {
+
+                REQUIRE(stats.out_degree.max == 100);
+                REQUIRE(stats.out_degree.p50 == 0);
+                REQUIRE(stats.out_degree.p99 == 1);
+                REQUIRE(stats.in_degree.max == 5);
+                REQUIRE(stats.in_degree.p50 == 1);
+                REQUIRE(stats.out_degree.mean == stats.in_degree.mean);
+            }
+
+            THEN("The hubs should be the highest degree vertices") {
+
+                REQUIRE(stats.hubs == std::vector<cgrapht::Hub>{{hub, 100, 0}, {second, 0, 5}});
+            }
+
+            THEN("A sequential pass should report the same") {
+
+                const cgrapht::GraphStats sequential {my_graph.stats({.top_hubs = 2, .threads = 1})};
+                REQUIRE(sequential.hubs == stats.hubs);
+                REQUIRE(sequential.edge_table.chain_length_histogram == stats.edge_table.chain_length_histogram);
+                REQUIRE(sequential.out_degree.p90 == stats.out_degree.p90);
+            }
+        }
+    }
+
+    GIVEN("I have an empty graph") {
+
+        const cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph {};
+
+        THEN("The stats should be empty") {
+
+            const cgrapht::GraphStats stats {my_graph.stats()};
+            REQUIRE(stats.vertex_table.size == 0);
+            REQUIRE(stats.vertex_table.mean_probe_length == 0);
+            REQUIRE(stats.out_degree.max == 0);
+            REQUIRE(stats.hubs.empty());
+        }
+    }
+}
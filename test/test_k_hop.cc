@@ -0,0 +1,111 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/k_hop.hpp"
+#include "cgrapht/default_edge.hpp"
+
+namespace {
+    std::uint32_t distance_of(std::span<const cgrapht::Hop> hops, const std::size_t vertex_id) {
+        auto it = std::ranges::find(hops, vertex_id, &cgrapht::Hop::vertex_id);
+        REQUIRE(it != hops.end());
+        return it->distance;
+    }
+}
+
+SCENARIO("k-hop neighbourhoods") {
+
+    GIVEN("I have a graph 1 -> 2 -> 3 -> 4 with a shortcut 1 -> 3 and a back edge 5 -> 1") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        const std::size_t v3 {my_graph.add_vertex(3).get_ok()};
+        const std::size_t v4 {my_graph.add_vertex(4).get_ok()};
+        const std::size_t v5 {my_graph.add_vertex(5).get_ok()};
+        my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+        my_graph.add_edge(v2, v3, cgrapht::DefaultEdge{23});
+        my_graph.add_edge(v3, v4, cgrapht::DefaultEdge{34});
+        my_graph.add_edge(v1, v3, cgrapht::DefaultEdge{13});
+        my_graph.add_edge(v5, v1, cgrapht::DefaultEdge{51});
+        const cgrapht::FrozenGraph frozen {my_graph};
+
+        WHEN("I ask for the 1-hop outgoing neighbourhood of 1") {
+
+            auto result = cgrapht::k_hop(frozen, v1, 1);
+
+            THEN("I should get 1, 2 and 3 with their distances, source first") {
+
+                REQUIRE(result.is_ok());
+                const auto hops {result.get_ok()};
+                REQUIRE(hops.size() == 3);
+                REQUIRE(hops.front() == cgrapht::Hop{v1, frozen.index_of(v1).get_ok(), 0});
+                REQUIRE(distance_of(hops, v2) == 1);
+                REQUIRE(distance_of(hops, v3) == 1);
+            }
+        }
+
+        WHEN("I ask for 2 hops in both directions, twice in a row") {
+
+            auto first = cgrapht::k_hop(frozen, v4, 1);
+            REQUIRE(first.get_ok().size() == 1);
+            auto result = cgrapht::k_hop(frozen, v2, 2, cgrapht::Direction::BOTH);
+
+            THEN("The second query should not see state left by the first") {
+
+                const auto hops {result.get_ok()};
+                REQUIRE(hops.size() == 5);
+                REQUIRE(distance_of(hops, v2) == 0);
+                REQUIRE(distance_of(hops, v1) == 1);
+                REQUIRE(distance_of(hops, v3) == 1);
+                REQUIRE(distance_of(hops, v4) == 2);
+                REQUIRE(distance_of(hops, v5) == 2);
+                REQUIRE(std::ranges::is_sorted(hops, {}, &cgrapht::Hop::distance));
+            }
+        }
+
+        WHEN("I follow incoming edges only") {
+
+            auto result = cgrapht::k_hop(frozen, v3, 5, cgrapht::Direction::INCOMING);
+
+            THEN("I should get the ancestors") {
+
+                const auto hops {result.get_ok()};
+                REQUIRE(hops.size() == 4);
+                REQUIRE(distance_of(hops, v1) == 1);
+                REQUIRE(distance_of(hops, v5) == 2);
+            }
+        }
+
+        WHEN("I ask for zero hops or an unknown vertex") {
+
+            auto zero = cgrapht::k_hop(frozen, v1, 0);
+            REQUIRE(zero.get_ok().size() == 1);
+
+            auto absent = cgrapht::k_hop(frozen, 1000, 2);
+
+            THEN("Unknown vertices should be an error") {
+
+                REQUIRE(absent.get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+
+        WHEN("I extract the 1-hop ego network of 1") {
+
+            auto result = cgrapht::ego_subgraph(my_graph, frozen, v1, 1);
+
+            THEN("It should hold the neighbourhood and every edge between its members") {
+
+                REQUIRE(result.is_ok());
+                const auto& ego {result.get_ok()};
+                REQUIRE(ego.get_vertices().size() == 3);
+                REQUIRE(ego.get_edges().size() == 3);
+                REQUIRE(ego.get_edge(cgrapht::DefaultEdge{23}.id).get_ok().to_id == v3);
+                REQUIRE(!ego.get_vertex(v4).is_ok());
+                REQUIRE(!ego.get_edge(cgrapht::DefaultEdge{51}.id).is_ok());
+            }
+        }
+    }
+}
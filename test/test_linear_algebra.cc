@@ -0,0 +1,228 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/linear_algebra.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace {
+    struct Road {
+        std::size_t id;
+        int length;
+
+        bool operator==(const Road&) const = default;
+    };
+}
+
+template <>
+struct std::hash<Road> {
+    std::size_t operator()(const Road& road) const noexcept {
+        return road.id;
+    }
+};
+
+namespace {
+    // 0 -> 1 (4), 0 -> 2 (1), 2 -> 1 (2), 1 -> 3 (5), 2 -> 3 (8), 4 isolated
+    cgrapht::DirectedGraph<int, Road> make_roads() {
+        cgrapht::DirectedGraph<int, Road> graph {};
+        for (int i {0}; i < 5; ++i) {
+            graph.add_vertex(i);
+        }
+        graph.add_edge(0, 1, Road{1, 4});
+        graph.add_edge(0, 2, Road{2, 1});
+        graph.add_edge(2, 1, Road{3, 2});
+        graph.add_edge(1, 3, Road{4, 5});
+        graph.add_edge(2, 3, Road{5, 8});
+        return graph;
+    }
+
+    constexpr cgrapht::SpmvStrategy STRATEGIES[] {cgrapht::SpmvStrategy::PUSH, cgrapht::SpmvStrategy::PULL, cgrapht::SpmvStrategy::AUTO};
+}
+
+SCENARIO("Semiring products over the adjacency matrix") {
+
+    GIVEN("I have a weighted frozen graph") {
+
+        const auto roads {make_roads()};
+        const cgrapht::FrozenGraph frozen {roads};
+        const auto weights {cgrapht::AdjacencyMatrix<int>::weighted(frozen, roads, [](const Road& road) { return road.length; }).consume_ok()};
+        using S = cgrapht::MinPlus<int>;
+
+        WHEN("I relax the edges leaving vertex 0 with vxm") {
+
+            THEN("Push and pull should agree") {
+
+                for (const auto strategy : STRATEGIES) {
+                    auto w = cgrapht::vxm(cgrapht::GraphVector<S>::sparse(5, {{0, 0}}), weights, {.strategy = strategy, .threads = 3});
+                    REQUIRE(w.is_ok());
+                    if (strategy != cgrapht::SpmvStrategy::AUTO) {
+                        REQUIRE(w.get_ok().is_dense() == (strategy == cgrapht::SpmvStrategy::PULL));
+                    }
+                    REQUIRE(w.get_ok().get(1) == 4);
+                    REQUIRE(w.get_ok().get(2) == 1);
+                    REQUIRE(w.get_ok().get(3) == S::zero());
+                    REQUIRE(w.get_ok().nnz() == 2);
+                }
+            }
+        }
+
+        WHEN("I gather from the children with mxv") {
+
+            THEN("Each vertex should see its cheapest child plus edge") {
+
+                for (const auto strategy : STRATEGIES) {
+                    auto w = cgrapht::mxv(weights, cgrapht::GraphVector<S>::dense({0, 10, 20, 30, 40}), {.strategy = strategy});
+                    REQUIRE(w.get_ok().get(0) == 14);
+                    REQUIRE(w.get_ok().get(1) == 35);
+                    REQUIRE(w.get_ok().get(2) == 12);
+                    REQUIRE(w.get_ok().get(3) == S::zero());
+                }
+            }
+        }
+
+        WHEN("I mask the outputs") {
+
+            const std::vector<std::uint8_t> mask {0, 1, 0, 0, 0};
+
+            THEN("Only the selected outputs should be computed") {
+
+                for (const auto strategy : STRATEGIES) {
+                    auto kept = cgrapht::vxm(cgrapht::GraphVector<S>::sparse(5, {{0, 0}}), weights, {.strategy = strategy, .mask = mask});
+                    REQUIRE(kept.get_ok().nnz() == 1);
+                    REQUIRE(kept.get_ok().get(1) == 4);
+
+                    auto dropped = cgrapht::vxm(cgrapht::GraphVector<S>::sparse(5, {{0, 0}}), weights, {.strategy = strategy, .mask = mask, .complement_mask = true});
+                    REQUIRE(dropped.get_ok().nnz() == 1);
+                    REQUIRE(dropped.get_ok().get(2) == 1);
+                }
+            }
+        }
+
+        WHEN("I pass a vector of the wrong size") {
+
+            THEN("The product should be rejected") {
+
+                REQUIRE(cgrapht::vxm(cgrapht::GraphVector<S>::sparse(4), weights).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+
+        WHEN("I compute shortest paths from vertex 0") {
+
+            THEN("Every strategy should find the same distances") {
+
+                for (const auto strategy : STRATEGIES) {
+                    auto distances = cgrapht::sssp(weights, 0, {.strategy = strategy});
+                    REQUIRE(distances.is_ok());
+                    REQUIRE(distances.get_ok() == std::vector<int>{0, 3, 1, 8, S::zero()});
+                }
+                REQUIRE(cgrapht::sssp(weights, 99).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+    }
+
+    GIVEN("I have graphs with negative weights") {
+
+        auto roads {make_roads()};
+        roads.add_edge(3, 2, Road{6, -4});
+
+        THEN("A negative edge without a negative cycle should be handled") {
+
+            const cgrapht::FrozenGraph frozen {roads};
+            const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, roads, [](const Road& road) { return road.length; }).consume_ok()};
+            REQUIRE(cgrapht::sssp(weights, 0).get_ok()[2] == 1.0);
+        }
+
+        AND_WHEN("The weights close a negative cycle") {
+
+            roads.add_edge(1, 2, Road{7, -3});
+            const cgrapht::FrozenGraph frozen {roads};
+            const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, roads, [](const Road& road) { return road.length; }).consume_ok()};
+
+            THEN("It should be detected") {
+
+                REQUIRE(cgrapht::sssp(weights, 0).get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+            }
+        }
+    }
+}
+
+SCENARIO("Algorithms on the semiring kernel") {
+
+    GIVEN("I have a frozen graph with a long chain and a wide fan") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> graph {};
+        std::size_t edge {0};
+        for (int i {0}; i < 3000; ++i) {
+            graph.add_vertex(i);
+        }
+        for (std::size_t i {1}; i < 2000; ++i) {
+            graph.add_edge(0, i, cgrapht::DefaultEdge{edge++});
+        }
+        for (std::size_t i {2000}; i + 1 < 3000; ++i) {
+            graph.add_edge(i, i + 1, cgrapht::DefaultEdge{edge++});
+        }
+        graph.add_edge(1999, 2000, cgrapht::DefaultEdge{edge++});
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("I compute BFS levels from vertex 0") {
+
+            THEN("Every strategy should match the expected levels") {
+
+                for (const auto strategy : STRATEGIES) {
+                    cgrapht::ChromeTraceWriter trace {};
+                    auto levels = cgrapht::bfs_levels(frozen, 0, {.strategy = strategy, .threads = 4}, trace);
+                    REQUIRE(levels.is_ok());
+                    REQUIRE(levels.get_ok()[0] == 0);
+                    REQUIRE(levels.get_ok()[1999] == 1);
+                    REQUIRE(levels.get_ok()[2999] == 1001);
+                    REQUIRE(trace.get_events().size() == 3 * 1002);
+                }
+                REQUIRE(cgrapht::bfs_levels(frozen, 2500).get_ok()[0] == cgrapht::UNREACHED_LEVEL);
+            }
+        }
+
+        WHEN("I compute PageRank") {
+
+            cgrapht::ChromeTraceWriter trace {};
+            auto ranks = cgrapht::pagerank(frozen, {.threads = 2}, trace);
+            REQUIRE(ranks.is_ok());
+
+            THEN("The ranks should be a distribution increasing down the chain") {
+
+                const auto& r {ranks.get_ok()};
+                REQUIRE(std::abs(std::accumulate(r.begin(), r.end(), 0.0) - 1.0) < 1e-9);
+                REQUIRE(r[2000] > r[1]);
+                REQUIRE(r[2005] > r[2000]);
+                REQUIRE(trace.get_events().back().name == "pagerank.iteration");
+            }
+        }
+    }
+
+    GIVEN("I have a directed cycle") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> graph {};
+        for (int i {0}; i < 4; ++i) {
+            graph.add_vertex(i);
+        }
+        for (int i {0}; i < 4; ++i) {
+            graph.add_edge(static_cast<std::size_t>(i), static_cast<std::size_t>((i + 1) % 4), cgrapht::DefaultEdge{static_cast<std::size_t>(i)});
+        }
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("PageRank should be uniform") {
+
+            const auto ranks {cgrapht::pagerank(frozen).consume_ok()};
+            for (const double rank : ranks) {
+                REQUIRE(std::abs(rank - 0.25) < 1e-12);
+            }
+            REQUIRE(cgrapht::pagerank(frozen, {.damping = 1.5}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#define CATCH_CONFIG_MAIN
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/metrics.hpp"
+
+SCENARIO("Latency buckets") {
+
+    GIVEN("The log linear bucketing") {
+
+        THEN("Every value should fall into the bucket whose bounds enclose it") {
+
+            for (std::uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull, 123456789ull, 1ull << 40}) {
+                const std::size_t bucket {cgrapht::detail::latency_bucket(v)};
+                REQUIRE(cgrapht::OperationStats::bucket_lower_bound(bucket) <= v);
+                REQUIRE(cgrapht::OperationStats::bucket_lower_bound(bucket + 1) > v);
+            }
+            REQUIRE(cgrapht::detail::latency_bucket(~std::uint64_t{0}) == cgrapht::detail::LATENCY_BUCKETS - 1);
+        }
+    }
+}
+
+SCENARIO("Recording graph operation metrics") {
+
+    GIVEN("I have a graph with operation metrics") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge, cgrapht::OperationMetrics> my_graph {};
+
+        WHEN("I run a mix of successful and failing operations") {
+
+            const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+            const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+            my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+            my_graph.add_edge(v2, v1, cgrapht::DefaultEdge{12});
+            my_graph.add_edge(v1, 1000, cgrapht::DefaultEdge{13});
+            my_graph.get_vertex(v1);
+            my_graph.get_vertex(1000);
+            my_graph.get_children(v1);
+
+            const cgrapht::MetricsSnapshot snapshot {my_graph.get_observer().snapshot()};
+
+            THEN("Calls and errors should be counted per operation") {
+
+                REQUIRE(snapshot[cgrapht::GraphOperation::ADD_VERTEX].count == 2);
+                REQUIRE(snapshot[cgrapht::GraphOperation::ADD_EDGE].count == 3);
+                REQUIRE(snapshot[cgrapht::GraphOperation::ADD_EDGE].error_count(cgrapht::ErrorType::EDGE_ALREADY_EXISTS) == 1);
+                REQUIRE(snapshot[cgrapht::GraphOperation::ADD_EDGE].error_count(cgrapht::ErrorType::ABSENT_VERTEX) == 1);
+                REQUIRE(snapshot[cgrapht::GraphOperation::GET_VERTEX].count == 2);
+                REQUIRE(snapshot[cgrapht::GraphOperation::GET_VERTEX].error_count(cgrapht::ErrorType::ABSENT_VERTEX) == 1);
+                REQUIRE(snapshot[cgrapht::GraphOperation::GET_CHILDREN].count == 1);
+                REQUIRE(snapshot[cgrapht::GraphOperation::DELETE_EDGE].count == 0);
+            }
+
+            THEN("Every call should land in the latency histogram") {
+
+                const cgrapht::OperationStats& stats {snapshot[cgrapht::GraphOperation::ADD_EDGE]};
+                std::uint64_t recorded {0};
+                for (const std::uint64_t bucket : stats.latency) {
+                    recorded += bucket;
+                }
+                REQUIRE(recorded == 3);
+                REQUIRE(stats.latency_quantile(1.0) >= stats.latency_quantile(0.5));
+            }
+
+            THEN("The Prometheus export should contain counters and histograms") {
+
+                const std::string text {cgrapht::to_prometheus(snapshot)};
+                REQUIRE(text.find("cgrapht_operations_total{operation=\"add_edge\"} 3\n") != std::string::npos);
+                REQUIRE(text.find("cgrapht_operation_errors_total{operation=\"add_edge\",error=\"EDGE_ALREADY_EXISTS\"} 1\n") != std::string::npos);
+                REQUIRE(text.find("cgrapht_operation_latency_seconds_bucket{operation=\"add_edge\",le=\"+Inf\"} 3\n") != std::string::npos);
+                REQUIRE(text.find("cgrapht_operation_latency_seconds_count{operation=\"get_vertex\"} 2\n") != std::string::npos);
+                REQUIRE(text.find("operation=\"delete_edge\"") == std::string::npos);
+            }
+        }
+
+        WHEN("Several threads read the graph concurrently") {
+
+            const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+            std::vector<std::thread> threads {};
+            for (int t {0}; t < 4; ++t) {
+                threads.emplace_back([&] {
+                    for (int i {0}; i < 1000; ++i) {
+                        my_graph.get_vertex(v1);
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            THEN("The per thread counts should be merged") {
+
+                REQUIRE(my_graph.get_observer().snapshot()[cgrapht::GraphOperation::GET_VERTEX].count == 4000);
+            }
+
+            THEN("The Prometheus histogram should always have the full list of distinct, increasing bounds") {
+
+                const std::string text {cgrapht::to_prometheus(my_graph.get_observer().snapshot())};
+                const std::string prefix {"cgrapht_operation_latency_seconds_bucket{operation=\"get_vertex\",le=\""};
+                std::vector<std::string> bounds {};
+                for (std::size_t at {text.find(prefix)}; at != std::string::npos; at = text.find(prefix, at + 1)) {
+                    const std::size_t begin {at + prefix.size()};
+                    bounds.push_back(text.substr(begin, text.find('"', begin) - begin));
+                }
+                REQUIRE(bounds.size() == 38);
+                REQUIRE(bounds.back() == "+Inf");
+                REQUIRE(std::stod(bounds.front()) == 15e-9);
+                REQUIRE(std::stod(bounds[36]) == static_cast<double>((1ull << 40) - 1) / 1e9);
+                for (std::size_t i {1}; i + 1 < bounds.size(); ++i) {
+                    REQUIRE(std::stod(bounds[i]) > std::stod(bounds[i - 1]));
+                }
+            }
+        }
+
+        WHEN("I copy the graph") {
+
+            auto copy {my_graph};
+            copy.add_vertex(7);
+
+            THEN("The copy should report into the same metrics") {
+
+                REQUIRE(my_graph.get_observer().snapshot()[cgrapht::GraphOperation::ADD_VERTEX].count == 1);
+            }
+        }
+
+        WHEN("A thread alternates between it and many short lived graphs") {
+
+            for (int i {0}; i < 1000; ++i) {
+                cgrapht::DirectedGraph<int, cgrapht::DefaultEdge, cgrapht::OperationMetrics> other {};
+                other.add_vertex(i);
+                my_graph.add_vertex(i);
+                REQUIRE(other.get_observer().snapshot()[cgrapht::GraphOperation::ADD_VERTEX].count == 1);
+            }
+
+            THEN("Every graph should keep its own counts") {
+
+                REQUIRE(my_graph.get_observer().snapshot()[cgrapht::GraphOperation::ADD_VERTEX].count == 1000);
+            }
+        }
+    }
+}
+
+SCENARIO("Prometheus histogram counts at bucket bounds") {
+
+    GIVEN("A snapshot with latencies right below, at and above a power of two") {
+
+        cgrapht::MetricsSnapshot snapshot {};
+        auto& stats {snapshot.operations[static_cast<std::size_t>(cgrapht::GraphOperation::GET_EDGE)]};
+        for (const std::uint64_t nanoseconds : {15ull, 16ull, 31ull, 32ull}) {
+            ++stats.latency[cgrapht::detail::latency_bucket(nanoseconds)];
+            ++stats.count;
+            stats.total_nanoseconds += nanoseconds;
+        }
+
+        THEN("Every le count should include exactly the latencies up to the bound") {
+
+            const std::string text {cgrapht::to_prometheus(snapshot)};
+            const std::string series {"cgrapht_operation_latency_seconds_bucket{operation=\"get_edge\",le=\""};
+            REQUIRE(text.find(series + "1.5e-08\"} 1\n") != std::string::npos);
+            REQUIRE(text.find(series + "3.1e-08\"} 3\n") != std::string::npos);
+            REQUIRE(text.find(series + "6.3e-08\"} 4\n") != std::string::npos);
+            REQUIRE(text.find(series + "1099.511627775\"} 4\n") != std::string::npos);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/multi_source_bfs.hpp"
+#include "cgrapht/default_edge.hpp"
+
+namespace {
+    std::vector<std::uint32_t> reference_bfs(const cgrapht::FrozenGraph& graph, const std::size_t source, const std::size_t max_depth) {
+        std::vector<std::uint32_t> distance(graph.vertex_count(), cgrapht::MultiSourceDistances::UNREACHED);
+        std::deque<std::size_t> queue {source};
+        distance[source] = 0;
+        while (!queue.empty()) {
+            const std::size_t v {queue.front()};
+            queue.pop_front();
+            if (distance[v] == max_depth) {
+                continue;
+            }
+            for (const std::size_t child : graph.children(v)) {
+                if (distance[child] == cgrapht::MultiSourceDistances::UNREACHED) {
+                    distance[child] = distance[v] + 1;
+                    queue.push_back(child);
+                }
+            }
+        }
+        return distance;
+    }
+}
+
+SCENARIO("Multi source BFS") {
+
+    GIVEN("I have a chain 1 -> 2 -> 3 and an isolated vertex 4") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        const std::size_t v3 {my_graph.add_vertex(3).get_ok()};
+        const std::size_t v4 {my_graph.add_vertex(4).get_ok()};
+        my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{1});
+        my_graph.add_edge(v2, v3, cgrapht::DefaultEdge{2});
+        const cgrapht::FrozenGraph frozen {my_graph};
+
+        WHEN("I run a BFS from 1 and 4") {
+
+            const std::vector<std::size_t> sources {v1, v4};
+            auto result = cgrapht::multi_source_bfs(frozen, sources);
+
+            THEN("I should get hop distances per source") {
+
+                REQUIRE(result.is_ok());
+                const auto& distances {result.get_ok()};
+                REQUIRE(distances.source_count() == 2);
+                REQUIRE(distances.distance(0, frozen.index_of(v1).get_ok()) == 0);
+                REQUIRE(distances.distance(0, frozen.index_of(v2).get_ok()) == 1);
+                REQUIRE(distances.distance(0, frozen.index_of(v3).get_ok()) == 2);
+                REQUIRE(distances.distance(0, frozen.index_of(v4).get_ok()) == cgrapht::MultiSourceDistances::UNREACHED);
+                REQUIRE(distances.distance(1, frozen.index_of(v4).get_ok()) == 0);
+                REQUIRE(distances.distance(1, frozen.index_of(v1).get_ok()) == cgrapht::MultiSourceDistances::UNREACHED);
+            }
+        }
+
+        WHEN("I limit the depth to one hop") {
+
+            const std::vector<std::size_t> sources {v1};
+            auto result = cgrapht::multi_source_bfs(frozen, sources, 1);
+
+            THEN("Vertices further away should be unreached") {
+
+                REQUIRE(result.get_ok().distance(0, frozen.index_of(v2).get_ok()) == 1);
+                REQUIRE(result.get_ok().distance(0, frozen.index_of(v3).get_ok()) == cgrapht::MultiSourceDistances::UNREACHED);
+            }
+        }
+
+        WHEN("I pass a source that does not exist") {
+
+            const std::vector<std::size_t> sources {v1, 1000};
+            auto result = cgrapht::multi_source_bfs(frozen, sources);
+
+            THEN("I should get an error") {
+
+                REQUIRE(!result.is_ok());
+                REQUIRE(result.get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+    }
+
+    GIVEN("I have a random graph and more sources than fit in one batch") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        std::vector<std::size_t> ids {};
+        for (int i {0}; i < 300; ++i) {
+            ids.push_back(my_graph.add_vertex(i).get_ok());
+        }
+        std::mt19937 rng {7};
+        std::uniform_int_distribution<std::size_t> pick {0, ids.size() - 1};
+        for (std::size_t e {0}; e < 900; ++e) {
+            my_graph.add_edge(ids[pick(rng)], ids[pick(rng)], cgrapht::DefaultEdge{e});
+        }
+        const cgrapht::FrozenGraph frozen {my_graph};
+
+        std::vector<std::size_t> sources {};
+        for (std::size_t s {0}; s < 150; ++s) {
+            sources.push_back(ids[pick(rng)]);
+        }
+
+        WHEN("I run 64 and 256 lane MS-BFS") {
+
+            auto narrow = cgrapht::multi_source_bfs<64>(frozen, sources);
+            auto wide = cgrapht::multi_source_bfs<256>(frozen, sources, 3);
+
+            THEN("Every row should match an independent BFS") {
+
+                REQUIRE(narrow.is_ok());
+                REQUIRE(wide.is_ok());
+                for (std::size_t s {0}; s < sources.size(); ++s) {
+                    const std::size_t source {frozen.index_of(sources[s]).get_ok()};
+                    const auto full {reference_bfs(frozen, source, std::numeric_limits<std::size_t>::max())};
+                    const auto bounded {reference_bfs(frozen, source, 3)};
+                    REQUIRE(std::ranges::equal(narrow.get_ok().row(s), full));
+                    REQUIRE(std::ranges::equal(wide.get_ok().row(s), bounded));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#define CATCH_CONFIG_MAIN
+
+#include <unordered_map>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/observers.hpp"
+
+namespace {
+    struct EdgeCounter {
+        int added {0};
+        int deleted {0};
+
+        void on_edge_added(std::size_t, std::size_t, std::size_t) {
+            ++added;
+        }
+
+        void on_edge_deleted(std::size_t, std::size_t, std::size_t) {
+            ++deleted;
+        }
+    };
+
+    struct RecordingListener final : cgrapht::GraphListener {
+        std::vector<std::size_t> added_vertices {};
+
+        void on_vertex_added(const std::size_t vertex_id) override {
+            added_vertices.push_back(vertex_id);
+        }
+    };
+
+    static_assert(sizeof(cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>) == sizeof(cgrapht::DirectedGraph<int, cgrapht::DefaultEdge, cgrapht::NoObserver>));
+    static_assert(sizeof(cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>) == 3 * sizeof(std::unordered_map<std::size_t, int>));
+}
+
+SCENARIO("Observing graph mutations") {
+
+    GIVEN("I have a graph with a batching observer") {
+
+        std::vector<std::vector<cgrapht::GraphEvent>> batches {};
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge, cgrapht::BatchingObserver> my_graph {
+            cgrapht::BatchingObserver{[&](std::span<const cgrapht::GraphEvent> batch) { batches.emplace_back(batch.begin(), batch.end()); }, 3}
+        };
+
+        WHEN("I mutate the graph") {
+
+            const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+            const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+            my_graph.add_vertex(2);
+            const std::size_t e12 {my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12}).get_ok()};
+            my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+            my_graph.add_edge(v2, 1000, cgrapht::DefaultEdge{13});
+            my_graph.delete_edge(e12);
+            my_graph.delete_vertex(v2);
+            my_graph.delete_vertex(v2);
+
+            THEN("Only effective mutations should be recorded, delivered in full batches") {
+
+                REQUIRE(batches.size() == 1);
+                REQUIRE(batches[0] == std::vector<cgrapht::GraphEvent>{
+                    {cgrapht::GraphEventType::VERTEX_ADDED, v1, v1, v1},
+                    {cgrapht::GraphEventType::VERTEX_ADDED, v2, v2, v2},
+                    {cgrapht::GraphEventType::EDGE_ADDED, e12, v1, v2},
+                });
+                REQUIRE(my_graph.get_observer().pending_events().size() == 2);
+
+                AND_WHEN("I flush") {
+
+                    my_graph.get_observer().flush();
+
+                    THEN("The rest should be delivered") {
+
+                        REQUIRE(batches.size() == 2);
+                        REQUIRE(batches[1] == std::vector<cgrapht::GraphEvent>{
+                            {cgrapht::GraphEventType::EDGE_DELETED, e12, v1, v2},
+                            {cgrapht::GraphEventType::VERTEX_DELETED, v2, v2, v2},
+                        });
+                        REQUIRE(my_graph.get_observer().pending_events().empty());
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a graph with a chain of a partial policy and a listener registry") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge, cgrapht::ObserverChain<EdgeCounter, cgrapht::ListenerRegistry>> my_graph;
+        RecordingListener listener {};
+        my_graph.get_observer().get<1>().add_listener(listener);
+
+        WHEN("I add vertices and edges") {
+
+            const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+            const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+            my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+            my_graph.get_observer().get<1>().remove_listener(listener);
+            my_graph.add_vertex(3);
+
+            THEN("Each member should see the events it declares, while registered") {
+
+                REQUIRE(my_graph.get_observer().get<0>().added == 1);
+                REQUIRE(my_graph.get_observer().get<0>().deleted == 0);
+                REQUIRE(listener.added_vertices == std::vector<std::size_t>{v1, v2});
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#define CATCH_CONFIG_MAIN
+
+#include <random>
+#include <set>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/partitioning.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace {
+    using Graph = cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>;
+
+    // `blocks` planted clusters with random members; most edges stay inside a cluster.
+    Graph make_clustered(const std::size_t vertices, const std::size_t blocks, const std::size_t edges, const unsigned seed) {
+        Graph graph {};
+        for (std::size_t v {0}; v < vertices; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        std::mt19937 rng {seed};
+        std::vector<std::vector<std::size_t>> members(blocks);
+        for (std::size_t v {0}; v < vertices; ++v) {
+            members[std::uniform_int_distribution<std::size_t>{0, blocks - 1}(rng)].push_back(v);
+        }
+        std::uniform_int_distribution<std::size_t> pick_block {0, blocks - 1};
+        std::uniform_int_distribution<std::size_t> pick_vertex {0, vertices - 1};
+        std::bernoulli_distribution across {0.03};
+        for (std::size_t e {0}; e < edges; ++e) {
+            if (across(rng)) {
+                graph.add_edge(pick_vertex(rng), pick_vertex(rng), cgrapht::DefaultEdge{e});
+            } else {
+                const auto& block {members[pick_block(rng)]};
+                std::uniform_int_distribution<std::size_t> pick {0, block.size() - 1};
+                graph.add_edge(block[pick(rng)], block[pick(rng)], cgrapht::DefaultEdge{e});
+            }
+        }
+        return graph;
+    }
+
+    void require_consistent(const cgrapht::FrozenGraph& frozen, const cgrapht::Partitioning& partitioning, const double max_imbalance) {
+        const auto expected {cgrapht::evaluate_partitioning(frozen, partitioning.parts, partitioning.count).consume_ok()};
+        REQUIRE(partitioning.sizes == expected.sizes);
+        REQUIRE(partitioning.cut_edges == expected.cut_edges);
+        REQUIRE(partitioning.imbalance == expected.imbalance);
+        const std::size_t n {frozen.vertex_count()};
+        const std::size_t k {partitioning.count};
+        for (const std::size_t size : partitioning.sizes) {
+            REQUIRE(size <= std::max((n + k - 1) / k, static_cast<std::size_t>(max_imbalance * static_cast<double>(n) / static_cast<double>(k))));
+        }
+    }
+}
+
+SCENARIO("Partitioners keep clusters together within the balance bound") {
+    GIVEN("A graph with four planted clusters") {
+        const Graph graph {make_clustered(2000, 4, 16000, 1)};
+        const cgrapht::FrozenGraph frozen {graph};
+        // A random assignment cuts about three quarters of the edges.
+        const std::size_t random_cut {frozen.edge_count() * 3 / 4};
+
+        THEN("Both streaming heuristics cut far fewer edges than a random assignment") {
+            for (const auto heuristic : {cgrapht::StreamingHeuristic::LDG, cgrapht::StreamingHeuristic::FENNEL}) {
+                const auto partitioning {cgrapht::streaming_partition(frozen, {.parts = 4, .heuristic = heuristic, .max_imbalance = 1.1}).consume_ok()};
+                require_consistent(frozen, partitioning, 1.1);
+                REQUIRE(partitioning.cut_edges < random_cut / 2);
+            }
+        }
+
+        THEN("The multilevel partitioner nearly recovers the clusters") {
+            for (const std::size_t threads : {1, 4}) {
+                const auto partitioning {cgrapht::multilevel_partition(frozen, {.parts = 4, .threads = threads}).consume_ok()};
+                require_consistent(frozen, partitioning, 1.03);
+                REQUIRE(partitioning.cut_edges < random_cut / 10);
+            }
+        }
+    }
+
+    GIVEN("Invalid arguments") {
+        const Graph graph {make_clustered(20, 2, 40, 2)};
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("They are rejected") {
+            REQUIRE(cgrapht::streaming_partition(frozen, {.parts = 0}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::streaming_partition(frozen, {.max_imbalance = 0.9}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::streaming_partition(frozen, {.gamma = 1.0}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::multilevel_partition(frozen, {.parts = 0}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            const std::vector<std::size_t> out_of_range(20, 2);
+            REQUIRE(cgrapht::evaluate_partitioning(frozen, out_of_range, 2).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+}
+
+SCENARIO("A partitioned graph exposes owned and ghost vertices per part") {
+    GIVEN("A multilevel partitioning into three parts") {
+        const Graph graph {make_clustered(600, 3, 3000, 3)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto partitioning {cgrapht::multilevel_partition(frozen, {.parts = 3, .threads = 1}).consume_ok()};
+        const auto view {cgrapht::PartitionedGraph::build(frozen, partitioning, 4).consume_ok()};
+
+        THEN("Every vertex is owned once and local adjacency maps back to the frozen graph") {
+            REQUIRE(view.partition_count() == 3);
+            std::size_t owned {0};
+            std::size_t edges_to_ghosts {0};
+            for (std::size_t p {0}; p < 3; ++p) {
+                const auto& part {view.partition(p)};
+                REQUIRE(part.part() == p);
+                REQUIRE(part.owned_count() == partitioning.sizes[p]);
+                owned += part.owned_count();
+
+                std::set<std::size_t> expected_ghosts {};
+                for (std::size_t local {0}; local < part.owned_count(); ++local) {
+                    const std::size_t v {part.global_index(local)};
+                    REQUIRE(view.owner(v) == p);
+                    REQUIRE(part.local_index(v).get_ok() == local);
+                    const auto children {frozen.children(v)};
+                    REQUIRE(part.children(local).size() == children.size());
+                    for (std::size_t slot {0}; slot < children.size(); ++slot) {
+                        const std::size_t child {part.children(local)[slot]};
+                        REQUIRE(part.global_index(child) == children[slot]);
+                        REQUIRE(part.outgoing_edges(local)[slot] == frozen.outgoing_edges(v)[slot]);
+                        REQUIRE(part.owner(child) == view.owner(children[slot]));
+                        edges_to_ghosts += part.is_ghost(child) ? 1 : 0;
+                    }
+                    const auto parents {frozen.parents(v)};
+                    REQUIRE(part.parents(local).size() == parents.size());
+                    for (std::size_t slot {0}; slot < parents.size(); ++slot) {
+                        REQUIRE(part.global_index(part.parents(local)[slot]) == parents[slot]);
+                    }
+                    for (const auto adjacent : {children, parents}) {
+                        for (const std::size_t u : adjacent) {
+                            if (view.owner(u) != p) {
+                                expected_ghosts.insert(u);
+                            }
+                        }
+                    }
+                }
+
+                REQUIRE(part.ghost_count() == expected_ghosts.size());
+                for (std::size_t local {part.owned_count()}; local < part.vertex_count(); ++local) {
+                    REQUIRE(part.is_ghost(local));
+                    REQUIRE(expected_ghosts.contains(part.global_index(local)));
+                    REQUIRE(part.children(local).empty());
+                    REQUIRE(part.owner(local) != p);
+                }
+            }
+            REQUIRE(owned == frozen.vertex_count());
+            REQUIRE(edges_to_ghosts == partitioning.cut_edges);
+        }
+    }
+}
@@ -0,0 +1,196 @@
+#define CATCH_CONFIG_MAIN
+
+#include <mutex>
+#include <sstream>
+#include <span>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/random_walk.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/semiring.hpp"
+
+namespace {
+    struct Trail {
+        std::size_t id;
+        double weight;
+
+        bool operator==(const Trail&) const = default;
+    };
+}
+
+template <>
+struct std::hash<Trail> {
+    std::size_t operator()(const Trail& trail) const noexcept {
+        return trail.id;
+    }
+};
+
+namespace {
+    using Graph = cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>;
+
+    Graph make_graph(const std::size_t vertices, const std::vector<std::pair<std::size_t, std::size_t>>& edges) {
+        Graph graph {};
+        for (std::size_t v {0}; v < vertices; ++v) {
+            graph.add_vertex(static_cast<int>(v));
+        }
+        std::size_t id {0};
+        for (const auto& [from, to] : edges) {
+            graph.add_edge(from, to, cgrapht::DefaultEdge{id++});
+        }
+        return graph;
+    }
+
+    std::vector<std::size_t> collect(const cgrapht::RandomWalker& walker, const cgrapht::WalkOptions& options) {
+        std::vector<std::size_t> walks(walker.walk_count(options) * (options.length + 1));
+        walker.walk(options, [&](const std::size_t first_walk, const std::span<const std::size_t> batch) {
+            std::ranges::copy(batch, walks.begin() + static_cast<std::ptrdiff_t>(first_walk * (options.length + 1)));
+        });
+        return walks;
+    }
+}
+
+SCENARIO("Uniform walks follow edges") {
+    GIVEN("A cycle with a tail ending in a vertex without outgoing edges") {
+        Graph graph {make_graph(6, {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}})};
+        const cgrapht::FrozenGraph frozen {graph};
+        const cgrapht::RandomWalker walker {cgrapht::RandomWalker::uniform(frozen)};
+        const cgrapht::WalkOptions options {.length = 12, .walks_per_vertex = 7, .batch_size = 5};
+
+        WHEN("Walks are generated from every vertex") {
+            const std::vector<std::size_t> walks {collect(walker, options)};
+
+            THEN("Every step is an edge and walks stop only at the sink") {
+                REQUIRE(walks.size() == 6 * 7 * 13);
+                for (std::size_t w {0}; w < 42; ++w) {
+                    const std::span<const std::size_t> walk {walks.data() + w * 13, 13};
+                    REQUIRE(walk[0] == frozen.vertex_id(w % 6));
+                    for (std::size_t s {1}; s < 13; ++s) {
+                        if (walk[s] == cgrapht::WALK_END) {
+                            REQUIRE((walk[s - 1] == 5 || walk[s - 1] == cgrapht::WALK_END));
+                            continue;
+                        }
+                        REQUIRE(walk[s - 1] != cgrapht::WALK_END);
+                        REQUIRE(graph.get_children(walk[s - 1]).get_ok().contains(walk[s]));
+                    }
+                }
+            }
+
+            THEN("The walks do not depend on the number of workers") {
+                cgrapht::WalkOptions sequential {options};
+                sequential.threads = 1;
+                cgrapht::WalkOptions parallel {options};
+                parallel.threads = 4;
+                REQUIRE(collect(walker, sequential) == collect(walker, parallel));
+                REQUIRE(collect(walker, parallel) == walks);
+            }
+        }
+
+        WHEN("Walks are written to a stream") {
+            std::ostringstream out {};
+            cgrapht::WalkStreamWriter writer {out, options};
+            const std::size_t starts[] {3};
+            auto count = walker.walk(starts, options, writer);
+
+            THEN("Every walk is one line, without padding") {
+                REQUIRE(count.get_ok() == 7);
+                std::size_t lines {0};
+                std::istringstream in {out.str()};
+                for (std::string line {}; std::getline(in, line); ++lines) {
+                    REQUIRE(line == "3 4 5");
+                }
+                REQUIRE(lines == 7);
+            }
+        }
+
+        WHEN("Options are invalid") {
+            const std::size_t absent[] {42};
+            cgrapht::WalkOptions backwards {options};
+            backwards.return_parameter = 0;
+
+            THEN("They are rejected") {
+                REQUIRE(walker.walk(absent, options, [](std::size_t, std::span<const std::size_t>) {}).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+                REQUIRE(walker.walk(backwards, [](std::size_t, std::span<const std::size_t>) {}).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+    }
+}
+
+SCENARIO("Weighted walks pick edges proportionally to their weight") {
+    GIVEN("A vertex with three weighted outgoing edges") {
+        cgrapht::DirectedGraph<int, Trail> graph {};
+        for (int v {0}; v < 4; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 1, Trail{0, 1.0});
+        graph.add_edge(0, 2, Trail{1, 3.0});
+        graph.add_edge(0, 3, Trail{2, 0.0});
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto weights {cgrapht::AdjacencyMatrix<double>::weighted(frozen, graph, [](const Trail& trail) { return trail.weight; }).consume_ok()};
+
+        WHEN("Many one step walks leave it") {
+            const cgrapht::RandomWalker walker {cgrapht::RandomWalker::weighted(weights).consume_ok()};
+            const std::size_t starts[] {0};
+            std::mutex mutex {};
+            std::size_t hits[4] {};
+            walker.walk(starts, {.length = 1, .walks_per_vertex = 40000}, [&](std::size_t, const std::span<const std::size_t> batch) {
+                const std::scoped_lock lock {mutex};
+                for (std::size_t i {1}; i < batch.size(); i += 2) {
+                    ++hits[batch[i]];
+                }
+            });
+
+            THEN("The frequencies follow the weights") {
+                REQUIRE(hits[3] == 0);
+                REQUIRE(hits[1] + hits[2] == 40000);
+                REQUIRE(hits[2] > 2 * hits[1]);
+                REQUIRE(hits[2] < 4 * hits[1]);
+            }
+        }
+
+        WHEN("A weight is negative") {
+            graph.add_edge(1, 2, Trail{3, -1.0});
+            const cgrapht::FrozenGraph negative {graph};
+            const auto bad {cgrapht::AdjacencyMatrix<double>::weighted(negative, graph, [](const Trail& trail) { return trail.weight; }).consume_ok()};
+
+            THEN("The walker is not built") {
+                REQUIRE(cgrapht::RandomWalker::weighted(bad).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+    }
+}
+
+SCENARIO("node2vec parameters bias second order steps") {
+    GIVEN("A bidirectional star with centre 1") {
+        Graph graph {make_graph(4, {{0, 1}, {1, 0}, {1, 2}, {2, 1}, {1, 3}, {3, 1}})};
+        const cgrapht::FrozenGraph frozen {graph};
+        const cgrapht::RandomWalker walker {cgrapht::RandomWalker::uniform(frozen)};
+        const std::size_t starts[] {0};
+
+        auto returns = [&](const double p, const double q) {
+            std::mutex mutex {};
+            std::size_t back {0};
+            walker.walk(starts, {.length = 2, .walks_per_vertex = 20000, .return_parameter = p, .in_out_parameter = q},
+                        [&](std::size_t, const std::span<const std::size_t> batch) {
+                const std::scoped_lock lock {mutex};
+                for (std::size_t i {2}; i < batch.size(); i += 3) {
+                    back += batch[i] == 0;
+                }
+            });
+            return back;
+        };
+
+        WHEN("Walks from a leaf take a second step") {
+            THEN("A small p favours returning and a small q favours moving away") {
+                const std::size_t unbiased {returns(1.0, 1.0)};
+                REQUIRE(unbiased > 5000);
+                REQUIRE(unbiased < 8500);
+                REQUIRE(returns(0.01, 1.0) > 19000);
+                REQUIRE(returns(1.0, 0.01) < 1000);
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#define CATCH_CONFIG_MAIN
+
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/reachability.hpp"
+#include "cgrapht/default_edge.hpp"
+
+namespace {
+    std::vector<char> reachable_from(const cgrapht::FrozenGraph& graph, const std::size_t source) {
+        std::vector<char> seen(graph.vertex_count(), 0);
+        std::vector<std::size_t> stack {source};
+        seen[source] = 1;
+        while (!stack.empty()) {
+            const std::size_t v {stack.back()};
+            stack.pop_back();
+            for (const std::size_t child : graph.children(v)) {
+                if (!seen[child]) {
+                    seen[child] = 1;
+                    stack.push_back(child);
+                }
+            }
+        }
+        return seen;
+    }
+}
+
+SCENARIO("Reachability index") {
+
+    GIVEN("I have a random DAG") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        std::vector<std::size_t> ids {};
+        for (int i {0}; i < 200; ++i) {
+            ids.push_back(my_graph.add_vertex(i).get_ok());
+        }
+        std::mt19937 rng {11};
+        std::uniform_int_distribution<std::size_t> pick {0, ids.size() - 1};
+        for (std::size_t e {0}; e < 350; ++e) {
+            std::size_t a {pick(rng)};
+            std::size_t b {pick(rng)};
+            if (a != b) {
+                my_graph.add_edge(ids[std::min(a, b)], ids[std::max(a, b)], cgrapht::DefaultEdge{e});
+            }
+        }
+
+        WHEN("I build an index") {
+
+            auto result = cgrapht::ReachabilityIndex::build(cgrapht::FrozenGraph{my_graph}, {.labelings = 3, .threads = 2});
+
+            THEN("Every pair should agree with a plain traversal") {
+
+                REQUIRE(result.is_ok());
+                const auto& index {result.get_ok()};
+                const auto& frozen {index.frozen_graph()};
+                REQUIRE(index.labeling_count() == 3);
+                REQUIRE(index.label_bytes() > 0);
+
+                for (std::size_t u {0}; u < frozen.vertex_count(); ++u) {
+                    const auto expected {reachable_from(frozen, u)};
+                    for (std::size_t v {0}; v < frozen.vertex_count(); ++v) {
+                        REQUIRE(index.reachable_index(u, v) == static_cast<bool>(expected[v]));
+                    }
+                }
+            }
+
+            THEN("Queries by vertex id should work and reject unknown ids") {
+
+                const auto& index {result.get_ok()};
+                REQUIRE(index.reachable(ids[0], ids[0]).get_ok());
+                REQUIRE(index.reachable(ids[0], 5000).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+            }
+        }
+    }
+
+    GIVEN("I have a graph with a cycle") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{1});
+        my_graph.add_edge(v2, v1, cgrapht::DefaultEdge{2});
+
+        WHEN("I try to build an index") {
+
+            auto result = cgrapht::ReachabilityIndex::build(cgrapht::FrozenGraph{my_graph});
+
+            THEN("It should be rejected") {
+
+                REQUIRE(!result.is_ok());
+                REQUIRE(result.get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+            }
+        }
+    }
+}
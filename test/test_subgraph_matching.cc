@@ -0,0 +1,216 @@
+#define CATCH_CONFIG_MAIN
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <span>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/subgraph_matching.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+#include "random_graphs.hpp"
+
+namespace {
+    struct Link {
+        std::size_t id;
+        char kind;
+
+        bool operator==(const Link&) const = default;
+    };
+}
+
+template <>
+struct std::hash<Link> {
+    std::size_t operator()(const Link& link) const noexcept {
+        return link.id;
+    }
+};
+
+namespace {
+    using Graph = cgrapht::testing::RandomGraph;
+    using cgrapht::testing::make_random;
+
+    Graph make_pattern(const std::size_t vertices, const std::vector<std::pair<std::size_t, std::size_t>>& edges) {
+        Graph pattern {};
+        for (std::size_t v {0}; v < vertices; ++v) {
+            pattern.add_vertex(static_cast<int>(v));
+        }
+        std::size_t id {0};
+        for (const auto& [from, to] : edges) {
+            pattern.add_edge(from, to, cgrapht::DefaultEdge{id++});
+        }
+        return pattern;
+    }
+}
+
+SCENARIO("Directed triangles are found in every rotation") {
+    GIVEN("Two directed 3-cycles, one triangle that is not a cycle and a pendant edge") {
+        Graph graph {make_pattern(9, {{0, 1}, {1, 2}, {2, 0}, {3, 4}, {4, 5}, {5, 3}, {6, 7}, {7, 8}, {6, 8}, {2, 3}})};
+        const cgrapht::FrozenGraph frozen {graph};
+        const Graph triangle {make_pattern(3, {{0, 1}, {1, 2}, {2, 0}})};
+
+        WHEN("The cycle pattern is matched") {
+            std::mutex mutex {};
+            std::set<std::vector<std::size_t>> found {};
+            auto count = match_subgraph(triangle, graph, frozen, [&](const std::span<const std::size_t> match) {
+                const std::scoped_lock lock {mutex};
+                found.emplace(match.begin(), match.end());
+            });
+
+            THEN("Each cycle is reported once per rotation") {
+                REQUIRE(count.get_ok() == 6);
+                REQUIRE(found.size() == 6);
+                REQUIRE(found.contains({0, 1, 2}));
+                REQUIRE(found.contains({1, 2, 0}));
+                REQUIRE(found.contains({3, 4, 5}));
+                REQUIRE(!found.contains({6, 7, 8}));
+            }
+        }
+    }
+}
+
+SCENARIO("Matching agrees with brute force enumeration") {
+    GIVEN("A random graph and a two edge path pattern") {
+        Graph graph {make_random(60, 400, 7, false)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const Graph path {make_pattern(3, {{0, 1}, {1, 2}})};
+
+        auto has_edge = [&](const std::size_t a, const std::size_t b) {
+            const auto children {frozen.children(a)};
+            return std::binary_search(children.begin(), children.end(), b);
+        };
+        std::size_t injective {0};
+        std::size_t any {0};
+        for (std::size_t x {0}; x < 60; ++x) {
+            for (std::size_t y {0}; y < 60; ++y) {
+                for (std::size_t z {0}; z < 60; ++z) {
+                    if (has_edge(x, y) && has_edge(y, z)) {
+                        ++any;
+                        injective += x != y && y != z && x != z;
+                    }
+                }
+            }
+        }
+
+        WHEN("Both semantics are matched with one and several workers") {
+            auto count = [&](const cgrapht::MatchOptions& options) {
+                std::atomic<std::size_t> calls {0};
+                auto result = match_subgraph(path, graph, frozen, [&](std::span<const std::size_t>) { ++calls; }, options);
+                REQUIRE(result.get_ok() == calls.load());
+                return calls.load();
+            };
+
+            THEN("The counts are the brute force counts") {
+                REQUIRE(injective > 0);
+                REQUIRE(count({.threads = 1}) == injective);
+                REQUIRE(count({.threads = 4}) == injective);
+                REQUIRE(count({.semantics = cgrapht::MatchSemantics::HOMOMORPHISM, .threads = 1}) == any);
+                REQUIRE(count({.semantics = cgrapht::MatchSemantics::HOMOMORPHISM, .threads = 4}) == any);
+                REQUIRE(any > injective);
+            }
+        }
+    }
+}
+
+SCENARIO("Typed vertices and edges restrict matches") {
+    GIVEN("A graph with typed edges and vertex parities") {
+        cgrapht::DirectedGraph<int, Link> graph {};
+        for (int v {0}; v < 6; ++v) {
+            graph.add_vertex(v);
+        }
+        graph.add_edge(0, 1, Link{0, 'a'});
+        graph.add_edge(1, 2, Link{1, 'b'});
+        graph.add_edge(2, 3, Link{2, 'a'});
+        graph.add_edge(3, 4, Link{3, 'b'});
+        graph.add_edge(4, 5, Link{4, 'b'});
+        graph.add_edge(0, 1, Link{5, 'b'});
+        const cgrapht::FrozenGraph frozen {graph};
+
+        cgrapht::DirectedGraph<int, Link> pattern {};
+        pattern.add_vertex(0);
+        pattern.add_vertex(1);
+        pattern.add_vertex(2);
+        pattern.add_edge(0, 1, Link{0, 'a'});
+        pattern.add_edge(1, 2, Link{1, 'b'});
+        auto same_kind = [](const Link& wanted, const Link& actual) { return wanted.kind == actual.kind; };
+
+        WHEN("Edge kinds must agree") {
+            std::vector<std::vector<std::size_t>> found {};
+            auto count = match_subgraph(pattern, graph, frozen, [&](const std::span<const std::size_t> match) {
+                found.emplace_back(match.begin(), match.end());
+            }, {.threads = 1}, cgrapht::AnyMatch{}, same_kind);
+
+            THEN("Only a-then-b paths match, using any of the parallel edges") {
+                REQUIRE(count.get_ok() == 2);
+                REQUIRE(std::ranges::count(found, std::vector<std::size_t>{0, 1, 2}) == 1);
+                REQUIRE(std::ranges::count(found, std::vector<std::size_t>{2, 3, 4}) == 1);
+            }
+        }
+
+        WHEN("The first vertex must also have the parity of its pattern vertex") {
+            auto same_parity = [](const int wanted, const int actual) { return wanted % 2 == actual % 2; };
+            auto count = match_subgraph(pattern, graph, frozen, [](std::span<const std::size_t>) {}, {}, same_parity, same_kind);
+
+            THEN("Both paths still start on an even vertex") {
+                REQUIRE(count.get_ok() == 2);
+            }
+        }
+
+        WHEN("Vertices must equal their pattern vertex") {
+            auto equal = [](const int wanted, const int actual) { return wanted == actual; };
+            auto count = match_subgraph(pattern, graph, frozen, [](std::span<const std::size_t>) {}, {}, equal, same_kind);
+
+            THEN("Only the path at the origin remains") {
+                REQUIRE(count.get_ok() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("Matching stops when the callback asks it to") {
+    GIVEN("A dense random graph and an edge pattern") {
+        Graph graph {make_random(100, 2000, 3, false)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const Graph edge {make_pattern(2, {{0, 1}})};
+
+        WHEN("The callback returns false on the third match") {
+            std::size_t calls {0};
+            auto count = match_subgraph(edge, graph, frozen, [&](std::span<const std::size_t>) { return ++calls < 3; }, {.threads = 1});
+
+            THEN("No further matches are reported") {
+                REQUIRE(calls == 3);
+                REQUIRE(count.get_ok() == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("Self loops and empty patterns") {
+    GIVEN("A graph with one self loop") {
+        Graph graph {make_pattern(3, {{0, 1}, {1, 1}, {1, 2}})};
+        const cgrapht::FrozenGraph frozen {graph};
+
+        WHEN("A looped vertex is matched") {
+            const Graph loop {make_pattern(1, {{0, 0}})};
+            std::vector<std::size_t> found {};
+            auto count = match_subgraph(loop, graph, frozen, [&](const std::span<const std::size_t> match) { found.push_back(match[0]); });
+
+            THEN("Only the looped vertex is reported") {
+                REQUIRE(count.get_ok() == 1);
+                REQUIRE(found == std::vector<std::size_t>{1});
+            }
+        }
+
+        WHEN("The pattern is empty") {
+            auto count = match_subgraph(Graph{}, graph, frozen, [](std::span<const std::size_t>) {});
+
+            THEN("The argument is rejected") {
+                REQUIRE(count.get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+    }
+}
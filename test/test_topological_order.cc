@@ -0,0 +1,156 @@
+#define CATCH_CONFIG_MAIN
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/topological_order.hpp"
+#include "cgrapht/default_edge.hpp"
+
+namespace {
+    template <typename V, typename E>
+    bool is_topological(const cgrapht::DirectedGraph<V, E>& graph, const std::vector<std::size_t>& order) {
+        std::unordered_map<std::size_t, std::size_t> rank {};
+        for (std::size_t i {0}; i < order.size(); ++i) {
+            rank[order[i]] = i;
+        }
+        if (rank.size() != graph.get_vertices().size()) {
+            return false;
+        }
+        for (const auto& edge : graph.get_edges()) {
+            if (rank.at(edge.from_id) >= rank.at(edge.to_id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+SCENARIO("Maintaining a topological order under edge insertion") {
+
+    GIVEN("I wrap a graph that already has a chain 1 -> 2 -> 3") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        const std::size_t v3 {my_graph.add_vertex(3).get_ok()};
+        my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+        my_graph.add_edge(v2, v3, cgrapht::DefaultEdge{23});
+
+        auto created = cgrapht::DynamicTopologicalOrder<int, cgrapht::DefaultEdge>::create(my_graph);
+        REQUIRE(created.is_ok());
+        auto dag {std::move(created).consume_ok()};
+
+        THEN("The initial order should be valid") {
+
+            REQUIRE(is_topological(my_graph, dag.order()));
+            REQUIRE(dag.rank(v1).get_ok() < dag.rank(v3).get_ok());
+        }
+
+        WHEN("I add an edge that closes a cycle") {
+
+            auto result = dag.add_edge(v3, v1, cgrapht::DefaultEdge{31});
+
+            THEN("It should be rejected and the graph left untouched") {
+
+                REQUIRE(result.get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+                REQUIRE(!my_graph.get_edge(31).is_ok());
+                REQUIRE(is_topological(my_graph, dag.order()));
+            }
+        }
+
+        WHEN("I add a self loop") {
+
+            auto result = dag.add_edge(v2, v2, cgrapht::DefaultEdge{22});
+
+            THEN("It should be rejected") {
+
+                REQUIRE(result.get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+            }
+        }
+
+        WHEN("I add a vertex and an edge that points against the current order") {
+
+            const std::size_t v4 {dag.add_vertex(4).get_ok()};
+            auto result = dag.add_edge(v4, v1, cgrapht::DefaultEdge{41});
+
+            THEN("The order should be repaired") {
+
+                REQUIRE(result.is_ok());
+                REQUIRE(is_topological(my_graph, dag.order()));
+                REQUIRE(dag.rank(v4).get_ok() < dag.rank(v1).get_ok());
+            }
+        }
+
+        WHEN("I delete an edge and then add the reverse") {
+
+            REQUIRE(dag.delete_edge(23).is_ok());
+            auto result = dag.add_edge(v3, v2, cgrapht::DefaultEdge{32});
+
+            THEN("The reverse edge should be accepted") {
+
+                REQUIRE(result.is_ok());
+                REQUIRE(is_topological(my_graph, dag.order()));
+            }
+        }
+
+        WHEN("I pass errors through from the graph") {
+
+            THEN("Missing vertices and duplicate edges should be reported as the graph reports them") {
+
+                REQUIRE(dag.add_edge(v1, 1000, cgrapht::DefaultEdge{99}).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+                REQUIRE(dag.add_edge(v1, v3, cgrapht::DefaultEdge{12}).get_error() == cgrapht::ErrorType::EDGE_ALREADY_EXISTS);
+                REQUIRE(dag.delete_vertex(v2).get_error() == cgrapht::ErrorType::VERTEX_NOT_FREE);
+            }
+        }
+    }
+
+    GIVEN("I wrap a graph with a cycle") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        const std::size_t v1 {my_graph.add_vertex(1).get_ok()};
+        const std::size_t v2 {my_graph.add_vertex(2).get_ok()};
+        my_graph.add_edge(v1, v2, cgrapht::DefaultEdge{12});
+        my_graph.add_edge(v2, v1, cgrapht::DefaultEdge{21});
+
+        THEN("Creating the order should fail") {
+
+            auto created = cgrapht::DynamicTopologicalOrder<int, cgrapht::DefaultEdge>::create(my_graph);
+            REQUIRE(created.get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+        }
+    }
+
+    GIVEN("I insert random edges into an empty graph") {
+
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> my_graph;
+        auto dag {cgrapht::DynamicTopologicalOrder<int, cgrapht::DefaultEdge>::create(my_graph).consume_ok()};
+        std::vector<std::size_t> ids {};
+        for (int i {-20}; i < 40; ++i) {
+            ids.push_back(dag.add_vertex(i).get_ok());
+        }
+
+        std::mt19937 rng {3};
+        std::uniform_int_distribution<std::size_t> pick {0, ids.size() - 1};
+        std::size_t rejected {0};
+        for (std::size_t e {0}; e < 400; ++e) {
+            const std::size_t edge_count {my_graph.get_edges().size()};
+            auto result = dag.add_edge(ids[pick(rng)], ids[pick(rng)], cgrapht::DefaultEdge{e});
+            if (!result.is_ok()) {
+                REQUIRE(result.get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+                REQUIRE(my_graph.get_edges().size() == edge_count);
+                ++rejected;
+            }
+            if (e % 50 == 0) {
+                dag.delete_edge(e / 2);
+            }
+        }
+
+        THEN("Every accepted edge should respect the final order and some inserts should have been rejected") {
+
+            REQUIRE(rejected > 0);
+            REQUIRE(is_topological(my_graph, dag.order()));
+            REQUIRE(cgrapht::DynamicTopologicalOrder<int, cgrapht::DefaultEdge>::create(my_graph).is_ok());
+        }
+    }
+}
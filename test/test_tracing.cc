@@ -0,0 +1,125 @@
+#define CATCH_CONFIG_MAIN
+
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/multi_source_bfs.hpp"
+#include "cgrapht/algorithms/reachability.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+#include "cgrapht/tracing.hpp"
+
+namespace {
+    cgrapht::FrozenGraph make_path(const int length) {
+        cgrapht::DirectedGraph<int, cgrapht::DefaultEdge> graph {};
+        for (int i {0}; i < length; ++i) {
+            graph.add_vertex(i);
+        }
+        for (int i {0}; i + 1 < length; ++i) {
+            graph.add_edge(static_cast<std::size_t>(i), static_cast<std::size_t>(i + 1), cgrapht::DefaultEdge{static_cast<std::size_t>(i)});
+        }
+        return cgrapht::FrozenGraph{graph};
+    }
+
+    bool balanced(const std::vector<cgrapht::ChromeTraceWriter::Event>& events) {
+        std::vector<std::string> open {};
+        for (const auto& event : events) {
+            if (event.phase == 'B') {
+                open.push_back(event.name);
+            } else if (event.phase == 'E') {
+                if (open.empty() || open.back() != event.name) {
+                    return false;
+                }
+                open.pop_back();
+            }
+        }
+        return open.empty();
+    }
+}
+
+SCENARIO("Tracing algorithm phases") {
+
+    GIVEN("I have a frozen path graph 0 -> 1 -> 2 -> 3") {
+
+        const cgrapht::FrozenGraph frozen {make_path(4)};
+        const std::vector<std::size_t> sources {0};
+
+        WHEN("I run a traced multi source BFS") {
+
+            cgrapht::ChromeTraceWriter trace {};
+            auto distances = cgrapht::multi_source_bfs(frozen, sources, 10, trace);
+            REQUIRE(distances.is_ok());
+            const auto events {trace.get_events()};
+
+            THEN("Every level should be a span with a frontier counter") {
+
+                REQUIRE(balanced(events));
+                std::vector<double> frontiers {};
+                std::size_t levels {0};
+                for (const auto& event : events) {
+                    levels += event.phase == 'B' && event.name == "multi_source_bfs.level";
+                    if (event.phase == 'C') {
+                        REQUIRE(event.name == "multi_source_bfs.frontier");
+                        frontiers.push_back(event.value);
+                    }
+                }
+                REQUIRE(levels == 4);
+                REQUIRE(frontiers == std::vector<double>{1, 1, 1, 0});
+            }
+
+            THEN("The JSON should contain the events") {
+
+                const std::string json {trace.to_json()};
+                REQUIRE(json.starts_with("{\"traceEvents\":["));
+                REQUIRE(json.find("{\"name\":\"multi_source_bfs.batch\",\"ph\":\"B\"") != std::string::npos);
+                REQUIRE(json.find("\"args\":{\"value\":1}") != std::string::npos);
+            }
+
+            THEN("The untraced result should be the same") {
+
+                auto untraced = cgrapht::multi_source_bfs(frozen, sources, 10);
+                REQUIRE(untraced.get_ok().row(0)[3] == distances.get_ok().row(0)[3]);
+            }
+        }
+
+        WHEN("I sample hardware counters while building a reachability index") {
+
+            cgrapht::ChromeTraceWriter trace {};
+            cgrapht::PerfCounterTracer<cgrapht::ChromeTraceWriter&> perf {trace};
+            auto index = cgrapht::ReachabilityIndex::build(frozen, {}, perf);
+            REQUIRE(index.is_ok());
+
+            THEN("Every phase should be sampled and forwarded") {
+
+                const auto& samples {perf.get_samples()};
+                REQUIRE(samples.size() == 2);
+                REQUIRE(samples[0].name == "reachability.levels");
+                REQUIRE(samples[1].name == "reachability.labeling");
+                if (!perf.available()) {
+                    REQUIRE(samples[1].cycles == 0);
+                }
+
+                const auto events {trace.get_events()};
+                REQUIRE(balanced(events));
+                std::size_t counters {0};
+                for (const auto& event : events) {
+                    counters += event.phase == 'C';
+                }
+                REQUIRE(counters == (perf.available() ? 4 : 0));
+            }
+        }
+    }
+
+    GIVEN("A name that needs escaping") {
+
+        cgrapht::ChromeTraceWriter trace {};
+        trace.counter("a\"b\\c\n", 2.5);
+
+        THEN("It should be escaped in the JSON") {
+
+            REQUIRE(trace.to_json().find("\"a\\\"b\\\\c\\u000a\"") != std::string::npos);
+        }
+    }
+}
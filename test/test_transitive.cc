@@ -0,0 +1,157 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/transitive.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace {
+    using Graph = cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>;
+
+    // Edges only go from earlier to later vertices of a random permutation, plus a few parallel edges.
+    Graph make_random_dag(const std::size_t vertices, const std::size_t edges, const unsigned seed) {
+        std::mt19937 rng {seed};
+        std::vector<int> order(vertices);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::shuffle(order, rng);
+        Graph graph {};
+        for (const int v : order) {
+            graph.add_vertex(v);
+        }
+        std::uniform_int_distribution<std::size_t> pick {0, vertices - 1};
+        std::size_t id {0};
+        while (id < edges) {
+            const std::size_t a {pick(rng)};
+            const std::size_t b {pick(rng)};
+            if (a == b) {
+                continue;
+            }
+            const auto from {static_cast<std::size_t>(order[std::min(a, b)])};
+            const auto to {static_cast<std::size_t>(order[std::max(a, b)])};
+            graph.add_edge(from, to, cgrapht::DefaultEdge{id++});
+            if (id % 50 == 0) {
+                graph.add_edge(from, to, cgrapht::DefaultEdge{id++});
+            }
+        }
+        return graph;
+    }
+
+    // Vertex ids reachable from `from` by at least one edge.
+    std::set<std::size_t> descendants(const Graph& graph, const std::size_t from) {
+        const cgrapht::FrozenGraph frozen {graph};
+        std::set<std::size_t> seen {};
+        std::vector<std::size_t> stack {frozen.index_of(from).get_ok()};
+        while (!stack.empty()) {
+            const std::size_t v {stack.back()};
+            stack.pop_back();
+            for (const std::size_t w : frozen.children(v)) {
+                if (seen.insert(frozen.vertex_id(w)).second) {
+                    stack.push_back(w);
+                }
+            }
+        }
+        return seen;
+    }
+
+    std::set<std::pair<std::size_t, std::size_t>> edge_set(const Graph& graph) {
+        std::set<std::pair<std::size_t, std::size_t>> edges {};
+        for (const auto& [_, edge] : graph.get_edge_entries()) {
+            edges.emplace(edge.from_id, edge.to_id);
+        }
+        return edges;
+    }
+}
+
+SCENARIO("Transitive closure matches graph search") {
+    GIVEN("A random DAG") {
+        const Graph graph {make_random_dag(300, 900, 1)};
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto closure {cgrapht::TransitiveClosure::build(frozen, {.threads = 4}).consume_ok()};
+
+        THEN("Every row holds exactly the descendants of its vertex") {
+            std::size_t pairs {0};
+            for (std::size_t v {0}; v < 300; ++v) {
+                const auto expected {descendants(graph, frozen.vertex_id(v))};
+                pairs += expected.size();
+                REQUIRE(closure.descendant_count(v) == expected.size());
+                for (std::size_t w {0}; w < 300; ++w) {
+                    REQUIRE(closure.reachable(frozen.vertex_id(v), frozen.vertex_id(w)).get_ok() == expected.contains(frozen.vertex_id(w)));
+                }
+            }
+            REQUIRE(closure.pair_count() == pairs);
+            REQUIRE(closure.reachable(0, 300).get_error() == cgrapht::ErrorType::ABSENT_VERTEX);
+        }
+    }
+
+    GIVEN("A graph with a cycle") {
+        Graph graph {make_random_dag(10, 20, 2)};
+        graph.add_edge(graph.get_edge_entries().begin()->second.to_id, graph.get_edge_entries().begin()->second.from_id, cgrapht::DefaultEdge{100});
+        const cgrapht::FrozenGraph frozen {graph};
+
+        THEN("It is rejected") {
+            REQUIRE(cgrapht::TransitiveClosure::build(frozen).get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+            REQUIRE(cgrapht::transitive_reduction(graph, frozen).get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+        }
+    }
+}
+
+SCENARIO("Transitive reduction keeps reachability with the fewest edges") {
+    GIVEN("A diamond with a shortcut and a duplicated edge") {
+        Graph graph {};
+        for (int v {0}; v < 4; ++v) {
+            graph.add_vertex(v);
+        }
+        const std::vector<std::pair<int, int>> edges {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {0, 3}, {1, 3}};
+        for (std::size_t e {0}; e < edges.size(); ++e) {
+            graph.add_edge(edges[e].first, edges[e].second, cgrapht::DefaultEdge{e});
+        }
+        const cgrapht::FrozenGraph frozen {graph};
+        const Graph reduction {cgrapht::transitive_reduction(graph, frozen).consume_ok()};
+
+        THEN("The shortcut and the duplicate are dropped") {
+            REQUIRE(reduction.get_vertex_ids().size() == 4);
+            REQUIRE(edge_set(reduction) == std::set<std::pair<std::size_t, std::size_t>>{{0, 1}, {0, 2}, {1, 3}, {2, 3}});
+            REQUIRE(reduction.get_edge_entries().size() == 4);
+            REQUIRE(reduction.get_edge(2).get_ok().edge == cgrapht::DefaultEdge{2});
+        }
+    }
+
+    GIVEN("Random DAGs") {
+        THEN("Reachability is unchanged, no kept edge is implied by the others, and chunking does not matter") {
+            for (const unsigned seed : {3u, 4u, 5u}) {
+                const Graph graph {make_random_dag(300, 1200, seed)};
+                const cgrapht::FrozenGraph frozen {graph};
+                const Graph reduction {cgrapht::transitive_reduction(graph, frozen, {.threads = 4}).consume_ok()};
+                const auto kept {edge_set(reduction)};
+                REQUIRE(kept.size() == reduction.get_edge_entries().size());
+                REQUIRE(kept.size() < edge_set(graph).size());
+
+                for (const std::size_t v : graph.get_vertex_ids()) {
+                    REQUIRE(descendants(reduction, v) == descendants(graph, v));
+                }
+                for (const auto& [from, to] : kept) {
+                    // Without the edge, `to` must no longer be reachable from `from`.
+                    Graph without {reduction};
+                    for (const auto& [edge_id, edge] : reduction.get_edge_entries()) {
+                        if (edge.from_id == from && edge.to_id == to) {
+                            without.delete_edge(edge_id);
+                        }
+                    }
+                    REQUIRE_FALSE(descendants(without, from).contains(to));
+                }
+
+                // One word per vertex: five sweeps of 64 columns.
+                const Graph chunked {cgrapht::transitive_reduction(graph, frozen, {.max_bytes = 8 * 300, .threads = 4}).consume_ok()};
+                REQUIRE(edge_set(chunked) == kept);
+            }
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+
+#include "cgrapht/algorithms/tree_queries.hpp"
+#include "cgrapht/default_edge.hpp"
+#include "cgrapht/frozen_graph.hpp"
+#include "cgrapht/graph.hpp"
+
+namespace {
+    using Graph = cgrapht::DirectedGraph<int, cgrapht::DefaultEdge>;
+
+    // A random org chart: employee v reports to a random earlier employee; ids are shuffled.
+    std::pair<Graph, std::vector<std::size_t>> make_random_tree(const std::size_t vertices, const unsigned seed) {
+        std::mt19937 rng {seed};
+        std::vector<int> ids(vertices);
+        std::iota(ids.begin(), ids.end(), 0);
+        std::ranges::shuffle(ids, rng);
+        Graph graph {};
+        for (const int id : ids) {
+            graph.add_vertex(id);
+        }
+        std::vector<std::size_t> boss(vertices, 0);
+        for (std::size_t v {1}; v < vertices; ++v) {
+            boss[static_cast<std::size_t>(ids[v])] = static_cast<std::size_t>(ids[std::uniform_int_distribution<std::size_t>{0, v - 1}(rng)]);
+            graph.add_edge(boss[static_cast<std::size_t>(ids[v])], static_cast<std::size_t>(ids[v]), cgrapht::DefaultEdge{v});
+        }
+        boss[static_cast<std::size_t>(ids[0])] = static_cast<std::size_t>(ids[0]);
+        return {std::move(graph), std::move(boss)};
+    }
+
+    std::vector<std::size_t> chain(const std::vector<std::size_t>& boss, std::size_t v) {
+        std::vector<std::size_t> up {v};
+        while (boss[v] != v) {
+            v = boss[v];
+            up.push_back(v);
+        }
+        return up;
+    }
+
+    std::size_t brute_force_lca(const std::vector<std::size_t>& boss, const std::size_t u, const std::size_t v) {
+        const std::vector<std::size_t> above_u {chain(boss, u)};
+        for (const std::size_t x : chain(boss, v)) {
+            if (std::ranges::find(above_u, x) != above_u.end()) {
+                return x;
+            }
+        }
+        return boss.size();
+    }
+}
+
+SCENARIO("Tree index answers ancestor queries") {
+    GIVEN("A random rooted tree") {
+        const auto [graph, boss] = make_random_tree(600, 1);
+        const cgrapht::FrozenGraph frozen {graph};
+        const auto index {cgrapht::TreeIndex::build(frozen, {.threads = 4}).consume_ok()};
+
+        THEN("Lowest common ancestors match walking up the tree") {
+            REQUIRE(boss[index.root_id()] == index.root_id());
+            for (std::size_t u {0}; u < 600; u += 7) {
+                for (std::size_t v {0}; v < 600; v += 3) {
+                    REQUIRE(index.lowest_common_ancestor(u, v).get_ok() == brute_force_lca(boss, u, v));
+                }
+            }
+        }
+
+        THEN("K-th ancestors and depths match walking up the tree") {
+            for (std::size_t v {0}; v < 600; ++v) {
+                const std::vector<std::size_t> up {chain(boss, v)};
+                REQUIRE(index.depth(v).get_ok() == up.size() - 1);
+                for (std::size_t k {0}; k < up.size(); ++k) {
+                    REQUIRE(index.kth_ancestor(v, k).get_ok() == up[k]);
+                }
+                REQUIRE(index.kth_ancestor(v, up.size()).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            }
+        }
+
+        THEN("Batches over dense indices agree with single queries") {
+            std::vector<std::pair<std::size_t, std::size_t>> pairs {};
+            std::vector<std::pair<std::size_t, std::size_t>> climbs {};
+            for (std::size_t i {0}; i < 600; ++i) {
+                pairs.emplace_back(i, (i * 37) % 600);
+                climbs.emplace_back(i, index.depth(frozen.vertex_id(i)).get_ok() / 2);
+            }
+            const auto ancestors {index.lowest_common_ancestors(pairs, 4).consume_ok()};
+            const auto climbed {index.kth_ancestors(climbs, 4).consume_ok()};
+            for (std::size_t i {0}; i < 600; ++i) {
+                REQUIRE(frozen.vertex_id(ancestors[i]) == index.lowest_common_ancestor(frozen.vertex_id(pairs[i].first), frozen.vertex_id(pairs[i].second)).get_ok());
+                REQUIRE(frozen.vertex_id(climbed[i]) == index.kth_ancestor(frozen.vertex_id(i), climbs[i].second).get_ok());
+            }
+            const std::vector<std::pair<std::size_t, std::size_t>> out_of_range {{0, 600}};
+            REQUIRE(index.lowest_common_ancestors(out_of_range).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+        }
+    }
+
+    GIVEN("Graphs that are not rooted trees") {
+        auto make = [](const std::vector<std::pair<int, int>>& edges) {
+            Graph graph {};
+            for (int v {0}; v < 4; ++v) {
+                graph.add_vertex(v);
+            }
+            for (std::size_t e {0}; e < edges.size(); ++e) {
+                graph.add_edge(edges[e].first, edges[e].second, cgrapht::DefaultEdge{e});
+            }
+            return graph;
+        };
+        const Graph two_roots {make({{0, 1}, {2, 3}})};
+        const Graph two_parents {make({{0, 1}, {0, 2}, {1, 3}, {2, 3}})};
+        const Graph detached_cycle {make({{0, 1}, {2, 3}, {3, 2}})};
+        const cgrapht::FrozenGraph frozen_two_roots {two_roots};
+        const cgrapht::FrozenGraph frozen_two_parents {two_parents};
+        const cgrapht::FrozenGraph frozen_detached_cycle {detached_cycle};
+
+        THEN("They are rejected") {
+            REQUIRE(cgrapht::TreeIndex::build(frozen_two_roots).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::TreeIndex::build(frozen_two_parents).get_error() == cgrapht::ErrorType::INVALID_ARGUMENT);
+            REQUIRE(cgrapht::TreeIndex::build(frozen_detached_cycle).get_error() == cgrapht::ErrorType::CYCLE_DETECTED);
+        }
+    }
+}